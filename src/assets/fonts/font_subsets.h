@@ -0,0 +1,24 @@
+#pragma once
+
+// Generated by tools/fonts/build_fonts.py from tools/fonts/fonts.json, do not edit.
+// Included by lv_conf.h, so macros only.
+
+// No subset replaces a built-in size yet, so the pipeline saves no flash:
+//   lv_font_montserrat_72    stale, lacks '+-'
+//   lv_font_montserrat_64    stale, lacks '+-'
+//   lv_font_numeric_48       not generated, built-in montserrat_48 used
+//   lv_font_numeric_36       not generated, built-in montserrat_36 used
+
+#define FONT_SUBSET_DIGITS_72        1   // life_label (one player, two player)
+#define FONT_SUBSET_DIGITS_64        1   // spare life size
+#define FONT_SUBSET_DIGITS_48        0   // life_label (small), menu close button
+#define FONT_SUBSET_DIGITS_36        0   // lbl_amp_label, brightness value
+
+#define FONT_SUBSETS_COMPRESSED      0
+#define FONT_SUBSETS_DECLARE         LV_FONT_DECLARE(lv_font_montserrat_72) LV_FONT_DECLARE(lv_font_montserrat_64)
+
+// Fonts for the UI: the subset when generated, the built-in size otherwise
+#define FONT_DIGITS_72               (&lv_font_montserrat_72)
+#define FONT_DIGITS_64               (&lv_font_montserrat_64)
+#define FONT_DIGITS_48               (&lv_font_montserrat_48)
+#define FONT_DIGITS_36               (&lv_font_montserrat_36)
@@ -0,0 +1,48 @@
+#include "boot_profiler.h"
+#include "esp_timer.h"
+
+struct BootMark {
+  const char *name;
+  uint32_t time_us;
+  uint8_t core;
+};
+
+static BootMark marks[BOOT_PROFILER_MAX_MARKS];
+static uint8_t mark_count = 0;
+static uint32_t interactive_us = 0;
+static portMUX_TYPE marks_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void boot_mark(const char *name) {
+  uint32_t now = (uint32_t)esp_timer_get_time();
+  taskENTER_CRITICAL(&marks_lock);
+  if (mark_count < BOOT_PROFILER_MAX_MARKS) {
+    marks[mark_count++] = { name, now, (uint8_t)xPortGetCoreID() };
+  }
+  taskEXIT_CRITICAL(&marks_lock);
+}
+
+void boot_mark_interactive(void) {
+  if (interactive_us != 0) return;
+  boot_mark("interactive");
+  interactive_us = (uint32_t)esp_timer_get_time();
+  boot_report();
+}
+
+void boot_report(void) {
+  printf("[Boot] ---- Boot report ----\n");
+  printf("[Boot] %-22s %4s %9s %9s\n", "phase", "core", "at (ms)", "took (ms)");
+
+  // Durations are per core: a phase ends where the previous one on the same core ended
+  uint32_t last_on_core[2] = { 0, 0 };
+  for (uint8_t i = 0; i < mark_count; i++) {
+    const BootMark &m = marks[i];
+    uint8_t core = m.core < 2 ? m.core : 0;
+    uint32_t took = m.time_us - last_on_core[core];
+    last_on_core[core] = m.time_us;
+    printf("[Boot] %-22s %4u %9.1f %9.1f\n", m.name, m.core, m.time_us / 1000.0f, took / 1000.0f);
+  }
+  if (interactive_us) {
+    printf("[Boot] Time to interactive: %.1f ms\n", interactive_us / 1000.0f);
+  }
+  printf("[Boot] ---------------------\n");
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Arduino.h>
+
+/// Maximum number of boot phases that can be recorded
+#define BOOT_PROFILER_MAX_MARKS  32
+
+/**
+ * @brief Record the end of a boot phase
+ *
+ * Stores the name pointer, a microsecond timestamp and the core into a fixed
+ * buffer. Safe to call from any task; marks after the buffer is full are dropped.
+ *
+ * @param name Phase name, must be a string literal (only the pointer is kept)
+ */
+void boot_mark(const char *name);
+
+/**
+ * @brief Record that the UI accepts input and print the boot report
+ *
+ * Only the first call counts, later calls (e.g. from re-created screens) are ignored.
+ */
+void boot_mark_interactive(void);
+
+/**
+ * @brief Print all recorded phases with their durations and the time-to-interactive
+ */
+void boot_report(void);
@@ -0,0 +1,39 @@
+#include "bringup.h"
+#include "boot_profiler.h"
+
+static const BringupStep *bringup_steps = nullptr;
+static size_t bringup_count = 0;
+static SemaphoreHandle_t bringup_done = nullptr;
+
+static void bringup_task(void *arg) {
+  for (size_t i = 0; i < bringup_count; i++) {
+    bringup_steps[i].fn();
+    boot_mark(bringup_steps[i].name);
+  }
+  xSemaphoreGive(bringup_done);
+  vTaskDelete(NULL);
+}
+
+void bringup_start(const BringupStep *steps, size_t count) {
+  bringup_steps = steps;
+  bringup_count = count;
+  bringup_done = xSemaphoreCreateBinary();
+
+  if (xTaskCreatePinnedToCore(bringup_task, "bringup", BRINGUP_STACK_SIZE, nullptr,
+                              BRINGUP_PRIORITY, nullptr, BRINGUP_CORE) != pdPASS) {
+    // Fall back to running the steps inline
+    printf("[Bringup] Task creation failed, running steps serially\n");
+    for (size_t i = 0; i < count; i++) {
+      steps[i].fn();
+      boot_mark(steps[i].name);
+    }
+    xSemaphoreGive(bringup_done);
+  }
+}
+
+void bringup_wait(void) {
+  if (!bringup_done) return;
+  xSemaphoreTake(bringup_done, portMAX_DELAY);
+  vSemaphoreDelete(bringup_done);
+  bringup_done = nullptr;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Arduino.h>
+
+/// Core the bring-up worker runs on (Arduino loop and LVGL stay on the other one)
+#define BRINGUP_CORE        0
+#define BRINGUP_STACK_SIZE  6144
+#define BRINGUP_PRIORITY    2
+
+typedef void (*bringup_fn_t)(void);
+
+/**
+ * @brief One independent init step
+ *
+ * Steps run in order on the worker and must not touch LVGL. Shared hardware
+ * (I2C, the GPIO expander) has to be protected by its driver.
+ */
+struct BringupStep {
+  const char *name;   ///< Boot profiler phase name (string literal)
+  bringup_fn_t fn;
+};
+
+/**
+ * @brief Run init steps on the second core while setup() continues
+ * @param steps Step table, must stay valid until bringup_wait() returns
+ * @param count Number of steps
+ */
+void bringup_start(const BringupStep *steps, size_t count);
+
+/**
+ * @brief Block until all steps of bringup_start() have finished
+ */
+void bringup_wait(void);
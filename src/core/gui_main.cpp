@@ -29,6 +29,7 @@
 // ============================================
 #include "ui/helpers/animation_helpers.h"
 #include "ui/helpers/gestures.h"
+#include "ui/helpers/screen_cache.h"
 
 // ============================================
 // Data Layer
@@ -41,11 +42,15 @@
 #include "assets/images/logo.h"
 
 
-void ui_init(void)
+/// millis() when the boot logo was put on screen, 0 if it is not showing
+static uint32_t logo_shown_at = 0;
+
+void ui_show_logo(void)
 {
   teardown_life_counter_2P();
   teardown_life_counter();
   teardownAllMenus();
+  screen_cache_clear();  // retained menus belong to the screen being replaced
 
   printf("[lv_create_main_gui] Loading screen\n");
   lv_scr_load(lv_obj_create(NULL));
@@ -69,10 +74,23 @@ void ui_init(void)
   
   // Force LVGL to render the logo immediately
   lv_refr_now(NULL);
-  printf("[GUI] Forced logo render at %lu ms\n", millis());
+  logo_shown_at = millis();
+  printf("[GUI] Forced logo render at %lu ms\n", logo_shown_at);
+}
+
+void ui_init(void)
+{
+  if (logo_shown_at == 0) {
+    ui_show_logo();
+  }
   
-  // Delay to let logo render before starting life counter
-  delay(1500); // 1.5 seconds to show logo
+  // Keep the logo up for UI_LOGO_DURATION_MS in total; work done since
+  // ui_show_logo() (boot bring-up) counts towards it
+  uint32_t shown_for = millis() - logo_shown_at;
+  if (shown_for < UI_LOGO_DURATION_MS) {
+    delay(UI_LOGO_DURATION_MS - shown_for);
+  }
+  logo_shown_at = 0;
   printf("[GUI] Starting life counter after delay at %lu ms\n", millis());
   
   PlayerMode player_mode = (PlayerMode)player_store.getInt(KEY_PLAYER_MODE, PLAYER_MODE_ONE_PLAYER);
@@ -85,4 +103,7 @@ void ui_init(void)
     init_life_counter_2P();
   }
   printf("[GUI] Life counter started at %lu ms\n", millis());
+
+  // Menus kept between navigations, the contextual menu is built while idle
+  initMenuScreens();
 }
\ No newline at end of file
@@ -3,10 +3,22 @@
 
 #include <lvgl.h>
 
+/// How long the logo stays on screen before the life counter starts
+#define UI_LOGO_DURATION_MS 1500
+
+/**
+ * @brief Show the logo on a fresh screen
+ * 
+ * Can be called early during boot so the remaining init work overlaps
+ * with the logo time. ui_init() then only waits for what is left of it.
+ */
+void ui_show_logo(void);
+
 /**
  * @brief Initialize the complete user interface
  * 
  * Sets up all LVGL screens, styles, and UI components.
+ * Shows the logo first unless ui_show_logo() already did.
  * Must be called after LVGL initialization.
  */
 void ui_init(void);
@@ -0,0 +1,138 @@
+#include "latency_trace.h"
+
+#if LATENCY_TRACE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_timer.h"
+
+static const char *stage_names[LTRACE_STAGE_COUNT] = {
+    "indev read", "gesture", "life queued", "label set", "flush"
+};
+
+// Upper bucket edges in us, the last bucket takes everything above
+static const uint32_t edges_us[LTRACE_BUCKETS - 1] = { 1000, 2000, 4000, 8000, 16000, 33000, 50000, 66000, 100000 };
+
+typedef struct {
+    uint32_t counts[LTRACE_BUCKETS];
+    uint32_t samples;
+    uint32_t max;
+    uint32_t window[LTRACE_WINDOW];   // ring of the most recent samples
+} ltrace_hist_t;
+
+typedef struct {
+    uint32_t seq;
+    int64_t isr_us;
+    uint32_t done;                    // bit per recorded stage
+    lv_area_t label;
+    bool wait_flush;
+} ltrace_seq_t;
+
+// All of this is only touched from the UI task (indev read, event handlers, flush)
+static ltrace_hist_t hists[LTRACE_STAGE_COUNT];
+static ltrace_seq_t in_flight[LTRACE_IN_FLIGHT];
+static ltrace_seq_t *active = NULL;     // sequence of the sample LVGL is processing
+
+static void hist_add(ltrace_hist_t *hist, uint32_t value) {
+    uint32_t bucket = 0;
+    while (bucket < LTRACE_BUCKETS - 1 && value > edges_us[bucket]) bucket++;
+    hist->counts[bucket]++;
+    hist->window[hist->samples % LTRACE_WINDOW] = value;
+    hist->samples++;
+    if (value > hist->max) hist->max = value;
+}
+
+static bool record(ltrace_seq_t *trace, ltrace_stage_t stage) {
+    uint32_t bit = 1u << stage;
+    if (trace->done & bit) return false;
+    trace->done |= bit;
+    hist_add(&hists[stage], (uint32_t)(esp_timer_get_time() - trace->isr_us));
+    return true;
+}
+
+void LatencyTrace_Begin(uint32_t seq, int64_t isr_us) {
+    // Hold polls have no interrupt to measure from
+    if (isr_us == 0) {
+        active = NULL;
+        return;
+    }
+    // Samples of one interrupt come once, a reused slot drops an older unflushed sequence
+    ltrace_seq_t *trace = &in_flight[seq % LTRACE_IN_FLIGHT];
+    if (trace->isr_us == isr_us && trace->seq == seq) {
+        active = trace;
+        return;
+    }
+    memset(trace, 0, sizeof(*trace));
+    trace->seq = seq;
+    trace->isr_us = isr_us;
+    active = trace;
+    record(trace, LTRACE_INDEV_READ);
+}
+
+void LatencyTrace_End(void) {
+    active = NULL;
+}
+
+void LatencyTrace_Mark(ltrace_stage_t stage) {
+    if (active && stage < LTRACE_STAGE_COUNT) record(active, stage);
+}
+
+void LatencyTrace_MarkLabel(const lv_area_t *area) {
+    if (!active || !record(active, LTRACE_LABEL_SET)) return;
+    active->label = *area;
+    active->wait_flush = true;
+}
+
+void LatencyTrace_Flush(const lv_area_t *area) {
+    for (int i = 0; i < LTRACE_IN_FLIGHT; i++) {
+        ltrace_seq_t *trace = &in_flight[i];
+        if (!trace->wait_flush) continue;
+        if (area->x1 > trace->label.x2 || area->x2 < trace->label.x1 ||
+            area->y1 > trace->label.y2 || area->y2 < trace->label.y1) continue;
+        record(trace, LTRACE_FLUSH);
+        trace->wait_flush = false;
+    }
+}
+
+static int cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+void LatencyTrace_Print(void) {
+    static uint32_t sorted[LTRACE_WINDOW];
+
+    printf("[Latency] Touch interrupt to stage, percentiles over the last %d samples\n", LTRACE_WINDOW);
+    printf("[Latency] %-12s %7s %7s %7s %7s %7s  (us)\n", "stage", "count", "p50", "p95", "p99", "max");
+    for (int s = 0; s < LTRACE_STAGE_COUNT; s++) {
+        const ltrace_hist_t *hist = &hists[s];
+        uint32_t n = hist->samples < LTRACE_WINDOW ? hist->samples : LTRACE_WINDOW;
+        if (n == 0) {
+            printf("[Latency] %-12s %7d\n", stage_names[s], 0);
+            continue;
+        }
+        memcpy(sorted, hist->window, n * sizeof(uint32_t));
+        qsort(sorted, n, sizeof(uint32_t), cmp_u32);
+        printf("[Latency] %-12s %7lu %7lu %7lu %7lu %7lu\n", stage_names[s], (unsigned long)hist->samples,
+               (unsigned long)sorted[(n - 1) * 50 / 100], (unsigned long)sorted[(n - 1) * 95 / 100],
+               (unsigned long)sorted[(n - 1) * 99 / 100], (unsigned long)hist->max);
+    }
+
+    printf("[Latency] Histogram (ms):%6s", "<=1");
+    for (int b = 1; b < LTRACE_BUCKETS - 1; b++) printf(" %5lu", (unsigned long)(edges_us[b] / 1000));
+    printf(" %5s\n", ">");
+    for (int s = 0; s < LTRACE_STAGE_COUNT; s++) {
+        printf("[Latency] %-15s", stage_names[s]);
+        for (int b = 0; b < LTRACE_BUCKETS; b++) printf(" %5lu", (unsigned long)hists[s].counts[b]);
+        printf("\n");
+    }
+}
+
+void LatencyTrace_Reset(void) {
+    memset(hists, 0, sizeof(hists));
+    memset(in_flight, 0, sizeof(in_flight));
+    active = NULL;
+}
+
+#endif
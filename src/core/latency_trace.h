@@ -0,0 +1,82 @@
+#pragma once
+
+// ============================================
+// Input-to-photon latency tracing
+// ============================================
+// Every touch interrupt starts a sequence. The sample read for it carries the
+// sequence ID through the indev read, the gesture handler and the life change
+// to the life label update; the first flush that contains the label area
+// ends it. Each stage is recorded relative to the interrupt in a fixed-bucket
+// histogram and a window of recent samples for p50/p95/p99. Dump with the
+// serial "latency" command. Build with -DLATENCY_TRACE=0 to compile it out:
+// the LTRACE_* hooks then expand to nothing.
+
+#include <lvgl.h>
+#include <stdint.h>
+
+#ifndef LATENCY_TRACE
+#define LATENCY_TRACE 1
+#endif
+
+/// Recent samples per stage for the percentiles
+#define LTRACE_WINDOW     128
+#define LTRACE_BUCKETS    10
+/// Sequences waiting for their flush at the same time (fast taps)
+#define LTRACE_IN_FLIGHT  4
+
+typedef enum {
+    LTRACE_INDEV_READ = 0,  // Lvgl_Touchpad_Read got the sample
+    LTRACE_GESTURE,         // gesture event handler
+    LTRACE_LIFE_QUEUED,     // queue_life_change / queue_life_change_2p
+    LTRACE_LABEL_SET,       // first life label update
+    LTRACE_FLUSH,           // first Lvgl_Display_Flush containing the label
+    LTRACE_STAGE_COUNT
+} ltrace_stage_t;
+
+#if LATENCY_TRACE
+
+/**
+ * @brief Start tracing a sample, called by the indev read on the UI task
+ * @param seq Sequence ID assigned by the touch interrupt
+ * @param isr_us Interrupt time, 0 for a sample without one (hold poll)
+ */
+void LatencyTrace_Begin(uint32_t seq, int64_t isr_us);
+
+/**
+ * @brief LVGL is done with the sample, later updates are not attributed to it
+ */
+void LatencyTrace_End(void);
+
+/**
+ * @brief Record a stage of the sample being processed, first call per stage counts
+ */
+void LatencyTrace_Mark(ltrace_stage_t stage);
+
+/**
+ * @brief Record the life label update and the area to wait for in the flush
+ */
+void LatencyTrace_MarkLabel(const lv_area_t *area);
+
+/**
+ * @brief Called for every flush, ends the sequences whose label is in area
+ */
+void LatencyTrace_Flush(const lv_area_t *area);
+
+void LatencyTrace_Print(void);
+void LatencyTrace_Reset(void);
+
+#define LTRACE_BEGIN(seq, isr_us)   LatencyTrace_Begin(seq, isr_us)
+#define LTRACE_END()                LatencyTrace_End()
+#define LTRACE_MARK(stage)          LatencyTrace_Mark(stage)
+#define LTRACE_LABEL(area)          LatencyTrace_MarkLabel(area)
+#define LTRACE_FLUSH(area)          LatencyTrace_Flush(area)
+
+#else
+
+#define LTRACE_BEGIN(seq, isr_us)   ((void)0)
+#define LTRACE_END()                ((void)0)
+#define LTRACE_MARK(stage)          ((void)0)
+#define LTRACE_LABEL(area)          ((void)0)
+#define LTRACE_FLUSH(area)          ((void)0)
+
+#endif
@@ -0,0 +1,161 @@
+#include "persistence.h"
+#include <string.h>
+
+#include "core/state_manager.h"
+
+struct PersistUpdate {
+  char key[STATE_CACHE_KEY_LEN + 1];
+};
+
+struct PersistStats {
+  uint32_t updates;        // puts queued by the store
+  uint32_t coalesced;      // updates to a key already pending in the same batch
+  uint32_t overflows;      // queue full, the value stays dirty and the next idle check writes it
+  uint32_t idle_batches;   // batches started by the idle check, not by a queued update
+  uint32_t batches;
+  uint32_t values_written;
+  uint32_t last_batch_us;
+  uint32_t max_batch_us;
+};
+
+static QueueHandle_t persist_queue = nullptr;
+static TaskHandle_t persist_task_handle = nullptr;
+static SemaphoreHandle_t batch_mutex = nullptr;   // worker batches vs. persistence_flush()
+static persist_flush_hook_t flush_hooks[PERSIST_MAX_FLUSH_HOOKS];
+static size_t flush_hook_count = 0;
+static PersistStats persist_stats = {};
+// Set when an update could not be queued; the worker's idle check then runs a batch
+static volatile bool persist_overflow = false;
+
+// Called by player_store on the task doing the put, must not block
+static void persist_notify(const char *key) {
+  PersistUpdate update;
+  strncpy(update.key, key, sizeof(update.key) - 1);
+  update.key[sizeof(update.key) - 1] = '\0';
+  persist_stats.updates++;
+  if (xQueueSend(persist_queue, &update, 0) != pdTRUE) {
+    persist_stats.overflows++;
+    persist_overflow = true;
+  }
+}
+
+static size_t persist_run_hooks_and_flush(void) {
+  if (batch_mutex) xSemaphoreTake(batch_mutex, portMAX_DELAY);
+  size_t written = player_store.flush();
+  for (size_t i = 0; i < flush_hook_count; i++) {
+    flush_hooks[i]();
+  }
+  if (batch_mutex) xSemaphoreGive(batch_mutex);
+  return written;
+}
+
+static void persist_write_batch(void) {
+  uint32_t start_us = micros();
+  size_t written = persist_run_hooks_and_flush();
+  uint32_t batch_us = micros() - start_us;
+
+  persist_stats.batches++;
+  persist_stats.values_written += written;
+  persist_stats.last_batch_us = batch_us;
+  if (batch_us > persist_stats.max_batch_us) persist_stats.max_batch_us = batch_us;
+}
+
+static void persist_task(void *arg) {
+  PersistUpdate pending[PERSIST_QUEUE_LENGTH];
+  PersistUpdate update;
+
+  for (;;) {
+    // Sleep until the first update, then collect everything in the window. Every
+    // PERSIST_COALESCE_MS without one, write whatever is still dirty: values whose
+    // update did not fit the queue, or whose write failed in the last batch.
+    if (xQueueReceive(persist_queue, &update, pdMS_TO_TICKS(PERSIST_COALESCE_MS)) != pdTRUE) {
+      bool overflow = persist_overflow;
+      persist_overflow = false;
+      if (overflow || player_store.dirtyCount() > 0) {
+        persist_stats.idle_batches++;
+        persist_write_batch();
+      }
+      continue;
+    }
+    size_t pending_count = 0;
+    pending[pending_count++] = update;
+
+    TickType_t window_end = xTaskGetTickCount() + pdMS_TO_TICKS(PERSIST_COALESCE_MS);
+    for (;;) {
+      TickType_t now = xTaskGetTickCount();
+      if ((int32_t)(window_end - now) <= 0) break;
+      if (xQueueReceive(persist_queue, &update, window_end - now) != pdTRUE) break;
+
+      bool seen = false;
+      for (size_t i = 0; i < pending_count; i++) {
+        if (strcmp(pending[i].key, update.key) == 0) {
+          seen = true;
+          break;
+        }
+      }
+      if (seen) {
+        persist_stats.coalesced++;
+      } else if (pending_count < PERSIST_QUEUE_LENGTH) {
+        pending[pending_count++] = update;
+      }
+    }
+
+    // Anything that overflowed until now is written by this batch
+    persist_overflow = false;
+    persist_write_batch();
+  }
+}
+
+void persistence_start(void) {
+  if (persist_task_handle) return;
+
+  persist_queue = xQueueCreate(PERSIST_QUEUE_LENGTH, sizeof(PersistUpdate));
+  batch_mutex = xSemaphoreCreateMutex();
+  if (xTaskCreatePinnedToCore(persist_task, "persist", PERSIST_TASK_STACK_SIZE, nullptr,
+                              PERSIST_TASK_PRIORITY, &persist_task_handle, PERSIST_TASK_CORE) != pdPASS) {
+    // Keep writing through, slow but nothing gets lost
+    printf("[Persist] Failed to create persistence task, staying write-through\n");
+    vQueueDelete(persist_queue);
+    persist_queue = nullptr;
+    persist_task_handle = nullptr;
+    return;
+  }
+
+  player_store.setWriteHook(persist_notify);
+  player_store.setWriteBack(true);
+  printf("[Persist] Write-behind worker running on core %d (%d ms window)\n",
+         PERSIST_TASK_CORE, PERSIST_COALESCE_MS);
+}
+
+void persistence_kick(void) {
+  if (!persist_queue) return;
+  PersistUpdate update = {};
+  if (xQueueSend(persist_queue, &update, 0) != pdTRUE) {
+    persist_stats.overflows++;
+    persist_overflow = true;
+  }
+}
+
+void persistence_flush(void) {
+  uint32_t start_us = micros();
+  size_t written = persist_run_hooks_and_flush();
+  printf("[Persist] Flushed %u values in %lu us\n", (unsigned)written,
+         (unsigned long)(micros() - start_us));
+}
+
+bool persistence_register_flush_hook(persist_flush_hook_t hook) {
+  if (!hook || flush_hook_count >= PERSIST_MAX_FLUSH_HOOKS) return false;
+  flush_hooks[flush_hook_count++] = hook;
+  return true;
+}
+
+void persistence_print_stats(void) {
+  printf("[Persist] %s, %u dirty, updates=%lu coalesced=%lu overflows=%lu idle batches=%lu\n",
+         persist_task_handle ? "write-behind" : "write-through",
+         (unsigned)player_store.dirtyCount(),
+         (unsigned long)persist_stats.updates, (unsigned long)persist_stats.coalesced,
+         (unsigned long)persist_stats.overflows, (unsigned long)persist_stats.idle_batches);
+  printf("[Persist] batches=%lu values=%lu last=%lu us max=%lu us\n",
+         (unsigned long)persist_stats.batches, (unsigned long)persist_stats.values_written,
+         (unsigned long)persist_stats.last_batch_us, (unsigned long)persist_stats.max_batch_us);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Arduino.h>
+
+/// Flash writes run on the core without LVGL, below the UI and audio tasks
+#define PERSIST_TASK_CORE         1
+#define PERSIST_TASK_STACK_SIZE   4096
+#define PERSIST_TASK_PRIORITY     1
+#define PERSIST_QUEUE_LENGTH      32
+/// Updates arriving within this window after the first one go into one batch
+#define PERSIST_COALESCE_MS       1000
+#define PERSIST_MAX_FLUSH_HOOKS   4
+
+/**
+ * @brief Extra work done with every batch (e.g. other stores writing to flash)
+ */
+typedef void (*persist_flush_hook_t)(void);
+
+/**
+ * @brief Start the write-behind persistence worker
+ *
+ * Switches player_store to write-back: puts only update its RAM cache and
+ * queue the key, the worker coalesces updates for PERSIST_COALESCE_MS and
+ * writes them to NVS in one batch. An update that does not fit the queue is
+ * not lost: it stays dirty and the worker's idle check, every
+ * PERSIST_COALESCE_MS, writes it. Call once NVS users of setup() are done.
+ */
+void persistence_start(void);
+
+/**
+ * @brief Write everything pending to flash now, blocking
+ *
+ * Only for shutdown paths (deep sleep, restart), never from the UI task.
+ */
+void persistence_flush(void);
+
+/**
+ * @brief Ask for a batch without a StateStore put (e.g. a hook has new data)
+ *
+ * Never blocks, callable from any task.
+ */
+void persistence_kick(void);
+
+/**
+ * @brief Register a hook run after each batch and by persistence_flush()
+ * @return false if the hook table is full
+ */
+bool persistence_register_flush_hook(persist_flush_hook_t hook);
+
+void persistence_print_stats(void);
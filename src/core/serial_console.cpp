@@ -0,0 +1,138 @@
+#include "serial_console.h"
+#include <string.h>
+#include <stdlib.h>
+
+#include "hardware/display/lvgl_driver.h"
+
+#define CONSOLE_MAX_COMMANDS  24
+#define CONSOLE_LINE_LEN      96
+
+struct ConsoleCommand {
+  const char *name;
+  const char *help;
+  console_handler_t handler;
+};
+
+static ConsoleCommand commands[CONSOLE_MAX_COMMANDS];
+static size_t command_count = 0;
+static char line_buf[CONSOLE_LINE_LEN];
+static size_t line_len = 0;
+
+bool serial_console_register(const char *name, const char *help, console_handler_t handler) {
+  if (command_count >= CONSOLE_MAX_COMMANDS) {
+    printf("[Console] Command table full, '%s' not registered\n", name);
+    return false;
+  }
+  commands[command_count++] = { name, help, handler };
+  return true;
+}
+
+static bool arg_is(const char *args, const char *word) {
+  return strncmp(args, word, strlen(word)) == 0;
+}
+
+// ---- Built-in commands ----
+
+static void cmd_help(const char *args) {
+  printf("[Console] Commands:\n");
+  for (size_t i = 0; i < command_count; i++) {
+    printf("  %-10s %s\n", commands[i].name, commands[i].help);
+  }
+}
+
+static void cmd_stats(const char *args) {
+  bool reset = arg_is(args, "reset");
+#if DISPLAY_STATS
+  if (reset) DisplayStats_Reset(); else DisplayStats_Print();
+#else
+  if (!reset) printf("[Console] Display stats compiled out (DISPLAY_STATS=0)\n");
+#endif
+#if LCD_ROUND_CLIP
+  if (reset) RoundMask_ResetStats(); else RoundMask_PrintStats();
+#endif
+  if (reset) {
+    LCD_ResetTEStats();
+    printf("[Console] Stats reset\n");
+  } else {
+    LCD_PrintTEStats();
+  }
+}
+
+static void cmd_overlay(const char *args) {
+#if DISPLAY_STATS
+  bool show = arg_is(args, "on") || (!arg_is(args, "off") && !DisplayStats_OverlayVisible());
+  DisplayStats_SetOverlay(show);
+#else
+  printf("[Console] Display stats compiled out (DISPLAY_STATS=0)\n");
+#endif
+}
+
+static void cmd_te(const char *args) {
+  if (arg_is(args, "on")) LCD_SetTESync(true);
+  else if (arg_is(args, "off")) LCD_SetTESync(false);
+  LCD_PrintTEStats();
+}
+
+static void cmd_mode(const char *args) {
+  if (arg_is(args, "partial")) Lvgl_SetRenderMode(LV_DISPLAY_RENDER_MODE_PARTIAL);
+  else if (arg_is(args, "full")) Lvgl_SetRenderMode(LV_DISPLAY_RENDER_MODE_FULL);
+  else if (arg_is(args, "direct")) Lvgl_SetRenderMode(LV_DISPLAY_RENDER_MODE_DIRECT);
+  else printf("[Console] Render mode: %s\n", Lvgl_RenderModeName(Lvgl_GetRenderMode()));
+}
+
+static void cmd_bench(const char *args) {
+  // bench [scene] [frames]
+  char scene[24] = "screen";
+  unsigned frames = 20;
+  sscanf(args, "%23s %u", scene, &frames);
+  Lvgl_BenchmarkRenderModes(scene, frames);
+}
+
+static void cmd_heap(const char *args) {
+  printf("[Console] Heap internal: %u free (largest %u), PSRAM: %u free\n",
+         (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL),
+         (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL),
+         (unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+}
+
+void serial_console_init(void) {
+  serial_console_register("help", "List commands", cmd_help);
+  serial_console_register("stats", "Dump display stats ('stats reset' clears them)", cmd_stats);
+  serial_console_register("overlay", "Toggle on-screen display stats [on|off]", cmd_overlay);
+  serial_console_register("te", "TE vsync sync [on|off] and its stats", cmd_te);
+  serial_console_register("mode", "Render mode [partial|full|direct]", cmd_mode);
+  serial_console_register("bench", "Benchmark render modes on this screen [scene] [frames]", cmd_bench);
+  serial_console_register("heap", "Show free heap", cmd_heap);
+  printf("[Console] Ready, type 'help'\n");
+}
+
+static void run_line(char *line) {
+  while (*line == ' ') line++;
+  if (*line == '\0') return;
+
+  char *args = line;
+  while (*args && *args != ' ') args++;
+  if (*args) *args++ = '\0';
+  while (*args == ' ') args++;
+
+  for (size_t i = 0; i < command_count; i++) {
+    if (strcmp(commands[i].name, line) == 0) {
+      commands[i].handler(args);
+      return;
+    }
+  }
+  printf("[Console] Unknown command '%s', type 'help'\n", line);
+}
+
+void serial_console_poll(void) {
+  while (Serial.available() > 0) {
+    int c = Serial.read();
+    if (c == '\r' || c == '\n') {
+      line_buf[line_len] = '\0';
+      run_line(line_buf);
+      line_len = 0;
+    } else if (line_len < CONSOLE_LINE_LEN - 1) {
+      line_buf[line_len++] = (char)c;
+    }
+  }
+}
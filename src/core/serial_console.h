@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Handler for a serial console command
+ * @param args Everything after the command name (never NULL, may be empty)
+ */
+typedef void (*console_handler_t)(const char *args);
+
+/**
+ * @brief Initialize the serial debug console and its built-in commands
+ *
+ * Reads newline terminated commands from Serial. Must be called after
+ * Serial.begin() and Lvgl_Init().
+ */
+void serial_console_init(void);
+
+/**
+ * @brief Read pending serial input and run complete commands
+ *
+ * Non-blocking. Call from the thread that owns LVGL, handlers may touch the UI.
+ */
+void serial_console_poll(void);
+
+/**
+ * @brief Register an additional console command
+ * @param name Command name (first word of the line)
+ * @param help One line description shown by "help"
+ * @param handler Function called with the rest of the line
+ * @return false if the command table is full
+ */
+bool serial_console_register(const char *name, const char *help, console_handler_t handler);
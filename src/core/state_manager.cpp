@@ -6,6 +6,8 @@
 #include "core/state_manager.h"
 #include "data/constants.h"
 #include <ArduinoNvs.h>
+#include <nvs.h>
+#include <string.h>
 
 /// Global instance for player/game state storage
 StateStore player_store(PLAYER_STORE);
@@ -20,28 +22,403 @@ StateStore::StateStore(const char *ns) : nsName(ns)
     nvs_global_initialized = true;
   }
   nvs.begin(nsName); // Initialize the namespace for this instance
+  mutex = xSemaphoreCreateMutex();
+  flushMutex = xSemaphoreCreateMutex();
+  minuteStartMs = millis();
+  load();
+  ready = true;
 }
 
 StateStore::~StateStore() {}
 
+// The global store is constructed before the scheduler runs (and may already
+// be used by other static initializers), only lock once there are tasks
+void StateStore::lock()
+{
+  if (mutex && xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+    xSemaphoreTake(mutex, portMAX_DELAY);
+}
+
+void StateStore::unlock()
+{
+  if (mutex && xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+    xSemaphoreGive(mutex);
+}
+
+void StateStore::countRead()
+{
+  stats.nvs_reads++;
+  uint32_t now = millis();
+  if (now - minuteStartMs >= 60000)
+  {
+    stats.reads_last_minute = (now - minuteStartMs >= 120000) ? 0 : stats.nvs_reads - minuteStartReads;
+    minuteStartMs = now;
+    minuteStartReads = stats.nvs_reads;
+  }
+}
+
+// NVS rejects longer keys, so such a value could never be stored; say so
+// instead of silently returning the default forever
+bool StateStore::checkKey(const char *key)
+{
+  if (strlen(key) <= STATE_CACHE_KEY_LEN)
+    return true;
+  stats.key_errors++;
+  printf("[StateStore] ERROR: key '%s' is longer than %d characters, NVS cannot store it\n",
+         key, STATE_CACHE_KEY_LEN);
+  return false;
+}
+
+StateStore::CacheEntry *StateStore::findEntry(const char *key, bool insert)
+{
+  size_t len = strlen(key);
+  if (len > STATE_CACHE_KEY_LEN)
+    return nullptr;
+
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < len; i++)
+    hash = (hash ^ (uint8_t)key[i]) * 16777619u;
+
+  for (size_t probe = 0; probe < STATE_CACHE_SLOTS; probe++)
+  {
+    CacheEntry *entry = &cache[(hash + probe) & (STATE_CACHE_SLOTS - 1)];
+    if (entry->type == ENTRY_EMPTY)
+    {
+      if (!insert)
+        return nullptr;
+      memcpy(entry->key, key, len + 1);
+      entry->dirty = false;
+      cacheCount++;
+      return entry;
+    }
+    if (strcmp(entry->key, key) == 0)
+      return entry;
+  }
+  return nullptr;
+}
+
+void StateStore::load()
+{
+#if STATE_CACHE
+  lock();
+  uint32_t start_us = micros();
+  size_t skipped = 0;
+  cacheComplete = true;
+
+  nvs_iterator_t it = nullptr;
+  esp_err_t err = nvs_entry_find(NVS_DEFAULT_PART_NAME, nsName, NVS_TYPE_ANY, &it);
+  while (err == ESP_OK)
+  {
+    nvs_entry_info_t info;
+    nvs_entry_info(it, &info);
+    if (info.type == NVS_TYPE_STR || (info.type & 0xF0) <= 0x10)  // string or integer types
+    {
+      CacheEntry *entry = findEntry(info.key, true);
+      if (!entry)
+      {
+        cacheComplete = false;
+        skipped++;
+      }
+      else if (info.type == NVS_TYPE_STR)
+      {
+        entry->type = ENTRY_STRING;
+        entry->strValue = nvs.getString(info.key);
+        countRead();
+      }
+      else
+      {
+        entry->type = ENTRY_INT;
+        entry->intValue = nvs.getInt(info.key, 0);
+        countRead();
+      }
+    }
+    err = nvs_entry_next(&it);
+  }
+  nvs_release_iterator(it);
+
+  printf("[StateStore] Loaded %u keys of '%s' into RAM in %lu us%s\n",
+         (unsigned)cacheCount, nsName, (unsigned long)(micros() - start_us),
+         skipped ? ", cache full" : "");
+  unlock();
+#endif
+}
+
 void StateStore::putInt(const char *key, u_int64_t value)
 {
-  nvs.setInt(key, value);
+  if (!checkKey(key))
+    return;
+  if (!ready || !STATE_CACHE)
+  {
+    stats.nvs_writes++;
+    nvs.setInt(key, value);
+    return;
+  }
+
+  lock();
+  CacheEntry *entry = findEntry(key, true);
+  if (!entry)
+    cacheComplete = false;  // Cache full, reads of this key must go to NVS
+  if (entry && entry->type == ENTRY_INT && entry->intValue == value)
+  {
+    stats.writes_skipped++;
+    unlock();
+    return;
+  }
+  if (entry)
+  {
+    entry->type = ENTRY_INT;
+    entry->intValue = value;
+    entry->strValue = String();
+    entry->dirty = writeBack;
+  }
+  bool deferred = entry && writeBack;
+  if (!deferred)
+  {
+    stats.nvs_writes++;
+    if (!nvs.setInt(key, value) && entry)
+    {
+      // Left dirty, the next flush() tries again
+      printf("[StateStore] Failed to write '%s', keeping it dirty\n", key);
+      entry->dirty = true;
+      stats.write_errors++;
+    }
+  }
+  unlock();
+
+  if (deferred && writeHook)
+    writeHook(key);
 }
 
 u_int64_t StateStore::getInt(const char *key, u_int64_t defaultValue)
 {
-  return nvs.getInt(key, defaultValue);
+  if (!checkKey(key))
+    return defaultValue;
+  if (!ready || !STATE_CACHE)
+  {
+    countRead();
+    return nvs.getInt(key, defaultValue);
+  }
+
+  lock();
+  CacheEntry *entry = findEntry(key, false);
+  if (entry || cacheComplete)
+  {
+    stats.cache_hits++;
+    u_int64_t value = (entry && entry->type == ENTRY_INT) ? entry->intValue : defaultValue;
+    unlock();
+    return value;
+  }
+  // Key did not fit the cache, read it every time
+  countRead();
+  u_int64_t value = nvs.getInt(key, defaultValue);
+  unlock();
+  return value;
 }
 
 void StateStore::putString(const char *key, const char *value)
 {
-  nvs.setString(key, value);
+  if (!checkKey(key))
+    return;
+  if (!ready || !STATE_CACHE)
+  {
+    stats.nvs_writes++;
+    nvs.setString(key, value);
+    return;
+  }
+
+  lock();
+  CacheEntry *entry = findEntry(key, true);
+  if (!entry)
+    cacheComplete = false;  // Cache full, reads of this key must go to NVS
+  if (entry && entry->type == ENTRY_STRING && entry->strValue == value)
+  {
+    stats.writes_skipped++;
+    unlock();
+    return;
+  }
+  if (entry)
+  {
+    entry->type = ENTRY_STRING;
+    entry->strValue = value;
+    entry->dirty = writeBack;
+  }
+  bool deferred = entry && writeBack;
+  if (!deferred)
+  {
+    stats.nvs_writes++;
+    if (!nvs.setString(key, value) && entry)
+    {
+      // Left dirty, the next flush() tries again
+      printf("[StateStore] Failed to write '%s', keeping it dirty\n", key);
+      entry->dirty = true;
+      stats.write_errors++;
+    }
+  }
+  unlock();
+
+  if (deferred && writeHook)
+    writeHook(key);
 }
 
 String StateStore::getString(const char *key, const char *defaultValue)
 {
-  return nvs.getString(key, defaultValue);
+  if (!checkKey(key))
+    return String(defaultValue);
+  if (!ready || !STATE_CACHE)
+  {
+    countRead();
+    return nvs.getString(key, defaultValue);
+  }
+
+  lock();
+  CacheEntry *entry = findEntry(key, false);
+  if (entry || cacheComplete)
+  {
+    stats.cache_hits++;
+    String value = (entry && entry->type == ENTRY_STRING) ? entry->strValue : String(defaultValue);
+    unlock();
+    return value;
+  }
+  countRead();
+  String value = nvs.getString(key, defaultValue);
+  unlock();
+  return value;
+}
+
+void StateStore::setWriteBack(bool enable)
+{
+  if (!enable && writeBack)
+  {
+    writeBack = false;
+    flush();
+  }
+  writeBack = enable;
+}
+
+size_t StateStore::flush()
+{
+  bool scheduler_running = xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED;
+  if (flushMutex && scheduler_running)
+    xSemaphoreTake(flushMutex, portMAX_DELAY);
+
+  // Slots written in this batch, marked dirty again if the commit fails
+  uint8_t written_slots[STATE_CACHE_SLOTS];
+  size_t written = 0;
+  for (size_t i = 0; i < STATE_CACHE_SLOTS; i++)
+  {
+    // Copy one dirty value out under the lock, write it to flash without it.
+    // The flag is cleared before the write, so a put during the write marks
+    // the value dirty again.
+    char key[STATE_CACHE_KEY_LEN + 1];
+    EntryType type = ENTRY_EMPTY;
+    uint64_t int_value = 0;
+    String str_value;
+
+    lock();
+    CacheEntry *entry = &cache[i];
+    bool dirty = entry->type != ENTRY_EMPTY && entry->dirty;
+    if (dirty)
+    {
+      memcpy(key, entry->key, sizeof(key));
+      type = entry->type;
+      int_value = entry->intValue;
+      if (type == ENTRY_STRING)
+        str_value = entry->strValue;
+      entry->dirty = false;
+    }
+    unlock();
+    if (!dirty)
+      continue;
+
+    bool ok = (type == ENTRY_INT) ? nvs.setInt(key, int_value, false)
+                                  : nvs.setString(key, str_value, false);
+    if (ok)
+    {
+      written_slots[written++] = (uint8_t)i;
+      continue;
+    }
+    printf("[StateStore] Failed to write '%s', keeping it dirty\n", key);
+    lock();
+    cache[i].dirty = true;
+    stats.write_errors++;
+    unlock();
+  }
+
+  if (written && !nvs.commit())
+  {
+    printf("[StateStore] Commit of %u values failed, keeping them dirty\n", (unsigned)written);
+    lock();
+    for (size_t i = 0; i < written; i++)
+      cache[written_slots[i]].dirty = true;
+    stats.write_errors++;
+    unlock();
+    written = 0;
+  }
+  if (written)
+  {
+    lock();
+    stats.nvs_writes += written;
+    unlock();
+  }
+
+  if (flushMutex && scheduler_running)
+    xSemaphoreGive(flushMutex);
+  return written;
+}
+
+size_t StateStore::dirtyCount()
+{
+  lock();
+  size_t dirty = 0;
+  for (size_t i = 0; i < STATE_CACHE_SLOTS; i++)
+  {
+    if (cache[i].type != ENTRY_EMPTY && cache[i].dirty)
+      dirty++;
+  }
+  unlock();
+  return dirty;
+}
+
+void StateStore::getStats(StateStoreStats *out)
+{
+  size_t dirty = dirtyCount();
+  lock();
+  // Roll the minute window even if nothing was read lately
+  uint32_t now = millis();
+  if (now - minuteStartMs >= 60000)
+  {
+    stats.reads_last_minute = (now - minuteStartMs >= 120000) ? 0 : stats.nvs_reads - minuteStartReads;
+    minuteStartMs = now;
+    minuteStartReads = stats.nvs_reads;
+  }
+  *out = stats;
+  out->entries = cacheCount;
+  out->dirty = dirty;
+  unlock();
+}
+
+void StateStore::resetStats()
+{
+  lock();
+  stats = {};
+  minuteStartMs = millis();
+  minuteStartReads = 0;
+  unlock();
+}
+
+void StateStore::printStats()
+{
+  StateStoreStats s;
+  getStats(&s);
+  printf("[StateStore] '%s' cache=%s %s, %lu keys%s, %lu dirty\n", nsName,
+         STATE_CACHE ? "on" : "off", writeBack ? "write-back" : "write-through",
+         (unsigned long)s.entries, cacheComplete ? "" : " (incomplete)", (unsigned long)s.dirty);
+  printf("[StateStore] NVS reads=%lu (last minute: %lu), writes=%lu, skipped writes=%lu, cache hits=%lu\n",
+         (unsigned long)s.nvs_reads, (unsigned long)s.reads_last_minute, (unsigned long)s.nvs_writes,
+         (unsigned long)s.writes_skipped, (unsigned long)s.cache_hits);
+  printf("[StateStore] write errors=%lu, bad keys=%lu\n",
+         (unsigned long)s.write_errors, (unsigned long)s.key_errors);
 }
 
 // Timer settings functions
@@ -62,11 +439,13 @@ void setTimerDuration(int duration) {
     player_store.putInt("timer_duration", duration);
 }
 
+// Was "timer_warning_enabled", which is over the 15 character NVS key limit and
+// was never stored, so there is no old value to carry over
 bool getTimerWarningEnabled() {
-    return player_store.getInt("timer_warning_enabled", 1) != 0; // Default: enabled
+    return player_store.getInt("timer_warn_en", 1) != 0; // Default: enabled
 }
 
 void toggleTimerWarningEnabled() {
     bool current = getTimerWarningEnabled();
-    player_store.putInt("timer_warning_enabled", current ? 0 : 1);
+    player_store.putInt("timer_warn_en", current ? 0 : 1);
 }
\ No newline at end of file
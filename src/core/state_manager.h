@@ -2,6 +2,39 @@
 #include <Arduino.h>
 #include <ArduinoNvs.h>
 #include <cstdint>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// Set to 0 to read every value straight from NVS as before (baseline for the
+// NVS read counter)
+#ifndef STATE_CACHE
+#define STATE_CACHE 1
+#endif
+
+#define STATE_CACHE_SLOTS       128   // power of two, open addressing
+#define STATE_CACHE_KEY_LEN     15    // NVS key limit without the terminator
+
+/**
+ * @brief NVS access counters of a StateStore
+ */
+struct StateStoreStats
+{
+  uint32_t nvs_reads;          ///< values read from flash (including the boot load)
+  uint32_t nvs_writes;         ///< values written to flash
+  uint32_t writes_skipped;     ///< puts that matched the cached value
+  uint32_t write_errors;       ///< failed NVS writes or commits, the values stay dirty
+  uint32_t key_errors;         ///< accesses with a key longer than STATE_CACHE_KEY_LEN
+  uint32_t cache_hits;         ///< gets answered from RAM
+  uint32_t reads_last_minute;  ///< NVS reads during the last full minute
+  uint32_t entries;            ///< keys held in the cache
+  uint32_t dirty;              ///< cached values not written to flash yet
+};
+
+/**
+ * @brief Called after a put in write-back mode left a value dirty
+ * @param key Key that changed
+ */
+typedef void (*StateStoreWriteHook)(const char *key);
 
 /**
  * @brief Persistent state storage manager using ESP32 NVS
@@ -9,6 +42,10 @@
  * Provides a convenient wrapper around Arduino NVS for storing
  * configuration values and game state persistently in flash memory.
  * All data survives power cycles and firmware updates.
+ *
+ * The whole namespace is loaded into a RAM cache once, so getters never
+ * touch flash. Puts are written through by default; in write-back mode they
+ * only mark the cached value dirty until flush(). Thread-safe.
  */
 class StateStore
 {
@@ -54,9 +91,82 @@ public:
    */
   String getString(const char *key, const char *defaultValue = "");
 
+  /**
+   * @brief Load every key of the namespace into the RAM cache
+   *
+   * Called by the constructor. Keys that do not fit the cache are read from
+   * NVS on demand.
+   */
+  void load();
+
+  /**
+   * @brief Switch between write-through (default) and write-back
+   *
+   * Leaving write-back mode flushes the dirty values.
+   */
+  void setWriteBack(bool enable);
+  bool isWriteBack() const { return writeBack; }
+
+  /**
+   * @brief Set the hook called for every put that leaves a dirty value
+   *
+   * Called from the task doing the put, outside the cache lock.
+   */
+  void setWriteHook(StateStoreWriteHook hook) { writeHook = hook; }
+
+  /**
+   * @brief Write all dirty values to NVS and commit once
+   *
+   * The cache lock is only held while copying each value out, so readers
+   * never wait for flash. Concurrent flushes are serialized. A value whose
+   * write (or the commit) fails stays dirty for the next flush.
+   *
+   * @return Number of values written
+   */
+  size_t flush();
+
+  /**
+   * @brief Number of cached values not written to NVS yet
+   */
+  size_t dirtyCount();
+
+  void getStats(StateStoreStats *stats);
+  void resetStats();
+  void printStats();
+
 private:
+  enum EntryType : uint8_t { ENTRY_EMPTY = 0, ENTRY_INT, ENTRY_STRING };
+
+  struct CacheEntry
+  {
+    char key[STATE_CACHE_KEY_LEN + 1];
+    EntryType type;
+    bool dirty;
+    uint64_t intValue;
+    String strValue;
+  };
+
+  CacheEntry *findEntry(const char *key, bool insert);
+  bool checkKey(const char *key);
+  void lock();
+  void unlock();
+  void countRead();
+
   const char *nsName;  ///< NVS namespace name
   ArduinoNvs nvs;     ///< Arduino NVS instance
+
+  CacheEntry cache[STATE_CACHE_SLOTS];
+  size_t cacheCount = 0;
+  bool ready = false;          ///< constructed, before that accessors go to NVS directly
+  bool cacheComplete = false;  ///< every key of the namespace is in the cache
+  bool writeBack = false;
+  StateStoreWriteHook writeHook = nullptr;
+  SemaphoreHandle_t mutex = nullptr;
+  SemaphoreHandle_t flushMutex = nullptr;
+
+  StateStoreStats stats = {};
+  uint32_t minuteStartMs = 0;
+  uint32_t minuteStartReads = 0;
 };
 
 /// Global instance for player/game state storage
@@ -0,0 +1,69 @@
+#include "ui_task.h"
+#include <lvgl.h>
+
+#include "core/main.h"
+#include "core/serial_console.h"
+#include "ui/screens/life/life_counter.h"
+#include "ui/screens/life/life_counter_two_player.h"
+
+struct UiCommand {
+  ui_cmd_fn_t fn;
+  void *arg;
+};
+
+static QueueHandle_t ui_queue = nullptr;
+static TaskHandle_t ui_task_handle = nullptr;
+
+static void ui_task(void *arg) {
+  for (;;) {
+    lv_lock();
+    uint32_t next_timer_ms = lv_timer_handler();
+
+    // Life total grouping commits update labels, so they run here too
+    if (life_counter_mode == PLAYER_MODE_ONE_PLAYER) {
+      life_counter_loop();
+    } else if (life_counter_mode == PLAYER_MODE_TWO_PLAYER) {
+      life_counter2p_loop();
+    }
+    serial_console_poll();
+    lv_unlock();
+
+    // Sleep until the next LVGL timer is due, or wake early for a posted command
+    uint32_t wait_ms = LV_CLAMP(1, next_timer_ms, UI_TASK_MAX_SLEEP_MS);
+    UiCommand cmd;
+    if (xQueueReceive(ui_queue, &cmd, pdMS_TO_TICKS(wait_ms)) == pdTRUE) {
+      lv_lock();
+      do {
+        cmd.fn(cmd.arg);
+      } while (xQueueReceive(ui_queue, &cmd, 0) == pdTRUE);
+      lv_unlock();
+    }
+  }
+}
+
+void ui_task_start(void) {
+  if (ui_task_handle) return;
+
+  ui_queue = xQueueCreate(UI_QUEUE_LENGTH, sizeof(UiCommand));
+  if (xTaskCreatePinnedToCore(ui_task, "ui", UI_TASK_STACK_SIZE, nullptr,
+                              UI_TASK_PRIORITY, &ui_task_handle, UI_TASK_CORE) != pdPASS) {
+    printf("[UI] Failed to create UI task\n");
+    ui_task_handle = nullptr;
+    return;
+  }
+  printf("[UI] UI task running on core %d\n", UI_TASK_CORE);
+}
+
+bool ui_post(ui_cmd_fn_t fn, void *arg) {
+  if (!ui_queue || !fn) return false;
+  UiCommand cmd = { fn, arg };
+  if (xQueueSend(ui_queue, &cmd, 0) != pdTRUE) {
+    printf("[UI] Command queue full, update dropped\n");
+    return false;
+  }
+  return true;
+}
+
+bool ui_is_ui_task(void) {
+  return ui_task_handle != nullptr && xTaskGetCurrentTaskHandle() == ui_task_handle;
+}
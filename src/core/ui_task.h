@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Arduino.h>
+
+/// LVGL and everything that touches it runs on this core; the Arduino loop
+/// (power, battery) and the audio task stay on the other one
+#define UI_TASK_CORE          0
+#define UI_TASK_STACK_SIZE    16384
+#define UI_TASK_PRIORITY      3
+#define UI_QUEUE_LENGTH       16
+/// Upper bound for sleeping between lv_timer_handler() runs
+#define UI_TASK_MAX_SLEEP_MS  5
+
+/**
+ * @brief UI command, runs on the UI task with the LVGL lock held
+ */
+typedef void (*ui_cmd_fn_t)(void *arg);
+
+/**
+ * @brief Start the UI task, the only task that calls into LVGL from then on
+ *
+ * Call at the end of setup(), after the first screen was built.
+ */
+void ui_task_start(void);
+
+/**
+ * @brief Queue a UI update from any task
+ *
+ * Never blocks. Tasks other than the UI task must use this instead of
+ * calling LVGL directly.
+ *
+ * @param fn Function to run on the UI task
+ * @param arg Passed to fn, must stay valid until fn has run
+ * @return false if the queue is full (or the UI task is not running)
+ */
+bool ui_post(ui_cmd_fn_t fn, void *arg);
+
+/**
+ * @brief True when called from the UI task
+ */
+bool ui_is_ui_task(void);
@@ -1,10 +1,12 @@
 #pragma once
 #include "lvgl.h"
+#include "player_mode.h"
 
 #define SCREEN_WIDTH 360
 #define SCREEN_HEIGHT 360
 #define SCREEN_DIAMETER SCREEN_WIDTH
 #define ARC_WIDTH 8
+#define ARC_GAP_DEGREES 60          // 2P arcs: gap at the top and bottom
 
 // *** SMOOTH ANIMATION CONSTANTS ***
 #define SMOOTH_ARC_STEPS 1000        // High-resolution animation steps for smooth arcs
@@ -23,12 +25,6 @@ typedef struct
 #define PLAYER_TWO 2
 #define GROUPER_WINDOW 500  // Reduced from 2000ms for faster auto-save
 
-enum PlayerMode
-{
-  PLAYER_MODE_ONE_PLAYER = 0,
-  PLAYER_MODE_TWO_PLAYER = 1
-};
-
 // Enum for menu states
 enum MenuState
 {
@@ -58,9 +54,12 @@ enum ContextualQuadrant
 };
 
 // Color Constants
-#define GREEN_COLOR lv_color_hex(0x00e31f)
-#define YELLOW_COLOR lv_color_hex(0xebf700)
-#define RED_COLOR lv_color_hex(0xe80000)
+#define GREEN_HEX 0x00e31f
+#define YELLOW_HEX 0xebf700
+#define RED_HEX 0xe80000
+#define GREEN_COLOR lv_color_hex(GREEN_HEX)
+#define YELLOW_COLOR lv_color_hex(YELLOW_HEX)
+#define RED_COLOR lv_color_hex(RED_HEX)
 #define LIGHTNING_BLUE_COLOR lv_color_hex(0x0070ff)
 #define WHITE_COLOR lv_color_hex(0xffffff)
 #define BLACK_COLOR lv_color_hex(0x000000)
@@ -6,6 +6,7 @@
 // ============================================
 // System & Framework Headers
 // ============================================
+#include <Arduino.h>
 #include <lvgl.h>
 
 // ============================================
@@ -28,11 +29,146 @@
 
 extern lv_obj_t *history_menu;
 
-void renderHistoryOverlay()
+// The list only ever holds HISTORY_POOL_ROWS rows of labels. Each event row i
+// sits at y = i * HISTORY_ROW_HEIGHT inside the scroll area and is shown by pool
+// slot i % HISTORY_POOL_ROWS; a slot is only reformatted when it is moved to a
+// different event, so scrolling by one row formats one row.
+#define HISTORY_LIST_HEIGHT   (SCREEN_HEIGHT - 140 - HISTORY_ROW_HEIGHT)
+#define HISTORY_POOL_ROWS     (HISTORY_LIST_HEIGHT / HISTORY_ROW_HEIGHT + 2)
+#define HISTORY_MAX_COLUMNS   2
+
+struct HistoryView
+{
+  lv_obj_t *list;
+  lv_obj_t *spacer;      ///< last pixel of the content, sets the scroll range
+  lv_timer_t *poll;
+  lv_obj_t *cells[HISTORY_POOL_ROWS][HISTORY_MAX_COLUMNS];
+  size_t bound_row[HISTORY_POOL_ROWS];
+  const LifeHistoryRing *columns[HISTORY_MAX_COLUMNS];
+  uint32_t column_total[HISTORY_MAX_COLUMNS];   ///< events ever pushed, to see appends
+  int column_count;
+  size_t row_count;
+  uint32_t rows_formatted;
+};
+
+static HistoryView view = {};
+
+static const size_t ROW_UNBOUND = (size_t)-1;
+
+static uint32_t ring_total(const LifeHistoryRing *ring)
+{
+  return (uint32_t)ring->size() + ring->dropped();
+}
+
+static void format_event(char *buf, size_t len, const PackedLifeEvent &evt)
+{
+  if (evt.net_change > 0)
+    snprintf(buf, len, "+%d [%d]", evt.net_change, evt.life_total);
+  else
+    snprintf(buf, len, "%d [%d]", evt.net_change, evt.life_total);
+}
+
+static void update_content_height()
+{
+  lv_obj_set_y(view.spacer, view.row_count ? (int32_t)view.row_count * HISTORY_ROW_HEIGHT - 1 : 0);
+}
+
+// Bind the pool slots to the rows in (or next to) the visible window
+static void refresh_visible_rows()
+{
+  if (!view.list)
+    return;
+
+  int32_t scroll_y = lv_obj_get_scroll_y(view.list);
+  size_t first = scroll_y > 0 ? (size_t)(scroll_y / HISTORY_ROW_HEIGHT) : 0;
+
+  for (size_t k = 0; k < HISTORY_POOL_ROWS; ++k)
+  {
+    size_t row = first + k;
+    size_t slot = row % HISTORY_POOL_ROWS;
+    if (view.bound_row[slot] == row)
+      continue;
+
+    if (row >= view.row_count)
+    {
+      for (int c = 0; c < view.column_count; ++c)
+        lv_obj_add_flag(view.cells[slot][c], LV_OBJ_FLAG_HIDDEN);
+      view.bound_row[slot] = ROW_UNBOUND;
+      continue;
+    }
+
+    for (int c = 0; c < view.column_count; ++c)
+    {
+      lv_obj_t *cell = view.cells[slot][c];
+      const LifeHistoryRing *ring = view.columns[c];
+      if (row < ring->size())
+      {
+        char buf[32];
+        format_event(buf, sizeof(buf), (*ring)[row]);
+        lv_label_set_text(cell, buf);
+      }
+      else
+      {
+        lv_label_set_text_static(cell, "");
+      }
+      lv_obj_set_y(cell, (int32_t)row * HISTORY_ROW_HEIGHT);
+      lv_obj_remove_flag(cell, LV_OBJ_FLAG_HIDDEN);
+    }
+    view.bound_row[slot] = row;
+    view.rows_formatted++;
+  }
+}
+
+static void history_scroll_cb(lv_event_t *e)
+{
+  refresh_visible_rows();
+}
+
+// Pick up events committed while the overlay is open
+static void history_poll_cb(lv_timer_t *timer)
+{
+  bool changed = false;
+  size_t rows = 0;
+  for (int c = 0; c < view.column_count; ++c)
+  {
+    uint32_t total = ring_total(view.columns[c]);
+    if (total != view.column_total[c])
+    {
+      changed = true;
+      view.column_total[c] = total;
+    }
+    if (view.columns[c]->size() > rows)
+      rows = view.columns[c]->size();
+  }
+  if (!changed)
+    return;
+
+  // A full ring moves every event up one row and the shorter column of a 2P
+  // game fills blank cells, so rebind the whole pool (a handful of rows)
+  bool follow = lv_obj_get_scroll_bottom(view.list) <= HISTORY_ROW_HEIGHT;
+  for (size_t k = 0; k < HISTORY_POOL_ROWS; ++k)
+    view.bound_row[k] = ROW_UNBOUND;
+  view.row_count = rows;
+  update_content_height();
+  if (follow)
+  {
+    lv_obj_update_layout(view.list);
+    lv_obj_scroll_to_y(view.list, LV_COORD_MAX, LV_ANIM_OFF);
+  }
+  refresh_visible_rows();
+}
+
+static void history_delete_cb(lv_event_t *e)
+{
+  if (view.poll)
+    lv_timer_delete(view.poll);
+  view = {};
+}
+
+static void createHistoryOverlay(const LifeHistoryRing *col1, const LifeHistoryRing *col2)
 {
   teardownHistoryOverlay();
-  PlayerMode player_mode = (PlayerMode)player_store.getInt(KEY_PLAYER_MODE, PLAYER_MODE_ONE_PLAYER);
-  
+
   history_menu = lv_obj_create(lv_scr_act());
   lv_obj_set_size(history_menu, SCREEN_WIDTH, SCREEN_HEIGHT);
   lv_obj_set_style_bg_color(history_menu, BLACK_COLOR, LV_PART_MAIN);
@@ -53,78 +189,81 @@ void renderHistoryOverlay()
   lv_obj_center(lbl_back);
   lv_obj_set_style_text_color(lbl_back, lv_color_black(), 0);
   lv_obj_add_event_cb(btn_back, [](lv_event_t *e) { renderMenu(MENU_CONTEXTUAL, false); }, LV_EVENT_CLICKED, NULL);
-  
-  lv_obj_t *table = lv_table_create(history_menu);
-  lv_obj_set_grid_cell(table, LV_GRID_ALIGN_CENTER, 0, 1, LV_GRID_ALIGN_STRETCH, 1, 1);
-  lv_obj_set_style_bg_color(table, lv_color_black(), LV_PART_MAIN);
-  lv_obj_set_scroll_dir(table, LV_DIR_VER);
-  
-  if (player_mode == PLAYER_MODE_TWO_PLAYER) {
-    // 2 Spalten
-    lv_table_set_col_cnt(table, 2);
-    lv_table_set_col_width(table, 0, (SCREEN_WIDTH - 20) / 2);
-    lv_table_set_col_width(table, 1, (SCREEN_WIDTH - 20) / 2);
-    lv_table_set_row_cnt(table, 1);
-    lv_table_set_cell_value(table, 0, 0, "P1");
-    lv_table_set_cell_value(table, 0, 1, "P2");
-    
-    std::vector<LifeHistoryEvent> h1 = event_grouper_p1.getHistory();
-    std::vector<LifeHistoryEvent> h2 = event_grouper_p2.getHistory();
-    
-    size_t max_rows = (h1.size() > h2.size()) ? h1.size() : h2.size();
-    
-    for (size_t i = 0; i < max_rows; ++i) {
-      size_t row_idx = i + 1;
-      lv_table_set_row_cnt(table, row_idx + 1);
-      
-      // P1 Spalte
-      if (i < h1.size()) {
-        const LifeHistoryEvent &evt = h1[i];
-        char buf[32];
-        if (evt.net_life_change > 0)
-          snprintf(buf, sizeof(buf), "+%d [%d]", evt.net_life_change, evt.life_total);
-        else
-          snprintf(buf, sizeof(buf), "%d [%d]", evt.net_life_change, evt.life_total);
-        lv_table_set_cell_value(table, row_idx, 0, buf);
-      } else {
-        lv_table_set_cell_value(table, row_idx, 0, "");
-      }
-      
-      // P2 Spalte
-      if (i < h2.size()) {
-        const LifeHistoryEvent &evt = h2[i];
-        char buf[32];
-        if (evt.net_life_change > 0)
-          snprintf(buf, sizeof(buf), "+%d [%d]", evt.net_life_change, evt.life_total);
-        else
-          snprintf(buf, sizeof(buf), "%d [%d]", evt.net_life_change, evt.life_total);
-        lv_table_set_cell_value(table, row_idx, 1, buf);
-      } else {
-        lv_table_set_cell_value(table, row_idx, 1, "");
-      }
-    }
-  } else {
-    // 1 Spalte
-    lv_table_set_col_cnt(table, 1);
-    lv_table_set_col_width(table, 0, SCREEN_WIDTH - 20);
-    lv_table_set_row_cnt(table, 1);
-    lv_table_set_cell_value(table, 0, 0, "History");
-    
-    std::vector<LifeHistoryEvent> history = event_grouper.getHistory();
-    
-    for (size_t i = 0; i < history.size(); ++i) {
-      const LifeHistoryEvent &evt = history[i];
-      char buf[32];
-      if (evt.net_life_change > 0)
-        snprintf(buf, sizeof(buf), "+%d [%d]", evt.net_life_change, evt.life_total);
-      else
-        snprintf(buf, sizeof(buf), "%d [%d]", evt.net_life_change, evt.life_total);
-      
-      size_t row_idx = i + 1;
-      lv_table_set_row_cnt(table, row_idx + 1);
-      lv_table_set_cell_value(table, row_idx, 0, buf);
+
+  view = {};
+  view.columns[0] = col1;
+  view.columns[1] = col2;
+  view.column_count = col2 ? 2 : 1;
+  int32_t col_width = (SCREEN_WIDTH - 20) / view.column_count;
+
+  // Fixed header above the scrolling rows
+  lv_obj_t *panel = lv_obj_create(history_menu);
+  lv_obj_remove_style_all(panel);
+  lv_obj_set_width(panel, SCREEN_WIDTH - 20);
+  lv_obj_set_grid_cell(panel, LV_GRID_ALIGN_CENTER, 0, 1, LV_GRID_ALIGN_STRETCH, 1, 1);
+  lv_obj_remove_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
+
+  static const char *const headers_2p[] = {"P1", "P2"};
+  for (int c = 0; c < view.column_count; ++c)
+  {
+    lv_obj_t *header = lv_label_create(panel);
+    lv_label_set_text_static(header, view.column_count == 2 ? headers_2p[c] : "History");
+    lv_obj_set_style_text_color(header, lv_color_white(), 0);
+    lv_obj_set_style_text_align(header, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_size(header, col_width, HISTORY_ROW_HEIGHT);
+    lv_obj_set_pos(header, c * col_width, 0);
+    lv_obj_set_style_pad_top(header, (HISTORY_ROW_HEIGHT - lv_font_get_line_height(LV_FONT_DEFAULT)) / 2, 0);
+  }
+
+  view.list = lv_obj_create(panel);
+  lv_obj_remove_style_all(view.list);
+  lv_obj_set_size(view.list, SCREEN_WIDTH - 20, HISTORY_LIST_HEIGHT);
+  lv_obj_set_pos(view.list, 0, HISTORY_ROW_HEIGHT);
+  lv_obj_set_scroll_dir(view.list, LV_DIR_VER);
+  lv_obj_set_scrollbar_mode(view.list, LV_SCROLLBAR_MODE_OFF);
+  lv_obj_add_event_cb(view.list, history_scroll_cb, LV_EVENT_SCROLL, NULL);
+  lv_obj_add_event_cb(view.list, history_delete_cb, LV_EVENT_DELETE, NULL);
+
+  view.spacer = lv_obj_create(view.list);
+  lv_obj_remove_style_all(view.spacer);
+  lv_obj_set_size(view.spacer, 1, 1);
+  lv_obj_remove_flag(view.spacer, LV_OBJ_FLAG_CLICKABLE);
+
+  for (size_t k = 0; k < HISTORY_POOL_ROWS; ++k)
+  {
+    view.bound_row[k] = ROW_UNBOUND;
+    for (int c = 0; c < view.column_count; ++c)
+    {
+      lv_obj_t *cell = lv_label_create(view.list);
+      lv_obj_set_style_text_color(cell, lv_color_white(), 0);
+      lv_obj_set_style_text_align(cell, LV_TEXT_ALIGN_CENTER, 0);
+      lv_obj_set_size(cell, col_width, HISTORY_ROW_HEIGHT);
+      lv_obj_set_x(cell, c * col_width);
+      lv_obj_set_style_pad_top(cell, (HISTORY_ROW_HEIGHT - lv_font_get_line_height(LV_FONT_DEFAULT)) / 2, 0);
+      lv_obj_add_flag(cell, LV_OBJ_FLAG_HIDDEN);
+      view.cells[k][c] = cell;
     }
   }
+
+  for (int c = 0; c < view.column_count; ++c)
+  {
+    view.column_total[c] = ring_total(view.columns[c]);
+    if (view.columns[c]->size() > view.row_count)
+      view.row_count = view.columns[c]->size();
+  }
+  update_content_height();
+  refresh_visible_rows();
+
+  view.poll = lv_timer_create(history_poll_cb, HISTORY_POLL_MS, NULL);
+}
+
+void renderHistoryOverlay()
+{
+  PlayerMode player_mode = (PlayerMode)player_store.getInt(KEY_PLAYER_MODE, PLAYER_MODE_ONE_PLAYER);
+  if (player_mode == PLAYER_MODE_TWO_PLAYER)
+    createHistoryOverlay(&event_grouper_p1.getHistory(), &event_grouper_p2.getHistory());
+  else
+    createHistoryOverlay(&event_grouper.getHistory(), nullptr);
 }
 
 void teardownHistoryOverlay() {
@@ -132,4 +271,57 @@ void teardownHistoryOverlay() {
     lv_obj_del(history_menu);
     history_menu = nullptr;
   }
-}
\ No newline at end of file
+}
+
+void benchmarkHistoryOverlay(size_t events)
+{
+  // The benchmark builds and deletes its own overlay through history_menu
+  if (history_menu)
+  {
+    printf("[History] Close the history overlay before running the benchmark\n");
+    return;
+  }
+
+  LifeHistoryRing *p1 = new LifeHistoryRing(events);
+  LifeHistoryRing *p2 = new LifeHistoryRing(events);
+  int life1 = 40, life2 = 40;
+  for (size_t i = 0; i < events; ++i)
+  {
+    LifeHistoryEvent evt = {};
+    evt.net_life_change = (int)(i % 7) - 3;
+    if (evt.net_life_change == 0)
+      evt.net_life_change = 1;
+    life1 += evt.net_life_change;
+    evt.life_total = life1;
+    evt.player_id = 1;
+    evt.timestamp = millis();
+    p1->push(evt);
+    evt.net_life_change = -evt.net_life_change;
+    life2 += evt.net_life_change;
+    evt.life_total = life2;
+    evt.player_id = 2;
+    p2->push(evt);
+  }
+
+  for (int columns = 1; columns <= 2; ++columns)
+  {
+    uint32_t start_us = micros();
+    createHistoryOverlay(p1, columns == 2 ? p2 : nullptr);
+    lv_refr_now(NULL);
+    uint32_t open_us = micros() - start_us;
+    uint32_t formatted_open = view.rows_formatted;
+
+    start_us = micros();
+    lv_obj_scroll_to_y(view.list, LV_COORD_MAX, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    uint32_t end_us = micros() - start_us;
+
+    printf("[History] %u events, %d column(s): open %lu us (%lu rows formatted), jump to end %lu us\n",
+           (unsigned)events, columns, (unsigned long)open_us, (unsigned long)formatted_open,
+           (unsigned long)end_us);
+    teardownHistoryOverlay();
+  }
+
+  delete p1;
+  delete p2;
+}
@@ -1,10 +1,26 @@
 #pragma once
 
+#include <stddef.h>
+
+/// Height of one history row, the header row uses the same
+#ifndef HISTORY_ROW_HEIGHT
+#define HISTORY_ROW_HEIGHT 32
+#endif
+
+/// How often an open overlay checks for newly committed events
+#ifndef HISTORY_POLL_MS
+#define HISTORY_POLL_MS 250
+#endif
+
 /**
  * @brief Display the game history overlay screen
  * 
  * Creates and shows a modal overlay containing the complete
- * game history with all life changes and timestamps.
+ * game history with all life changes and timestamps. Only the
+ * visible rows exist as LVGL objects; they are recycled and
+ * formatted as they scroll into view, so opening does not depend
+ * on the length of the history. Events committed while the overlay
+ * is open are appended (and followed when scrolled to the end).
  */
 void renderHistoryOverlay();
 
@@ -15,3 +31,13 @@ void renderHistoryOverlay();
  * associated LVGL objects and memory.
  */
 void teardownHistoryOverlay();
+
+/**
+ * @brief Time opening the overlay on a synthetic history
+ * 
+ * Fills temporary rings with the given number of events per player,
+ * opens and scrolls the overlay in 1P and 2P layout and prints the
+ * timings. Runs on the UI task (serial console command "histbench").
+ * Does nothing while the history overlay is open.
+ */
+void benchmarkHistoryOverlay(size_t events);
@@ -0,0 +1,548 @@
+// ============================================
+// Own Header (first!)
+// ============================================
+#include "life_journal.h"
+
+// ============================================
+// System & Framework Headers
+// ============================================
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include <Arduino.h>
+#include <esp_partition.h>
+#include <freertos/FreeRTOS.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+// ============================================
+// Core System
+// ============================================
+#ifdef ESP_PLATFORM
+#include "core/persistence.h"
+#endif
+
+
+static_assert(sizeof(life_journal_record_t) == 16, "journal records must be 16 bytes");
+
+#define RECORDS_PER_SECTOR  (LIFE_JOURNAL_SECTOR_SIZE / sizeof(life_journal_record_t))
+#define SEQ_ERASED          0xFFFFFFFFu
+
+static const uint8_t *journal_map = nullptr;  // read-only view of the partition
+static size_t journal_size = 0;
+static size_t journal_sectors = 0;
+static size_t journal_slots = 0;
+static size_t write_slot = 0;                 // next record slot to program
+static size_t append_slot = 0;                // slot the next queued record lands in
+static uint32_t next_seq = 1;
+static uint32_t last_game_seq = 0;            // seq of the latest GAME_START / CHECKPOINT, 0 = none
+static size_t last_game_slot = 0;             // ... and its slot
+static uint8_t game_mode = 0;                 // current game, for checkpoints
+static int16_t game_life[2] = {};
+static life_journal_stats_t journal_stats = {};
+
+// Records queued by the UI, written by life_journal_flush()
+static life_journal_record_t pending[LIFE_JOURNAL_PENDING];
+static size_t pending_count = 0;
+
+// ============================================
+// Backend: esp_partition on the device, a file on the host
+// ============================================
+#ifdef ESP_PLATFORM
+
+static const esp_partition_t *journal_part = nullptr;
+static esp_partition_mmap_handle_t journal_mmap_handle;
+static portMUX_TYPE journal_mux = portMUX_INITIALIZER_UNLOCKED;
+#define JOURNAL_LOCK()    portENTER_CRITICAL(&journal_mux)
+#define JOURNAL_UNLOCK()  portEXIT_CRITICAL(&journal_mux)
+
+static uint32_t journal_micros() { return micros(); }
+
+static bool backend_open()
+{
+  journal_part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                          (esp_partition_subtype_t)LIFE_JOURNAL_SUBTYPE,
+                                          LIFE_JOURNAL_PARTITION);
+  if (!journal_part)
+    return false;
+  const void *ptr = nullptr;
+  if (esp_partition_mmap(journal_part, 0, journal_part->size, ESP_PARTITION_MMAP_DATA,
+                         &ptr, &journal_mmap_handle) != ESP_OK)
+    return false;
+  journal_map = (const uint8_t *)ptr;
+  journal_size = journal_part->size;
+  return true;
+}
+
+static bool backend_write(size_t offset, const void *data, size_t len)
+{
+  return esp_partition_write(journal_part, offset, data, len) == ESP_OK;
+}
+
+static bool backend_erase_sector(size_t offset)
+{
+  return esp_partition_erase_range(journal_part, offset, LIFE_JOURNAL_SECTOR_SIZE) == ESP_OK;
+}
+
+static void backend_close()
+{
+  esp_partition_munmap(journal_mmap_handle);
+  journal_part = nullptr;
+}
+
+#else
+
+// Single threaded on the host
+#define JOURNAL_LOCK()
+#define JOURNAL_UNLOCK()
+
+static uint8_t *host_map = nullptr;
+
+static uint32_t journal_micros()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000ull + ts.tv_nsec / 1000);
+}
+
+static bool backend_open()
+{
+  int fd = open(LIFE_JOURNAL_HOST_FILE, O_RDWR | O_CREAT, 0644);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  fstat(fd, &st);
+  size_t size = (size_t)st.st_size;
+  bool fresh = size == 0;
+  if (fresh)
+  {
+    size = LIFE_JOURNAL_HOST_SIZE;
+    if (ftruncate(fd, size) != 0)
+    {
+      close(fd);
+      return false;
+    }
+  }
+  void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED)
+    return false;
+  host_map = (uint8_t *)ptr;
+  if (fresh)
+    memset(host_map, 0xFF, size);  // erased flash
+  journal_map = host_map;
+  journal_size = size;
+  return true;
+}
+
+// NOR flash semantics: programming can only clear bits
+static bool backend_write(size_t offset, const void *data, size_t len)
+{
+  const uint8_t *src = (const uint8_t *)data;
+  for (size_t i = 0; i < len; i++)
+    host_map[offset + i] &= src[i];
+  return true;
+}
+
+static bool backend_erase_sector(size_t offset)
+{
+  memset(host_map + offset, 0xFF, LIFE_JOURNAL_SECTOR_SIZE);
+  return true;
+}
+
+static void backend_close()
+{
+  munmap(host_map, journal_size);
+  host_map = nullptr;
+}
+
+#endif
+
+// ============================================
+// Records
+// ============================================
+static uint32_t journal_crc32(const uint8_t *data, size_t len)
+{
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < len; i++)
+  {
+    crc ^= data[i];
+    for (int b = 0; b < 8; b++)
+      crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+  }
+  return ~crc;
+}
+
+static bool record_valid(const life_journal_record_t *rec)
+{
+  return rec->seq != SEQ_ERASED &&
+         rec->crc == journal_crc32((const uint8_t *)rec, offsetof(life_journal_record_t, crc));
+}
+
+static const life_journal_record_t *record_at(size_t slot)
+{
+  return (const life_journal_record_t *)(journal_map + slot * sizeof(life_journal_record_t));
+}
+
+static void record_to_event(const life_journal_record_t *rec, LifeHistoryEvent *evt)
+{
+  evt->net_life_change = rec->net_change;
+  evt->life_total = rec->life_total;
+  evt->player_id = rec->player_id;
+  evt->timestamp = 0;  // millis() of another boot is meaningless
+  evt->change_timestamp = rec->game_seconds;
+}
+
+static bool starts_game(const life_journal_record_t *rec)
+{
+  return rec->type == JOURNAL_GAME_START || rec->type == JOURNAL_CHECKPOINT;
+}
+
+// Follow the current game's life totals, a checkpoint has to repeat them
+static void track_game(const life_journal_record_t *rec, size_t slot)
+{
+  if (starts_game(rec))
+  {
+    last_game_seq = rec->seq;
+    last_game_slot = slot;
+    game_mode = rec->player_id;
+    game_life[0] = rec->life_total;
+    game_life[1] = rec->net_change;
+  }
+  else if (rec->type == JOURNAL_EVENT)
+  {
+    game_life[rec->player_id == 2 ? 1 : 0] = rec->life_total;  // PLAYER_TWO
+  }
+}
+
+// The next record opens the sector holding the game's start, which the flush
+// erases before writing into it
+static bool needs_checkpoint()
+{
+  return last_game_seq != 0 && append_slot % RECORDS_PER_SECTOR == 0 &&
+         append_slot / RECORDS_PER_SECTOR == last_game_slot / RECORDS_PER_SECTOR;
+}
+
+// Caller holds the lock and has checked there is room
+static void push_record(life_journal_record_t rec)
+{
+  rec.seq = next_seq++;
+  rec.crc = journal_crc32((const uint8_t *)&rec, offsetof(life_journal_record_t, crc));
+  track_game(&rec, append_slot);
+  pending[pending_count++] = rec;
+  append_slot = (append_slot + 1) % journal_slots;
+}
+
+static void queue_record(life_journal_record_t rec)
+{
+  JOURNAL_LOCK();
+  bool checkpoint = rec.type != JOURNAL_GAME_START && needs_checkpoint();
+  if (pending_count + (checkpoint ? 2 : 1) > LIFE_JOURNAL_PENDING)
+  {
+    journal_stats.dropped++;
+    JOURNAL_UNLOCK();
+    return;
+  }
+  if (checkpoint)
+  {
+    life_journal_record_t cp = {};
+    cp.type = JOURNAL_CHECKPOINT;
+    cp.player_id = game_mode;
+    cp.life_total = game_life[0];
+    cp.net_change = game_life[1];
+    push_record(cp);
+    journal_stats.checkpoints++;
+  }
+  push_record(rec);
+  journal_stats.appended++;
+  JOURNAL_UNLOCK();
+
+#ifdef ESP_PLATFORM
+  persistence_kick();
+#endif
+}
+
+static int16_t clamp_i16(int value)
+{
+  return (int16_t)(value < INT16_MIN ? INT16_MIN : (value > INT16_MAX ? INT16_MAX : value));
+}
+
+// ============================================
+// Public API
+// ============================================
+bool life_journal_init(void)
+{
+  uint32_t start_us = journal_micros();
+  if (!backend_open())
+  {
+    printf("[Journal] Partition '%s' not found, history will not survive a reboot\n", LIFE_JOURNAL_PARTITION);
+    return false;
+  }
+  journal_sectors = journal_size / LIFE_JOURNAL_SECTOR_SIZE;
+  journal_slots = journal_sectors * RECORDS_PER_SECTOR;
+  size_t slots = journal_slots;
+
+  // Find the newest record; records only ever go forward around the ring
+  uint32_t newest_seq = 0;
+  size_t newest_slot = slots - 1;
+  size_t game_slot = 0;
+  for (size_t slot = 0; slot < slots; slot++)
+  {
+    const life_journal_record_t *rec = record_at(slot);
+    if (!record_valid(rec))
+      continue;
+    journal_stats.records++;
+    if (rec->seq > newest_seq)
+    {
+      newest_seq = rec->seq;
+      newest_slot = slot;
+    }
+    if (starts_game(rec) && rec->seq > last_game_seq)
+    {
+      last_game_seq = rec->seq;
+      game_slot = slot;
+    }
+  }
+
+  // Replay the current game up to the newest record for the checkpoint totals
+  if (last_game_seq != 0)
+  {
+    for (size_t slot = game_slot;; slot = (slot + 1) % slots)
+    {
+      const life_journal_record_t *rec = record_at(slot);
+      if (record_valid(rec) && rec->seq >= last_game_seq)
+        track_game(rec, slot);
+      if (slot == newest_slot)
+        break;
+    }
+  }
+  else if (journal_stats.records > 0)
+  {
+    printf("[Journal] No game start left in %lu records, nothing to restore\n",
+           (unsigned long)journal_stats.records);
+  }
+
+  next_seq = newest_seq + 1;
+  write_slot = (newest_slot + 1) % slots;
+
+  // A torn write can leave the rest of the sector partly programmed, continue
+  // on the next sector then (it is erased when the flush enters it)
+  const life_journal_record_t *slot_rec = record_at(write_slot);
+  if (write_slot % RECORDS_PER_SECTOR != 0 &&
+      (slot_rec->seq != SEQ_ERASED || slot_rec->crc != 0xFFFFFFFFu))
+  {
+    size_t next_sector = (write_slot / RECORDS_PER_SECTOR + 1) % journal_sectors;
+    write_slot = next_sector * RECORDS_PER_SECTOR;
+  }
+  append_slot = write_slot;
+
+  journal_stats.scan_us = journal_micros() - start_us;
+  printf("[Journal] %u KB, %lu records, next seq %lu, scan %lu us\n",
+         (unsigned)(journal_size / 1024), (unsigned long)journal_stats.records,
+         (unsigned long)next_seq, (unsigned long)journal_stats.scan_us);
+
+#ifdef ESP_PLATFORM
+  persistence_register_flush_hook(life_journal_flush);
+#endif
+  return true;
+}
+
+void life_journal_append(const LifeHistoryEvent &evt)
+{
+  if (!journal_map)
+    return;
+  life_journal_record_t rec = {};
+  rec.type = JOURNAL_EVENT;
+  rec.player_id = (uint8_t)evt.player_id;
+  rec.net_change = clamp_i16(evt.net_life_change);
+  rec.life_total = clamp_i16(evt.life_total);
+  rec.game_seconds = (uint16_t)(evt.change_timestamp < 0 ? 0 : (evt.change_timestamp > 0xFFFF ? 0xFFFF : evt.change_timestamp));
+  queue_record(rec);
+}
+
+void life_journal_start_game(PlayerMode mode, int start_life, int start_life_p2)
+{
+  if (!journal_map)
+    return;
+  life_journal_record_t rec = {};
+  rec.type = JOURNAL_GAME_START;
+  rec.player_id = (uint8_t)mode;
+  rec.life_total = clamp_i16(start_life);
+  rec.net_change = clamp_i16(start_life_p2 < 0 ? start_life : start_life_p2);
+  queue_record(rec);
+}
+
+struct RestoreState
+{
+  PlayerMode mode;
+  uint32_t game_seq;
+  uint32_t last_seq;       // newest record replayed, a concurrent flush may show a record twice
+  bool found;
+  bool other_mode;
+  life_journal_game_t *game;
+  life_journal_event_cb_t cb;
+  void *ctx;
+};
+
+static void replay_record(const life_journal_record_t *rec, RestoreState *state)
+{
+  if (rec->seq < state->game_seq || (state->found && rec->seq <= state->last_seq))
+    return;
+  state->last_seq = rec->seq;
+  if (rec->seq == state->game_seq)
+  {
+    state->other_mode = rec->player_id != (uint8_t)state->mode;
+    state->game->start_life = rec->life_total;
+    state->game->start_life_p2 = rec->net_change;
+    state->game->from_checkpoint = rec->type == JOURNAL_CHECKPOINT;
+    state->found = true;
+  }
+  else if (state->found && rec->type == JOURNAL_EVENT)
+  {
+    LifeHistoryEvent evt;
+    record_to_event(rec, &evt);
+    state->game->events++;
+    if (state->cb && !state->other_mode)
+      state->cb(evt, state->ctx);
+  }
+}
+
+bool life_journal_restore(PlayerMode mode, life_journal_game_t *game, life_journal_event_cb_t cb, void *ctx)
+{
+  if (!journal_map || last_game_seq == 0)
+    return false;
+
+  // Snapshot the queue so records not flushed yet are replayed as well
+  life_journal_record_t queued[LIFE_JOURNAL_PENDING];
+  JOURNAL_LOCK();
+  size_t queued_count = pending_count;
+  memcpy(queued, pending, queued_count * sizeof(life_journal_record_t));
+  uint32_t game_seq = last_game_seq;
+  size_t slot = write_slot;
+  JOURNAL_UNLOCK();
+
+  game->start_life = 0;
+  game->start_life_p2 = 0;
+  game->events = 0;
+  game->from_checkpoint = false;
+  RestoreState state = { mode, game_seq, 0, false, false, game, cb, ctx };
+
+  // Check the mode before handing out any event
+  for (size_t i = 0; i < queued_count; i++)
+  {
+    if (queued[i].seq == game_seq && queued[i].player_id != (uint8_t)mode)
+      return false;
+  }
+
+  // Flash from the oldest slot (the write position) round to the newest, then the queue
+  size_t slots = journal_slots;
+  for (size_t n = 0; n < slots && !state.other_mode; n++)
+  {
+    const life_journal_record_t *rec = record_at((slot + n) % slots);
+    if (record_valid(rec))
+      replay_record(rec, &state);
+  }
+  for (size_t i = 0; i < queued_count && !state.other_mode; i++)
+    replay_record(&queued[i], &state);
+
+  if (!state.found)
+    printf("[Journal] Start of the latest game (seq %lu) is gone, not restoring\n", (unsigned long)game_seq);
+  return state.found && !state.other_mode;
+}
+
+void life_journal_flush(void)
+{
+  if (!journal_map)
+    return;
+
+  life_journal_record_t batch[LIFE_JOURNAL_PENDING];
+  JOURNAL_LOCK();
+  size_t count = pending_count;
+  memcpy(batch, pending, count * sizeof(life_journal_record_t));
+  pending_count = 0;
+  JOURNAL_UNLOCK();
+  if (count == 0)
+    return;
+
+  uint32_t start_us = journal_micros();
+  size_t slots = journal_slots;
+  for (size_t i = 0; i < count; i++)
+  {
+    // Entering a new sector: erase it, it holds the oldest records
+    if (write_slot % RECORDS_PER_SECTOR == 0 && record_at(write_slot)->seq != SEQ_ERASED)
+    {
+      backend_erase_sector(write_slot * sizeof(life_journal_record_t));
+      journal_stats.sectors_erased++;
+    }
+    else if (write_slot % RECORDS_PER_SECTOR == 0)
+    {
+      // Erased already, but make sure no stray bits are left
+      const uint32_t *words = (const uint32_t *)(journal_map + write_slot * sizeof(life_journal_record_t));
+      for (size_t w = 0; w < LIFE_JOURNAL_SECTOR_SIZE / 4; w++)
+      {
+        if (words[w] != 0xFFFFFFFFu)
+        {
+          backend_erase_sector(write_slot * sizeof(life_journal_record_t));
+          journal_stats.sectors_erased++;
+          break;
+        }
+      }
+    }
+    if (!backend_write(write_slot * sizeof(life_journal_record_t), &batch[i], sizeof(life_journal_record_t)))
+    {
+      printf("[Journal] Write failed at slot %u\n", (unsigned)write_slot);
+    }
+    else
+    {
+      journal_stats.written++;
+      journal_stats.records++;
+    }
+    write_slot = (write_slot + 1) % slots;
+  }
+  journal_stats.last_flush_us = journal_micros() - start_us;
+}
+
+void life_journal_deinit(void)
+{
+  if (!journal_map)
+    return;
+  backend_close();
+  journal_map = nullptr;
+  journal_size = 0;
+  journal_sectors = 0;
+  journal_slots = 0;
+  write_slot = 0;
+  append_slot = 0;
+  next_seq = 1;
+  last_game_seq = 0;
+  last_game_slot = 0;
+  game_mode = 0;
+  game_life[0] = game_life[1] = 0;
+  pending_count = 0;
+  journal_stats = {};
+}
+
+void life_journal_get_stats(life_journal_stats_t *stats)
+{
+  JOURNAL_LOCK();
+  *stats = journal_stats;
+  JOURNAL_UNLOCK();
+}
+
+void life_journal_print_stats(void)
+{
+  life_journal_stats_t s;
+  life_journal_get_stats(&s);
+  printf("[Journal] records=%lu appended=%lu written=%lu dropped=%lu erased=%lu checkpoints=%lu\n",
+         (unsigned long)s.records, (unsigned long)s.appended, (unsigned long)s.written,
+         (unsigned long)s.dropped, (unsigned long)s.sectors_erased, (unsigned long)s.checkpoints);
+  printf("[Journal] boot scan %lu us, last flush %lu us, write slot %u of %u\n",
+         (unsigned long)s.scan_us, (unsigned long)s.last_flush_us, (unsigned)write_slot,
+         (unsigned)journal_slots);
+}
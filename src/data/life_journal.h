@@ -0,0 +1,127 @@
+#pragma once
+
+// ============================================
+// Life history journal
+// ============================================
+// Append-only log of committed life changes in its own flash partition (see
+// default_16MB.csv), so a game including its history survives a reboot.
+// Records are 16 bytes with a CRC and are written sequentially around the
+// partition, erasing one sector ahead of the write position, so wear is
+// spread over every sector. Reading goes through a memory mapping: restoring
+// a game is one scan over mapped flash.
+//
+// Appends only queue the record in RAM; the persistence worker writes them
+// (life_journal_flush is registered as its flush hook). On a host build
+// (no ESP_PLATFORM) the partition is a plain file, see LIFE_JOURNAL_HOST_FILE;
+// nothing here includes Arduino or LVGL so the native tests build it.
+//
+// When the ring comes round to the sector holding the start of the current
+// game, a checkpoint with the current life totals is written first, so a
+// restore still finds the game; only the history before the checkpoint is lost.
+
+#include <stdint.h>
+#include <stddef.h>
+#include "data/player_mode.h"
+#include "ui/helpers/history_ring.h"
+
+#define LIFE_JOURNAL_PARTITION      "journal"
+#define LIFE_JOURNAL_SUBTYPE        0x40      // custom data subtype
+#define LIFE_JOURNAL_SECTOR_SIZE    4096
+#define LIFE_JOURNAL_PENDING        32        // records queued between flushes
+
+// Host stand-in for the partition, size used when the file is created
+#ifndef LIFE_JOURNAL_HOST_FILE
+#define LIFE_JOURNAL_HOST_FILE      "life_journal.bin"
+#endif
+#define LIFE_JOURNAL_HOST_SIZE      (64 * LIFE_JOURNAL_SECTOR_SIZE)
+
+enum life_journal_type_t : uint8_t
+{
+  JOURNAL_EVENT = 1,       ///< one committed LifeHistoryEvent
+  JOURNAL_GAME_START = 2,  ///< new game: player_id holds the PlayerMode, life_total / net_change
+                           ///< the starting life of player 1 (or single) / player 2
+  JOURNAL_CHECKPOINT = 3,  ///< same layout as GAME_START with the life totals at that point,
+                           ///< written when the ring is about to erase the game's start
+};
+
+/**
+ * @brief One journal record, exactly 16 bytes in flash
+ */
+struct __attribute__((packed)) life_journal_record_t
+{
+  uint32_t seq;            ///< increasing sequence number, 0xFFFFFFFF = erased slot
+  uint8_t type;            ///< life_journal_type_t
+  uint8_t player_id;
+  int16_t net_change;
+  int16_t life_total;
+  uint16_t game_seconds;   ///< change_timestamp, saturated
+  uint32_t crc;            ///< CRC32 of the first 12 bytes
+};
+
+struct life_journal_stats_t
+{
+  uint32_t records;        ///< valid records found at boot plus written since
+  uint32_t appended;
+  uint32_t written;
+  uint32_t dropped;        ///< pending queue was full
+  uint32_t sectors_erased;
+  uint32_t checkpoints;
+  uint32_t scan_us;        ///< boot scan
+  uint32_t last_flush_us;
+};
+
+/**
+ * @brief Game found by life_journal_restore()
+ */
+struct life_journal_game_t
+{
+  int start_life;      ///< single player or player 1
+  int start_life_p2;
+  uint32_t events;
+  bool from_checkpoint; ///< older history was overwritten, start_life are the totals at the checkpoint
+};
+
+typedef void (*life_journal_event_cb_t)(const LifeHistoryEvent &evt, void *ctx);
+
+/**
+ * @brief Map the partition and find the write position, call once at boot
+ * @return false if the partition is missing, appends are then dropped
+ */
+bool life_journal_init(void);
+
+/**
+ * @brief Queue a committed life change, never blocks on flash
+ */
+void life_journal_append(const LifeHistoryEvent &evt);
+
+/**
+ * @brief Queue the start of a new game, later restores begin here
+ * @param mode Player mode of the game
+ * @param start_life Starting life of the single player or player 1
+ * @param start_life_p2 Starting life of player 2, -1 for the same as player 1
+ */
+void life_journal_start_game(PlayerMode mode, int start_life, int start_life_p2 = -1);
+
+/**
+ * @brief Replay the latest game, including records not flushed yet
+ * @param mode Only restore if the latest game was played in this mode
+ * @param game Filled with the starting life and event count
+ * @param cb Called for every event of the game, oldest first
+ * @return false if there is no game of this mode to restore
+ */
+bool life_journal_restore(PlayerMode mode, life_journal_game_t *game, life_journal_event_cb_t cb, void *ctx);
+
+/**
+ * @brief Write queued records to flash (persistence worker / shutdown)
+ */
+void life_journal_flush(void);
+
+/**
+ * @brief Unmap the partition and forget all state, queued records are lost
+ *
+ * The host tests use it with life_journal_init() to simulate a reboot.
+ */
+void life_journal_deinit(void);
+
+void life_journal_get_stats(life_journal_stats_t *stats);
+void life_journal_print_stats(void);
@@ -0,0 +1,10 @@
+#pragma once
+
+// Kept apart from constants.h (which pulls in LVGL) so host-built modules
+// such as the life journal can use it
+
+enum PlayerMode
+{
+  PLAYER_MODE_ONE_PLAYER = 0,
+  PLAYER_MODE_TWO_PLAYER = 1
+};
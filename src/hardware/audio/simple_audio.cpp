@@ -117,9 +117,45 @@ void simple_audio_beep(int frequency, int duration_ms) {
     }
 }
 
+// Sounds play on their own task so the caller (usually the UI task) never
+// blocks for the length of the beeps
+#define AUDIO_TASK_CORE        1
+#define AUDIO_TASK_STACK_SIZE  4096
+#define AUDIO_QUEUE_LENGTH     4
+
+static QueueHandle_t audio_queue = NULL;
+
+static void play_sound_blocking(sound_type_t sound);
+
+static void audio_task(void *arg) {
+    sound_type_t sound;
+    for (;;) {
+        if (xQueueReceive(audio_queue, &sound, portMAX_DELAY) == pdTRUE) {
+            play_sound_blocking(sound);
+        }
+    }
+}
+
 void simple_audio_play_sound(sound_type_t sound) {
     if (sound >= SOUND_COUNT) return;
     
+    if (!audio_queue) {
+        audio_queue = xQueueCreate(AUDIO_QUEUE_LENGTH, sizeof(sound_type_t));
+        if (audio_queue && xTaskCreatePinnedToCore(audio_task, "audio", AUDIO_TASK_STACK_SIZE, NULL,
+                                                   2, NULL, AUDIO_TASK_CORE) != pdPASS) {
+            vQueueDelete(audio_queue);
+            audio_queue = NULL;
+        }
+    }
+    
+    if (!audio_queue) {
+        play_sound_blocking(sound);
+    } else if (xQueueSend(audio_queue, &sound, 0) != pdTRUE) {
+        printf("[Audio] Sound queue full, sound dropped\n");
+    }
+}
+
+static void play_sound_blocking(sound_type_t sound) {
     const sound_def_t *sound_def = &sounds[sound];
     
     for (int i = 0; i < sound_def->repeat_count; i++) {
@@ -26,7 +26,7 @@ typedef enum {
 // Simple audio functions
 void simple_audio_init();
 void simple_audio_beep(int frequency, int duration_ms);
-void simple_audio_play_sound(sound_type_t sound);
+void simple_audio_play_sound(sound_type_t sound);   // queued, plays on the audio task
 void simple_audio_set_volume(int volume);
 int simple_audio_get_volume();
 void simple_audio_set_enabled(bool enabled);
@@ -8,6 +8,8 @@
 #include "esp_lcd_st77916.h"
 #include "esp_lcd_panel_io_interface.h"
 #include "esp_lcd_panel_ops.h"
+#include "esp_timer.h"
+#include "round_mask.h"
 
 
 #define LCD_OPCODE_WRITE_CMD        (0x02ULL)
@@ -231,31 +233,203 @@ void LCD_Init() {
   gpio_set_level((gpio_num_t)LCD_PIN_RST, 1);
 #endif
   
+  // Touch_Init() is independent of the panel and runs in the boot bring-up
   ST77916_Init();
-  Touch_Init();
 }
 
 
-static void test_draw_bitmap(esp_lcd_panel_handle_t panel_handle)
+esp_lcd_panel_handle_t panel_handle = NULL;
+static esp_lcd_panel_io_handle_t lcd_io_handle = NULL;
+
+// Color transfers queued but not yet completed by DMA. The flush (UI task, core 0)
+// and the SPI ISR (core 1) both update the counter and the notify ring, so every
+// read-modify-write of them holds lcd_trans_lock.
+static portMUX_TYPE lcd_trans_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint32_t lcd_trans_pending = 0;
+static LCD_TransDoneCallback lcd_trans_done_cb = NULL;
+static void *lcd_trans_done_ctx = NULL;
+
+// Completions arrive in queue order; remember which transfers report to the
+// trans-done callback (LCD_addWindow) and which are driver internal (LCD_Fill)
+#define LCD_TRANS_RING_SIZE 16
+static volatile bool lcd_trans_notify[LCD_TRANS_RING_SIZE];
+static volatile uint8_t lcd_trans_head = 0;
+static volatile uint8_t lcd_trans_tail = 0;
+
+// Reusable DMA line buffer for solid fills, holds fill_color in panel byte order
+static uint16_t *fill_buf = NULL;
+static uint16_t fill_color = 0;
+static bool fill_buf_valid = false;     // fill_buf holds fill_color
+
+// TE sync state, counters are written from the TE and SPI ISRs
+static bool te_sync_enabled = false;
+static SemaphoreHandle_t te_vsync_sem = NULL;
+static volatile uint32_t te_vsync_count = 0;
+static volatile bool te_frame_end_pending = false;
+static uint32_t te_frame_vsync = 0;
+static LCD_TEStats_t te_stats = {};
+
+// Runs from the SPI ISR and from LCD_EndFrame(), caller holds lcd_trans_lock
+static void IRAM_ATTR lcd_check_frame_end()
 {
-  uint16_t row_line = ((EXAMPLE_LCD_WIDTH / EXAMPLE_LCD_COLOR_BITS) << 1) >> 1;
-  uint8_t byte_per_pixel = EXAMPLE_LCD_COLOR_BITS / 8;
-  uint8_t *color = (uint8_t *)heap_caps_calloc(1, row_line * EXAMPLE_LCD_HEIGHT * byte_per_pixel, MALLOC_CAP_DMA);
-
-
-  for (int j = 0; j < EXAMPLE_LCD_COLOR_BITS; j++) {
-      for (int i = 0; i < row_line * EXAMPLE_LCD_HEIGHT; i++) {
-          for (int k = 0; k < byte_per_pixel; k++) {
-              color[i * byte_per_pixel + k] = (SPI_SWAP_DATA_TX(BIT(j), EXAMPLE_LCD_COLOR_BITS) >> (k * 8)) & 0xff;
-          }
-      }
-      esp_lcd_panel_draw_bitmap(panel_handle, 0, j * row_line, EXAMPLE_LCD_HEIGHT, (j + 1) * row_line, color);
+  if (te_frame_end_pending && lcd_trans_pending == 0) {
+    te_frame_end_pending = false;
+    // Another TE pulse came while the frame was still going out
+    if (te_sync_enabled && te_vsync_count != te_frame_vsync)
+      te_stats.late_frames++;
   }
-  free(color);
 }
 
+// Fires once per esp_lcd_panel_draw_bitmap(), after its last color chunk went out
+static bool IRAM_ATTR lcd_color_trans_done(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
+{
+  bool notify = false;
+  taskENTER_CRITICAL_ISR(&lcd_trans_lock);
+  if (lcd_trans_pending > 0) {
+    lcd_trans_pending = lcd_trans_pending - 1;
+    notify = lcd_trans_notify[lcd_trans_tail];
+    lcd_trans_tail = (lcd_trans_tail + 1) % LCD_TRANS_RING_SIZE;
+  }
+  lcd_check_frame_end();
+  taskEXIT_CRITICAL_ISR(&lcd_trans_lock);
+  if (notify && lcd_trans_done_cb)
+    return lcd_trans_done_cb(lcd_trans_done_ctx);
+  return false;
+}
 
-esp_lcd_panel_handle_t panel_handle = NULL;
+// esp_lcd drains the previous color transfer before sending the next window,
+// so at most a couple of entries are ever in the ring
+static bool lcd_draw_bitmap_async(int x_start, int y_start, int x_end, int y_end, const void *color, bool notify)
+{
+  // Reserve the slot before queuing, the completion can fire before draw_bitmap returns
+  taskENTER_CRITICAL(&lcd_trans_lock);
+  uint8_t slot = lcd_trans_head;
+  lcd_trans_notify[slot] = notify;
+  lcd_trans_head = (slot + 1) % LCD_TRANS_RING_SIZE;
+  lcd_trans_pending = lcd_trans_pending + 1;
+  taskEXIT_CRITICAL(&lcd_trans_lock);
+
+  if (esp_lcd_panel_draw_bitmap(panel_handle, x_start, y_start, x_end, y_end, color) != ESP_OK) {
+    // Nothing was queued, so no completion will arrive for this one. Transfers are
+    // queued from one task at a time and completions only move the tail, so the
+    // slot is still the newest one.
+    taskENTER_CRITICAL(&lcd_trans_lock);
+    lcd_trans_head = slot;
+    lcd_trans_pending = lcd_trans_pending - 1;
+    taskEXIT_CRITICAL(&lcd_trans_lock);
+    return false;
+  }
+  return true;
+}
+
+void LCD_SetTransDoneCallback(LCD_TransDoneCallback callback, void *user_ctx)
+{
+  lcd_trans_done_ctx = user_ctx;
+  lcd_trans_done_cb = callback;
+}
+
+void LCD_WaitTransDone()
+{
+  while (lcd_trans_pending > 0) {
+    vTaskDelay(1);
+  }
+}
+
+
+static void IRAM_ATTR lcd_te_isr()
+{
+  BaseType_t woken = pdFALSE;
+  te_vsync_count = te_vsync_count + 1;
+  xSemaphoreGiveFromISR(te_vsync_sem, &woken);
+  if (woken == pdTRUE)
+    portYIELD_FROM_ISR();
+}
+
+static void lcd_tx_cmd(uint8_t cmd, const uint8_t *param, size_t param_size)
+{
+  int lcd_cmd = (LCD_OPCODE_WRITE_CMD << 24) | ((uint32_t)cmd << 8);
+  esp_lcd_panel_io_tx_param(lcd_io_handle, lcd_cmd, param, param_size);
+}
+
+// Must be called from the LVGL thread (it issues panel commands between flushes)
+void LCD_SetTESync(bool enable)
+{
+  if (!lcd_io_handle || enable == te_sync_enabled)
+    return;
+
+  if (!te_vsync_sem)
+    te_vsync_sem = xSemaphoreCreateBinary();
+
+  if (enable) {
+    const uint8_t te_mode = 0x00;                 // TE on V-blank only
+    lcd_tx_cmd(0x35, &te_mode, 1);                // TEON
+    pinMode(ESP_PANEL_LCD_SPI_IO_TE, INPUT);
+    attachInterrupt(ESP_PANEL_LCD_SPI_IO_TE, lcd_te_isr, RISING);
+  } else {
+    detachInterrupt(ESP_PANEL_LCD_SPI_IO_TE);
+    lcd_tx_cmd(0x34, NULL, 0);                    // TEOFF
+  }
+  te_sync_enabled = enable;
+  printf("[LCD] TE sync %s\n", enable ? "enabled" : "disabled");
+}
+
+bool LCD_GetTESync()
+{
+  return te_sync_enabled;
+}
+
+void LCD_BeginFrame()
+{
+  if (te_sync_enabled) {
+    uint64_t start = esp_timer_get_time();
+    // Drop a pulse that arrived while the frame was rendering, start on a fresh one
+    xSemaphoreTake(te_vsync_sem, 0);
+    if (xSemaphoreTake(te_vsync_sem, pdMS_TO_TICKS(LCD_TE_TIMEOUT_MS)) == pdTRUE) {
+      uint32_t waited = (uint32_t)(esp_timer_get_time() - start);
+      te_stats.frames++;
+      te_stats.total_wait_us += waited;
+      if (waited > te_stats.max_wait_us)
+        te_stats.max_wait_us = waited;
+    } else {
+      te_stats.missed_frames++;
+    }
+  }
+  te_frame_vsync = te_vsync_count;
+}
+
+void LCD_EndFrame()
+{
+  // The last transfer may already be done if it completed before EndFrame
+  taskENTER_CRITICAL(&lcd_trans_lock);
+  te_frame_end_pending = true;
+  lcd_check_frame_end();
+  taskEXIT_CRITICAL(&lcd_trans_lock);
+}
+
+void LCD_GetTEStats(LCD_TEStats_t *stats)
+{
+  *stats = te_stats;
+  stats->vsync_count = te_vsync_count;
+}
+
+void LCD_ResetTEStats()
+{
+  te_stats = {};
+  te_vsync_count = 0;
+  te_frame_vsync = 0;
+}
+
+void LCD_PrintTEStats()
+{
+  LCD_TEStats_t stats;
+  LCD_GetTEStats(&stats);
+  printf("[LCD] TE sync %s: vsync=%lu frames=%lu missed=%lu late=%lu wait avg=%luus max=%luus\n",
+         te_sync_enabled ? "on" : "off",
+         (unsigned long)stats.vsync_count, (unsigned long)stats.frames,
+         (unsigned long)stats.missed_frames, (unsigned long)stats.late_frames,
+         (unsigned long)(stats.frames ? stats.total_wait_us / stats.frames : 0),
+         (unsigned long)stats.max_wait_us);
+}
 
 
 int QSPI_Init(void){
@@ -332,10 +506,12 @@ int QSPI_Init(void){
   } 
   
   io_config.pclk_hz = ESP_PANEL_LCD_SPI_CLK_HZ;
+  io_config.on_color_trans_done = lcd_color_trans_done;
   if(esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)ESP_PANEL_HOST_SPI_ID_DEFAULT, &io_config, &io_handle) != ESP_OK){
     printf("Failed to set LCD communication parameters -- SPI\r\n");
     return 0;
   }
+  lcd_io_handle = io_handle;
   printf("LCD communication parameters are set successfully -- SPI\r\n");
   
   if (register_data[0] == 0x00 && register_data[1] == 0x7F && register_data[2] == 0x7F && register_data[3] == 0x7F) {
@@ -363,41 +539,35 @@ int QSPI_Init(void){
   esp_lcd_panel_reset(panel_handle);
   esp_lcd_panel_init(panel_handle);
   esp_lcd_panel_disp_on_off(panel_handle, true);
-  
-  test_draw_bitmap(panel_handle);
   return 1;
 }
 
 
 void ST77916_Init() {
   ST7701_Reset();
-  pinMode(ESP_PANEL_LCD_SPI_IO_TE, OUTPUT);
+  // TE is a panel output, never drive it
+  pinMode(ESP_PANEL_LCD_SPI_IO_TE, INPUT);
   if(!QSPI_Init()){
     printf("ST77916 Failed to be initialized\r\n");
   }
   
   // Clear display to black immediately after initialization to prevent colored stripes
-  printf("[LCD] Clearing display to black after initialization\n");
-  uint32_t total_pixels = EXAMPLE_LCD_WIDTH * EXAMPLE_LCD_HEIGHT;
-  uint16_t *black_buffer = (uint16_t*)malloc(total_pixels * sizeof(uint16_t));
-  if (black_buffer) {
-    // Fill buffer with black pixels (RGB565: 0x0000)
-    for (uint32_t i = 0; i < total_pixels; i++) {
-      black_buffer[i] = 0x0000;
-    }
-    LCD_addWindow(0, 0, EXAMPLE_LCD_WIDTH - 1, EXAMPLE_LCD_HEIGHT - 1, black_buffer);
-    free(black_buffer);
-  }
+  uint64_t clear_start = esp_timer_get_time();
+  LCD_FillScreen(0x0000);
+  LCD_WaitTransDone();
+  printf("[LCD] Display cleared in %lu us (free heap %u, min %u)\n",
+         (unsigned long)(esp_timer_get_time() - clear_start),
+         (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL),
+         (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL));
+
+  LCD_SetTESync(LCD_TE_SYNC_DEFAULT);
 }
 
 
-void LCD_addWindow(uint16_t Xstart, uint16_t Ystart, uint16_t Xend, uint16_t Yend,uint16_t* color)
+// Pixels must already be in the panel's byte order (big-endian RGB565).
+// LVGL renders LV_COLOR_FORMAT_RGB565_SWAPPED, so no per-pixel swap is needed here.
+bool LCD_addWindow(uint16_t Xstart, uint16_t Ystart, uint16_t Xend, uint16_t Yend,uint16_t* color, bool notify)
 { 
-  uint32_t size = (Xend - Xstart +1 ) * (Yend - Ystart + 1);
-  for (size_t i = 0; i < size; i++) {
-    color[i] = (((color[i] >> 8) & 0xFF) | ((color[i] << 8) & 0xFF00));
-  }
-  
   Xend = Xend + 1;
   Yend = Yend + 1;
   if (Xend > EXAMPLE_LCD_WIDTH)
@@ -405,7 +575,59 @@ void LCD_addWindow(uint16_t Xstart, uint16_t Ystart, uint16_t Xend, uint16_t Yen
   if (Yend > EXAMPLE_LCD_HEIGHT)
     Yend = EXAMPLE_LCD_HEIGHT;
     
-  esp_lcd_panel_draw_bitmap(panel_handle, Xstart, Ystart, Xend, Yend, color);
+  return lcd_draw_bitmap_async(Xstart, Ystart, Xend, Yend, color, notify);
+}
+
+
+void LCD_Fill(uint16_t Xstart, uint16_t Ystart, uint16_t Xend, uint16_t Yend, uint16_t color)
+{
+  if (!fill_buf) {
+    fill_buf = (uint16_t *)heap_caps_malloc(LCD_FILL_BUF_LINES * EXAMPLE_LCD_WIDTH * sizeof(uint16_t), MALLOC_CAP_DMA);
+    if (!fill_buf) {
+      printf("[LCD] Fill buffer allocation failed\n");
+      return;
+    }
+  }
+
+  if (Xend >= EXAMPLE_LCD_WIDTH)
+    Xend = EXAMPLE_LCD_WIDTH - 1;
+  if (Yend >= EXAMPLE_LCD_HEIGHT)
+    Yend = EXAMPLE_LCD_HEIGHT - 1;
+  if (Xstart > Xend || Ystart > Yend)
+    return;
+
+  uint16_t panel_color = (uint16_t)((color >> 8) | (color << 8));
+  if (!fill_buf_valid || panel_color != fill_color) {
+    // Earlier fills may still be reading the buffer
+    LCD_WaitTransDone();
+    for (uint32_t i = 0; i < LCD_FILL_BUF_LINES * EXAMPLE_LCD_WIDTH; i++) {
+      fill_buf[i] = panel_color;
+    }
+    fill_color = panel_color;
+    fill_buf_valid = true;
+  }
+
+  // Every chunk sends the same data, so the one buffer is queued over and over
+  const uint32_t width = Xend - Xstart + 1;
+  const uint32_t lines = (LCD_FILL_BUF_LINES * EXAMPLE_LCD_WIDTH) / width;
+  for (uint32_t y = Ystart; y <= Yend; y += lines) {
+    lv_area_t chunk = { Xstart, (int32_t)y, Xend, (int32_t)LV_MIN(y + lines - 1, Yend) };
+    lv_area_t bands[ROUND_MASK_MAX_BANDS];
+    int band_count = 1;
+#if LCD_ROUND_CLIP
+    band_count = RoundMask_SplitArea(&chunk, bands, ROUND_MASK_MAX_BANDS);
+#else
+    bands[0] = chunk;
+#endif
+    // Every band is at most as large as the chunk, so the buffer covers it
+    for (int b = 0; b < band_count; b++)
+      lcd_draw_bitmap_async(bands[b].x1, bands[b].y1, bands[b].x2 + 1, bands[b].y2 + 1, fill_buf, false);
+  }
+}
+
+void LCD_FillScreen(uint16_t color)
+{
+  LCD_Fill(0, 0, EXAMPLE_LCD_WIDTH - 1, EXAMPLE_LCD_HEIGHT - 1, color);
 }
 
 
@@ -34,14 +34,64 @@
 #define EXAMPLE_LCD_BK_LIGHT_ON_LEVEL       (1)
 #define EXAMPLE_LCD_BK_LIGHT_OFF_LEVEL !EXAMPLE_LCD_BK_LIGHT_ON_LEVEL
 
-#define ESP_PANEL_HOST_SPI_MAX_TRANSFER_SIZE   (2048)  // *** SAFE default value ***
+// One SPI transaction carries up to 40 lines, so an 80-line LVGL chunk is queued as
+// two DMA transactions and never blocks on the trans queue (HW limit is 32 KB)
+#define ESP_PANEL_HOST_SPI_MAX_TRANSFER_SIZE   (EXAMPLE_LCD_WIDTH * 40 * sizeof(uint16_t))
+
+// *** TEARING EFFECT SYNC ***
+// When enabled, the panel's TE output (GPIO 18) is an input interrupt and every
+// frame starts its first flush right after the vsync pulse. Off by default,
+// enable at build time with -DLCD_TE_SYNC_DEFAULT=1 or at runtime.
+#ifndef LCD_TE_SYNC_DEFAULT
+#define LCD_TE_SYNC_DEFAULT                 (0)
+#endif
+#define LCD_TE_TIMEOUT_MS                   (40)    // ~2 panel frames, then the frame counts as missed
+
+typedef struct {
+  uint32_t vsync_count;     // TE pulses seen since reset
+  uint32_t frames;          // frames started on a vsync
+  uint32_t missed_frames;   // no TE pulse within LCD_TE_TIMEOUT_MS, flushed unsynced
+  uint32_t late_frames;     // last transfer finished after the next vsync (scan may overtake)
+  uint32_t max_wait_us;     // longest wait for a vsync
+  uint64_t total_wait_us;
+} LCD_TEStats_t;
 
 extern uint8_t LCD_Backlight;
 
 void ST77916_Init();
 
 void LCD_Init();
-void LCD_addWindow(uint16_t Xstart, uint16_t Ystart, uint16_t Xend, uint16_t Yend,uint16_t* color);
+// color: big-endian (byte-swapped) RGB565, sent to the panel as-is.
+// The transfer is queued to DMA and the call returns before it finishes:
+// the buffer must stay untouched until the trans-done callback fires
+// (or LCD_WaitTransDone() returns). Returns false if nothing was queued.
+// notify = false skips the trans-done callback for this window (all but the
+// last window of a flush that is sent in several bands).
+bool LCD_addWindow(uint16_t Xstart, uint16_t Ystart, uint16_t Xend, uint16_t Yend,uint16_t* color, bool notify = true);
+
+// Solid fill of a window (inclusive coordinates), color is plain RGB565 (lv_color_to_u16).
+// Streams one small reusable DMA line buffer, no frame-sized allocation. Queued
+// asynchronously like LCD_addWindow; LVGL redraws over it on its next refresh.
+#define LCD_FILL_BUF_LINES                  (10)
+void LCD_Fill(uint16_t Xstart, uint16_t Ystart, uint16_t Xend, uint16_t Yend, uint16_t color);
+void LCD_FillScreen(uint16_t color);
+
+// Called from the SPI ISR when the color data of one LCD_addWindow() is on the panel.
+// Return true if a higher priority task was woken.
+typedef bool (*LCD_TransDoneCallback)(void *user_ctx);
+void LCD_SetTransDoneCallback(LCD_TransDoneCallback callback, void *user_ctx);
+// Block until every queued color transfer has completed
+void LCD_WaitTransDone();
+
+// Frame pacing, called by the LVGL flush: BeginFrame before the first transfer
+// of a frame (waits for vsync when TE sync is on), EndFrame after the last one.
+void LCD_BeginFrame();
+void LCD_EndFrame();
+void LCD_SetTESync(bool enable);
+bool LCD_GetTESync();
+void LCD_GetTEStats(LCD_TEStats_t *stats);
+void LCD_ResetTEStats();
+void LCD_PrintTEStats();
 
 // backlight
 void Backlight_Init();
@@ -1,30 +1,37 @@
 #include "lvgl_driver.h"
 #include "hardware/system/power_management.h"
+#include "core/latency_trace.h"
 
 static lv_display_t *display;
 static lv_indev_t *indev;
 
 // *** TOUCH CALIBRATION GLOBALS ***
-// Global touch calibration values that can be updated from NVS
-float g_touch_scale_x = 0.85f;  // Default value from original working calibration
-float g_touch_scale_y = 1.0f;   // Default value from original working calibration
-float g_touch_offset_x = 0.0f;  // NEW: X offset for calibration  
-float g_touch_offset_y = 0.0f;  // NEW: Y offset for calibration
+// Raw controller point -> screen pixel, Q16 affine (see touch_affine.h).
+// Until a calibration is loaded: the original working calibration, x scaled
+// by 0.85 around the center.
+static TouchAffine default_touch_affine(void) {
+    TouchAffine m;
+    touch_affine_from_scale_offset(0.85f, 1.0f, 0.0f, 0.0f, LCD_WIDTH / 2, LCD_HEIGHT / 2, &m);
+    return m;
+}
+TouchAffine g_touch_affine = default_touch_affine();
+
+// Last pressed point before calibration, for the calibration screen
+static lv_point_t last_raw_point = { 0, 0 };
 
 /**
- * @brief Update global touch calibration values (including offsets)
- * @param scale_x X scaling factor 
- * @param scale_y Y scaling factor
- * @param offset_x X offset in pixels
- * @param offset_y Y offset in pixels  
+ * @brief Replace the touch transform
+ * @param m Affine transform from raw controller coordinates to screen pixels
  */
-void updateTouchCalibration(float scale_x, float scale_y, float offset_x, float offset_y) {
-    g_touch_scale_x = scale_x;
-    g_touch_scale_y = scale_y;
-    g_touch_offset_x = offset_x;
-    g_touch_offset_y = offset_y;
-    printf("[TouchCal] Updated: scale(%.3f,%.3f) offset(%.3f,%.3f)\n", 
-           scale_x, scale_y, offset_x, offset_y);
+void updateTouchCalibration(const TouchAffine &m) {
+    g_touch_affine = m;
+    printf("[TouchCal] Updated: x = %.4f*x %+.4f*y %+.2f, y = %.4f*x %+.4f*y %+.2f\n",
+           m.a / (float)TOUCH_AFFINE_ONE, m.b / (float)TOUCH_AFFINE_ONE, m.c / (float)TOUCH_AFFINE_ONE,
+           m.d / (float)TOUCH_AFFINE_ONE, m.e / (float)TOUCH_AFFINE_ONE, m.f / (float)TOUCH_AFFINE_ONE);
+}
+
+void Lvgl_GetLastRawTouch(lv_point_t *point) {
+    *point = last_raw_point;
 }
 
 // *** OPTIMIERT: GRÖßERER BUFFER (von 32 auf 64 Zeilen) ***
@@ -32,52 +39,187 @@ void updateTouchCalibration(float scale_x, float scale_y, float offset_x, float
 static lv_color_t *buf1 = (lv_color_t *)heap_caps_malloc(LVGL_BUF_LEN * sizeof(lv_color_t), MALLOC_CAP_DMA);
 static lv_color_t *buf2 = (lv_color_t *)heap_caps_malloc(LVGL_BUF_LEN * sizeof(lv_color_t), MALLOC_CAP_DMA);
 
+// *** PSRAM FRAME BUFFERS (FULL / DIRECT mode) ***
+// Allocated on first use and kept, buf1/buf2 then serve as DMA bounce buffers
+static uint8_t *frame_buf1 = NULL;
+static uint8_t *frame_buf2 = NULL;
+static lv_display_render_mode_t render_mode = LV_DISPLAY_RENDER_MODE_PARTIAL;
+static uint8_t bounce_index = 0;
+
+// *** ASYNC FLUSH ***
+// The flush only queues the QSPI transfer; LVGL renders the next chunk into the
+// other buffer while this one is on the wire. The SPI trans-done ISR reports
+// flush ready and wakes the LVGL thread waiting for the buffer.
+static SemaphoreHandle_t flush_done_sem = NULL;
+static volatile bool flush_in_flight = false;
+
+static bool IRAM_ATTR Lvgl_Flush_Done(void *user_ctx) {
+    // Bounce transfers (full/direct mode) release their buffer synchronously
+    if (!flush_in_flight) return false;
+
+    BaseType_t woken = pdFALSE;
+    DSTATS_TRANSFER_DONE();
+    flush_in_flight = false;
+    lv_display_flush_ready((lv_display_t *)user_ctx);
+    xSemaphoreGiveFromISR(flush_done_sem, &woken);
+    return woken == pdTRUE;
+}
+
+// Called by LVGL before it reuses a buffer that is still being flushed
+static void Lvgl_Flush_Wait(lv_display_t *disp) {
+    DSTATS_WAIT_BEGIN();
+    while (flush_in_flight) {
+        // Timeout only guards against a lost completion, normal wake-up is the ISR
+        xSemaphoreTake(flush_done_sem, pdMS_TO_TICKS(20));
+    }
+    DSTATS_WAIT_END();
+}
+
+// True between the first and the last flush of one refresh
+static bool frame_in_progress = false;
+
+// Copy an area of a PSRAM frame buffer through the internal DMA buffers.
+// Bounce buffers alternate: while one is on the wire the next chunk is copied
+// into the other, and the next LCD_addWindow waits for the previous transfer.
+static uint32_t Lvgl_Flush_Bounce(const lv_area_t *area, const uint8_t *frame) {
+    const uint32_t px_size = sizeof(uint16_t);
+    const uint32_t stride = LCD_WIDTH * px_size;
+    uint32_t sent = 0;
+
+    for (int32_t y = area->y1; y <= area->y2; y += LVGL_BOUNCE_LINES) {
+        lv_area_t chunk = { area->x1, y, area->x2, LV_MIN(y + LVGL_BOUNCE_LINES - 1, area->y2) };
+        lv_area_t bands[ROUND_MASK_MAX_BANDS];
+        int band_count = 1;
+#if LCD_ROUND_CLIP
+        band_count = RoundMask_SplitArea(&chunk, bands, ROUND_MASK_MAX_BANDS);
+#else
+        bands[0] = chunk;
+#endif
+        for (int b = 0; b < band_count; b++) {
+            const lv_area_t *band = &bands[b];
+            uint8_t *bounce = (uint8_t *)(bounce_index ? buf2 : buf1);
+            bounce_index ^= 1;
+
+            uint32_t row_bytes = lv_area_get_width(band) * px_size;
+            int32_t rows = lv_area_get_height(band);
+            const uint8_t *src = frame + band->y1 * stride + band->x1 * px_size;
+            for (int32_t row = 0; row < rows; row++) {
+                memcpy(bounce + row * row_bytes, src + row * stride, row_bytes);
+            }
+
+            if (LCD_addWindow(band->x1, band->y1, band->x2, band->y2, (uint16_t *)bounce)) {
+                sent += row_bytes * rows;
+            }
+        }
+    }
+    return sent;
+}
+
 // LVGL v9 flush callback
 void Lvgl_Display_Flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
-    LCD_addWindow(area->x1, area->y1, area->x2, area->y2, (uint16_t *)px_map);
-    lv_display_flush_ready(disp);
+    LTRACE_FLUSH(area);
+    if (!frame_in_progress) {
+        // With TE sync on this waits for the panel's vsync
+        DSTATS_WAIT_BEGIN();
+        LCD_BeginFrame();
+        DSTATS_WAIT_END();
+        frame_in_progress = true;
+    }
+    DSTATS_FLUSH_BEGIN();
+
+    if (render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        // px_map is a whole frame buffer; once copied out LVGL may reuse it
+        uint32_t sent = Lvgl_Flush_Bounce(area, px_map);
+#if LCD_ROUND_CLIP
+        RoundMask_CountFlush(area, sent, lv_display_flush_is_last(disp));
+#endif
+        DSTATS_FLUSH_END(sent / sizeof(uint16_t), sent, false);
+        (void)sent;
+        lv_display_flush_ready(disp);
+        if (lv_display_flush_is_last(disp)) {
+            LCD_EndFrame();
+            frame_in_progress = false;
+        }
+        return;
+    }
+
+    // Only the visible part of the round panel goes over QSPI, as a few bands of
+    // rows with similar spans packed to the start of px_map
+    lv_area_t bands[ROUND_MASK_MAX_BANDS];
+    int band_count = 1;
+    bands[0] = *area;
+#if LCD_ROUND_CLIP
+    band_count = RoundMask_CompactFlush(area, px_map, bands, ROUND_MASK_MAX_BANDS);
+#endif
+    uint32_t send_pixels = 0;
+    for (int b = 0; b < band_count; b++) send_pixels += lv_area_get_size(&bands[b]);
+#if LCD_ROUND_CLIP
+    RoundMask_CountFlush(area, send_pixels * sizeof(uint16_t), lv_display_flush_is_last(disp));
+#endif
+
+    // Recorded before queuing, the trans-done ISR may fire before LCD_addWindow returns
+    DSTATS_FLUSH_END(send_pixels, send_pixels * sizeof(uint16_t), true);
+
+    // Only the last band reports flush ready; esp_lcd sends the earlier ones
+    // before it accepts the next window
+    flush_in_flight = band_count > 0;
+    bool queued = false;
+    uint16_t *band_px = (uint16_t *)px_map;
+    for (int b = 0; b < band_count; b++) {
+        bool last = b == band_count - 1;
+        queued = LCD_addWindow(bands[b].x1, bands[b].y1, bands[b].x2, bands[b].y2, band_px, last);
+        band_px += lv_area_get_size(&bands[b]);
+    }
+    if (!queued) {
+        // Nothing to send or the last band could not be queued; earlier bands may
+        // still read px_map, so let them finish before releasing the buffer
+        flush_in_flight = false;
+        LCD_WaitTransDone();
+        lv_display_flush_ready(disp);
+    }
+
+    if (lv_display_flush_is_last(disp)) {
+        LCD_EndFrame();
+        frame_in_progress = false;
+    }
 }
 
 // LVGL v9 touchpad read callback with SCALING CORRECTION
+// Event mode: runs on the UI task when the input task queued samples
+// (see touch_input.h), one sample per call
 void Lvgl_Touchpad_Read(lv_indev_t *indev, lv_indev_data_t *data) {
-    Touch_Read_Data();
+    static lv_indev_state_t last_state = LV_INDEV_STATE_RELEASED;
+    TouchSample sample;
+    bool more = false;
+    if (!touch_input_pop(&sample, &more)) {
+        // Nothing new (e.g. a scroll throw still running), keep the last state
+        data->state = last_state;
+        return;
+    }
+    data->continue_reading = more;
+    LTRACE_BEGIN(sample.seq, sample.isr_us);
     
-    // Reset inactivity timer on touch (after Touch_Read_Data to avoid I2C conflicts)
-    if (touch_data.points != 0) {
+    // Reset inactivity timer on touch
+    if (sample.points != 0) {
         power_reset_inactivity_timer();
         
         // Ignore touch events for a short time after waking from sleep/dim
         if (power_should_ignore_touch()) {
-            // Block touch completely by clearing touch data and marking as released
-            touch_data.points = 0;
-            touch_data.gesture = NONE;
+            // Block touch completely by marking as released
             data->state = LV_INDEV_STATE_RELEASED;
             data->point.x = 0;
             data->point.y = 0;
+            last_state = data->state;
             return;
         }
     }
     
-    if (touch_data.points != 0) {
-        // TOUCH CALIBRATION - Apply both scaling AND offset
-        float scale_x = g_touch_scale_x;   // From calibration or default 0.85f
-        float scale_y = g_touch_scale_y;   // From calibration or default 1.0f
-        float offset_x = g_touch_offset_x; // From calibration or default 0.0f
-        float offset_y = g_touch_offset_y; // From calibration or default 0.0f
-        
-        // Apply scaling first (around center)
-        int center_x = LCD_WIDTH / 2;
-        int center_y = LCD_HEIGHT / 2;
-        
-        int dx = touch_data.x - center_x;
-        int dy = touch_data.y - center_y;
-        
-        int scaled_x = center_x + (int)(dx * scale_x);
-        int scaled_y = center_y + (int)(dy * scale_y);
-        
-        // Then apply offset correction
-        int corrected_x = scaled_x + (int)offset_x;
-        int corrected_y = scaled_y + (int)offset_y;
+    if (sample.points != 0) {
+        // TOUCH CALIBRATION - integer affine transform, no float per sample
+        last_raw_point.x = sample.x;
+        last_raw_point.y = sample.y;
+        int32_t corrected_x, corrected_y;
+        touch_affine_apply(&g_touch_affine, sample.x, sample.y, &corrected_x, &corrected_y);
         
         // Clamp to screen bounds
         if (corrected_x < 0) corrected_x = 0;
@@ -91,9 +233,7 @@ void Lvgl_Touchpad_Read(lv_indev_t *indev, lv_indev_data_t *data) {
     } else {
         data->state = LV_INDEV_STATE_RELEASED;
     }
-    
-    touch_data.points = 0;
-    touch_data.gesture = NONE;
+    last_state = data->state;
 }
 
 static void lv_tick_task(void *arg) {
@@ -114,12 +254,26 @@ void Lvgl_Init(void) {
 
     // Create a display
     display = lv_display_create(LCD_WIDTH, LCD_HEIGHT);
+
+    // Render directly in the panel's byte order so the flush path never swaps pixels
+    lv_display_set_color_format(display, LV_COLOR_FORMAT_RGB565_SWAPPED);
     
-    // *** OPTIMIERT: FULL REFRESH für bessere Performance ***
+    // Partial mode with the internal DMA buffers until the configured mode is set below
     lv_display_set_buffers(display, buf1, buf2, LVGL_BUF_LEN * sizeof(lv_color_t), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    Lvgl_SetRenderMode(LVGL_RENDER_MODE);
 
     // Set the flush callback
+    flush_done_sem = xSemaphoreCreateBinary();
+    LCD_SetTransDoneCallback(Lvgl_Flush_Done, display);
     lv_display_set_flush_cb(display, Lvgl_Display_Flush);
+    lv_display_set_flush_wait_cb(display, Lvgl_Flush_Wait);
+    DSTATS_INIT(display);
+
+#if LCD_ROUND_CLIP
+    // Shrink dirty areas to the visible circle before they are rendered
+    RoundMask_Init();
+    lv_display_add_event_cb(display, RoundMask_InvalidateEventCb, LV_EVENT_INVALIDATE_AREA, NULL);
+#endif
 
     // Clear display to black before UI creation to prevent static flash
     lv_color_t black_color = lv_color_black();
@@ -132,6 +286,9 @@ void Lvgl_Init(void) {
     lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
     lv_indev_set_read_cb(indev, Lvgl_Touchpad_Read);
 
+    // Read only when the touch interrupt delivered samples
+    touch_input_start(indev);
+
     // LVGL Tick timer setup
     const esp_timer_create_args_t lvgl_tick_timer_args = {
         .callback = &lv_tick_task,
@@ -152,4 +309,95 @@ void Lvgl_Init(void) {
 
 void Lvgl_Loop(void) {
     lv_timer_handler();
-}
\ No newline at end of file
+}
+
+const char *Lvgl_RenderModeName(lv_display_render_mode_t mode) {
+    switch (mode) {
+        case LV_DISPLAY_RENDER_MODE_PARTIAL: return "partial";
+        case LV_DISPLAY_RENDER_MODE_FULL:    return "full";
+        case LV_DISPLAY_RENDER_MODE_DIRECT:  return "direct";
+        default:                             return "?";
+    }
+}
+
+lv_display_render_mode_t Lvgl_GetRenderMode(void) {
+    return render_mode;
+}
+
+bool Lvgl_SetRenderMode(lv_display_render_mode_t mode) {
+    if (!display) return false;
+
+    if (mode != LV_DISPLAY_RENDER_MODE_PARTIAL && (!frame_buf1 || !frame_buf2)) {
+        if (!frame_buf1) frame_buf1 = (uint8_t *)heap_caps_aligned_alloc(LV_DRAW_BUF_ALIGN, LVGL_FRAME_BUF_SIZE, MALLOC_CAP_SPIRAM);
+        if (!frame_buf2) frame_buf2 = (uint8_t *)heap_caps_aligned_alloc(LV_DRAW_BUF_ALIGN, LVGL_FRAME_BUF_SIZE, MALLOC_CAP_SPIRAM);
+        if (!frame_buf1 || !frame_buf2) {
+            printf("[LVGL_ERROR] PSRAM frame buffer allocation FAILED, staying in %s mode\n",
+                   Lvgl_RenderModeName(render_mode));
+            return false;
+        }
+        printf("[LVGL_Init] PSRAM frame buffers allocated: 2 x %d bytes\n", LVGL_FRAME_BUF_SIZE);
+    }
+
+    // No buffer may be on the wire while LVGL gets its new buffers
+    LCD_WaitTransDone();
+
+    if (mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        lv_display_set_buffers(display, buf1, buf2, LVGL_BUF_LEN * sizeof(lv_color_t), mode);
+    } else {
+        // Both frame buffers start black so DIRECT mode never shows stale data
+        memset(frame_buf1, 0, LVGL_FRAME_BUF_SIZE);
+        memset(frame_buf2, 0, LVGL_FRAME_BUF_SIZE);
+        lv_display_set_buffers(display, frame_buf1, frame_buf2, LVGL_FRAME_BUF_SIZE, mode);
+    }
+    render_mode = mode;
+    frame_in_progress = false;
+
+    lv_obj_invalidate(lv_screen_active());
+    printf("[LVGL] Render mode: %s\n", Lvgl_RenderModeName(mode));
+    return true;
+}
+
+// Time one synchronous redraw of `area` (render + transfer) in microseconds
+static uint32_t Lvgl_Bench_Redraw(const lv_area_t *area) {
+    uint64_t start = esp_timer_get_time();
+    lv_obj_invalidate_area(lv_screen_active(), area);
+    lv_refr_now(display);
+    LCD_WaitTransDone();
+    return (uint32_t)(esp_timer_get_time() - start);
+}
+
+void Lvgl_BenchmarkRenderModes(const char *scene, uint32_t frames) {
+    if (!display || frames == 0) return;
+
+    static const lv_display_render_mode_t modes[] = {
+        LV_DISPLAY_RENDER_MODE_PARTIAL, LV_DISPLAY_RENDER_MODE_FULL, LV_DISPLAY_RENDER_MODE_DIRECT
+    };
+    // Full screen, and a life-total sized area in the center
+    const lv_area_t full_area = { 0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1 };
+    const lv_area_t label_area = { LCD_WIDTH / 2 - 100, LCD_HEIGHT / 2 - 50, LCD_WIDTH / 2 + 99, LCD_HEIGHT / 2 + 49 };
+    lv_display_render_mode_t restore = render_mode;
+
+    printf("[LVGL_Bench] Scene '%s', %lu frames per mode, %d draw unit(s)\n",
+           scene ? scene : "", (unsigned long)frames, LV_DRAW_SW_DRAW_UNIT_CNT);
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        if (!Lvgl_SetRenderMode(modes[m])) continue;
+        lv_refr_now(display);
+        LCD_WaitTransDone();
+
+        uint64_t full_total = 0, label_total = 0;
+        uint32_t full_max = 0, label_max = 0;
+        for (uint32_t i = 0; i < frames; i++) {
+            uint32_t t = Lvgl_Bench_Redraw(&full_area);
+            full_total += t;
+            if (t > full_max) full_max = t;
+            t = Lvgl_Bench_Redraw(&label_area);
+            label_total += t;
+            if (t > label_max) label_max = t;
+        }
+        printf("[LVGL_Bench] %-7s full: avg %5lu us max %5lu us | center: avg %5lu us max %5lu us\n",
+               Lvgl_RenderModeName(modes[m]),
+               (unsigned long)(full_total / frames), (unsigned long)full_max,
+               (unsigned long)(label_total / frames), (unsigned long)label_max);
+    }
+    Lvgl_SetRenderMode(restore);
+}
@@ -16,7 +16,11 @@
 // Hardware Drivers (same level/nearby)
 // ============================================
 #include "display_st77916.h"
+#include "round_mask.h"
+#include "display_stats.h"
 #include "../touch/touch_cst816.h"
+#include "../touch/touch_input.h"
+#include "../touch/touch_affine.h"
 
 
 #ifndef LCD_WIDTH
@@ -31,6 +35,17 @@
 // Bei 480x480: (480 * 64 * 2 bytes) = 61.440 bytes = ~60 KB pro Buffer
 #define LVGL_BUF_LEN  (LCD_WIDTH * 80)  // War: 32 -> JETZT: 64 Lines!
 
+// *** RENDER MODE ***
+// PARTIAL: LVGL renders 80-line chunks into the two internal DMA buffers (default)
+// FULL / DIRECT: two full frame buffers in PSRAM, flushed through the internal
+// DMA buffers as bounce buffers. Override with e.g.
+// -DLVGL_RENDER_MODE=LV_DISPLAY_RENDER_MODE_DIRECT or switch at runtime.
+#ifndef LVGL_RENDER_MODE
+    #define LVGL_RENDER_MODE  LV_DISPLAY_RENDER_MODE_PARTIAL
+#endif
+#define LVGL_FRAME_BUF_SIZE   (LCD_WIDTH * LCD_HEIGHT * sizeof(uint16_t))
+#define LVGL_BOUNCE_LINES     40   // Lines per bounce transfer, one SPI transaction
+
 // *** SCHNELLERER TICK (von 10ms auf 5ms für 200Hz) ***
 #define EXAMPLE_LVGL_TICK_PERIOD_MS  10  // War: 10ms -> JETZT: 5ms!
 
@@ -41,12 +56,20 @@ void Lvgl_Touchpad_Read(lv_indev_t *indev, lv_indev_data_t *data);
 void Lvgl_Init(void);
 void Lvgl_Loop(void);
 
+// Render mode control, call from the LVGL thread
+bool Lvgl_SetRenderMode(lv_display_render_mode_t mode);
+lv_display_render_mode_t Lvgl_GetRenderMode(void);
+const char *Lvgl_RenderModeName(lv_display_render_mode_t mode);
+
+// Redraw the active screen in every render mode and print the timings.
+// `scene` only labels the output (e.g. "life", "menu", "history").
+void Lvgl_BenchmarkRenderModes(const char *scene, uint32_t frames);
+
 // *** TOUCH CALIBRATION GLOBALS ***
-// External access to touch calibration values for NVS loading
-extern float g_touch_scale_x;
-extern float g_touch_scale_y;
-extern float g_touch_offset_x;  // NEW: Offset support
-extern float g_touch_offset_y;  // NEW: Offset support
+// Raw-to-screen touch transform, replaced when NVS calibration is loaded
+extern TouchAffine g_touch_affine;
 
 // *** TOUCH CALIBRATION API ***
-void updateTouchCalibration(float scale_x, float scale_y, float offset_x, float offset_y);
+void updateTouchCalibration(const TouchAffine &m);
+// Last pressed point as reported by the controller, before calibration
+void Lvgl_GetLastRawTouch(lv_point_t *point);
@@ -0,0 +1,217 @@
+#include "display_stats.h"
+
+#if DISPLAY_STATS
+
+#include <stdio.h>
+#include <string.h>
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+
+// Upper bucket edges, the last bucket takes everything above
+static const uint32_t time_edges_us[DSTATS_BUCKETS - 1] = { 250, 500, 1000, 2000, 4000, 8000, 16000, 33000, 66000 };
+static const uint32_t flush_edges[DSTATS_BUCKETS - 1]   = { 1, 2, 3, 4, 5, 6, 8, 12, 16 };
+static const uint32_t pixel_edges[DSTATS_BUCKETS - 1]   = { 256, 1024, 4096, 8192, 16384, 32768, 65536, 98304, 129600 };
+static const uint32_t byte_edges[DSTATS_BUCKETS - 1]    = { 512, 2048, 8192, 16384, 32768, 65536, 131072, 196608, 259200 };
+
+static display_stats_t stats = {};
+// stats is written from the UI task and from the SPI trans-done ISR on the other
+// core; every access to it holds stats_lock
+static portMUX_TYPE stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Current frame, only touched from the LVGL thread
+static int64_t frame_start_us = 0;
+static uint32_t frame_flushes = 0;
+static uint32_t frame_pixels = 0;
+static uint32_t frame_bytes = 0;
+static uint32_t frame_flush_cb_us = 0;
+static uint32_t frame_wait_us = 0;
+static int64_t flush_start_us = 0;
+static int64_t wait_start_us = 0;
+
+// Start of the transfer in flight, cleared by the trans-done ISR. 64 bits
+// are two stores on this core, so it is only accessed under stats_lock.
+static int64_t transfer_start_us = 0;
+
+static lv_obj_t *overlay_label = NULL;
+static lv_timer_t *overlay_timer = NULL;
+static uint32_t overlay_frames = 0;
+static int64_t overlay_window_us = 0;
+
+static void IRAM_ATTR hist_add(dstats_hist_t *hist, const uint32_t *edges, uint32_t value) {
+    uint32_t bucket = 0;
+    while (bucket < DSTATS_BUCKETS - 1 && value > edges[bucket]) bucket++;
+    hist->counts[bucket]++;
+    hist->samples++;
+    hist->sum += value;
+    if (value > hist->max) hist->max = value;
+}
+
+static void refr_start_cb(lv_event_t *e) {
+    frame_start_us = esp_timer_get_time();
+    frame_flushes = 0;
+    frame_pixels = 0;
+    frame_bytes = 0;
+    frame_flush_cb_us = 0;
+    frame_wait_us = 0;
+}
+
+static void refr_ready_cb(lv_event_t *e) {
+    // Timer runs without anything to redraw are not frames
+    if (frame_flushes == 0 || frame_start_us == 0) return;
+
+    uint32_t frame_us = (uint32_t)(esp_timer_get_time() - frame_start_us);
+    uint32_t overhead = frame_flush_cb_us + frame_wait_us;
+    uint32_t render_us = frame_us > overhead ? frame_us - overhead : 0;
+
+    overlay_frames++;
+    taskENTER_CRITICAL(&stats_lock);
+    stats.frames++;
+    hist_add(&stats.flushes_per_frame, flush_edges, frame_flushes);
+    hist_add(&stats.pixels_per_frame, pixel_edges, frame_pixels);
+    hist_add(&stats.bytes_per_frame, byte_edges, frame_bytes);
+    hist_add(&stats.render_us, time_edges_us, render_us);
+    hist_add(&stats.wait_us, time_edges_us, frame_wait_us);
+    taskEXIT_CRITICAL(&stats_lock);
+}
+
+void DisplayStats_Init(lv_display_t *disp) {
+    lv_display_add_event_cb(disp, refr_start_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(disp, refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+    printf("[DispStats] Display instrumentation enabled\n");
+}
+
+void DisplayStats_FlushBegin(void) {
+    flush_start_us = esp_timer_get_time();
+}
+
+void DisplayStats_FlushEnd(uint32_t pixels, uint32_t bytes, bool async) {
+    int64_t now = esp_timer_get_time();
+    uint32_t cb_us = (uint32_t)(now - flush_start_us);
+
+    frame_flushes++;
+    frame_pixels += pixels;
+    frame_bytes += bytes;
+    frame_flush_cb_us += cb_us;
+
+    if (async) {
+        // Completed by DisplayStats_TransferDone() from the SPI ISR
+        if (bytes) {
+            taskENTER_CRITICAL(&stats_lock);
+            transfer_start_us = flush_start_us;
+            taskEXIT_CRITICAL(&stats_lock);
+        }
+    } else {
+        taskENTER_CRITICAL(&stats_lock);
+        hist_add(&stats.transfer_us, time_edges_us, cb_us);
+        taskEXIT_CRITICAL(&stats_lock);
+    }
+}
+
+void IRAM_ATTR DisplayStats_TransferDone(void) {
+    int64_t now = esp_timer_get_time();
+    taskENTER_CRITICAL_ISR(&stats_lock);
+    int64_t start = transfer_start_us;
+    transfer_start_us = 0;
+    if (start != 0) hist_add(&stats.transfer_us, time_edges_us, (uint32_t)(now - start));
+    taskEXIT_CRITICAL_ISR(&stats_lock);
+}
+
+void DisplayStats_WaitBegin(void) {
+    wait_start_us = esp_timer_get_time();
+}
+
+void DisplayStats_WaitEnd(void) {
+    frame_wait_us += (uint32_t)(esp_timer_get_time() - wait_start_us);
+}
+
+void DisplayStats_Get(display_stats_t *out) {
+    taskENTER_CRITICAL(&stats_lock);
+    *out = stats;
+    taskEXIT_CRITICAL(&stats_lock);
+}
+
+void DisplayStats_Reset(void) {
+    taskENTER_CRITICAL(&stats_lock);
+    memset(&stats, 0, sizeof(stats));
+    taskEXIT_CRITICAL(&stats_lock);
+}
+
+static void print_hist(const char *name, const dstats_hist_t *hist, const uint32_t *edges) {
+    printf("[DispStats] %-10s n=%lu avg=%lu max=%lu |", name,
+           (unsigned long)hist->samples,
+           (unsigned long)(hist->samples ? hist->sum / hist->samples : 0),
+           (unsigned long)hist->max);
+    for (int i = 0; i < DSTATS_BUCKETS; i++) {
+        if (i < DSTATS_BUCKETS - 1) {
+            printf(" <=%lu:%lu", (unsigned long)edges[i], (unsigned long)hist->counts[i]);
+        } else {
+            printf(" >%lu:%lu", (unsigned long)edges[i - 1], (unsigned long)hist->counts[i]);
+        }
+    }
+    printf("\n");
+}
+
+void DisplayStats_Print(void) {
+    display_stats_t snapshot;
+    DisplayStats_Get(&snapshot);
+    printf("[DispStats] frames=%lu draw_units=%d\n", (unsigned long)snapshot.frames, LV_DRAW_SW_DRAW_UNIT_CNT);
+    print_hist("flushes", &snapshot.flushes_per_frame, flush_edges);
+    print_hist("pixels", &snapshot.pixels_per_frame, pixel_edges);
+    print_hist("bytes", &snapshot.bytes_per_frame, byte_edges);
+    print_hist("render_us", &snapshot.render_us, time_edges_us);
+    print_hist("xfer_us", &snapshot.transfer_us, time_edges_us);
+    print_hist("wait_us", &snapshot.wait_us, time_edges_us);
+}
+
+static void overlay_timer_cb(lv_timer_t *timer) {
+    if (!overlay_label) return;
+
+    int64_t now = esp_timer_get_time();
+    uint32_t window_us = (uint32_t)(now - overlay_window_us);
+    uint32_t fps = window_us ? (uint32_t)((uint64_t)overlay_frames * 1000000 / window_us) : 0;
+    overlay_frames = 0;
+    overlay_window_us = now;
+
+    display_stats_t snapshot;
+    DisplayStats_Get(&snapshot);
+    const dstats_hist_t *r = &snapshot.render_us;
+    const dstats_hist_t *t = &snapshot.transfer_us;
+    const dstats_hist_t *b = &snapshot.bytes_per_frame;
+    lv_label_set_text_fmt(overlay_label, "%lu fps  r %lu  t %lu us\n%lu KB/frame",
+                          (unsigned long)fps,
+                          (unsigned long)(r->samples ? r->sum / r->samples : 0),
+                          (unsigned long)(t->samples ? t->sum / t->samples : 0),
+                          (unsigned long)(b->samples ? b->sum / b->samples / 1024 : 0));
+}
+
+void DisplayStats_SetOverlay(bool visible) {
+    if (visible == (overlay_label != NULL)) return;
+
+    if (visible) {
+        overlay_label = lv_label_create(lv_layer_top());
+        lv_obj_set_style_text_font(overlay_label, &lv_font_montserrat_12, 0);
+        lv_obj_set_style_text_color(overlay_label, lv_color_white(), 0);
+        lv_obj_set_style_text_align(overlay_label, LV_TEXT_ALIGN_CENTER, 0);
+        lv_obj_set_style_bg_color(overlay_label, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(overlay_label, LV_OPA_70, 0);
+        lv_obj_set_style_pad_all(overlay_label, 2, 0);
+        lv_obj_remove_flag(overlay_label, LV_OBJ_FLAG_CLICKABLE);
+        // Bottom of the circle is still inside the visible area at -30
+        lv_obj_align(overlay_label, LV_ALIGN_BOTTOM_MID, 0, -30);
+        lv_label_set_text(overlay_label, "");
+        overlay_frames = 0;
+        overlay_window_us = esp_timer_get_time();
+        overlay_timer = lv_timer_create(overlay_timer_cb, 500, NULL);
+    } else {
+        lv_timer_delete(overlay_timer);
+        lv_obj_delete(overlay_label);
+        overlay_timer = NULL;
+        overlay_label = NULL;
+    }
+}
+
+bool DisplayStats_OverlayVisible(void) {
+    return overlay_label != NULL;
+}
+
+#endif // DISPLAY_STATS
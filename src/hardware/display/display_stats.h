@@ -0,0 +1,76 @@
+#pragma once
+
+// ============================================
+// Display flush instrumentation
+// ============================================
+// Counts flushes per frame, pixels and bytes sent, and render versus transfer
+// time as fixed-bucket histograms. Dump with the serial "stats" command or show
+// the on-screen overlay. Build with -DDISPLAY_STATS=0 to compile it out: the
+// DSTATS_* hooks then expand to nothing.
+
+#include <lvgl.h>
+#include <stdint.h>
+
+#ifndef DISPLAY_STATS
+#define DISPLAY_STATS 1
+#endif
+
+#define DSTATS_BUCKETS 10
+
+typedef struct {
+    uint32_t counts[DSTATS_BUCKETS];
+    uint32_t samples;
+    uint32_t max;
+    uint64_t sum;
+} dstats_hist_t;
+
+typedef struct {
+    uint32_t frames;
+    dstats_hist_t flushes_per_frame;
+    dstats_hist_t pixels_per_frame;
+    dstats_hist_t bytes_per_frame;
+    dstats_hist_t render_us;        // per frame, LVGL drawing only
+    dstats_hist_t transfer_us;      // per flush, queue to trans-done (copy + send for full/direct)
+    dstats_hist_t wait_us;          // per frame, blocked on a busy buffer or vsync
+} display_stats_t;
+
+#if DISPLAY_STATS
+
+/**
+ * @brief Hook the stats into a display (refresh start/ready events)
+ */
+void DisplayStats_Init(lv_display_t *disp);
+
+void DisplayStats_FlushBegin(void);
+void DisplayStats_FlushEnd(uint32_t pixels, uint32_t bytes, bool async);
+void DisplayStats_TransferDone(void);   // ISR safe
+void DisplayStats_WaitBegin(void);
+void DisplayStats_WaitEnd(void);
+
+void DisplayStats_Get(display_stats_t *out);
+void DisplayStats_Reset(void);
+void DisplayStats_Print(void);
+
+/**
+ * @brief Show or hide a small live summary on lv_layer_top()
+ */
+void DisplayStats_SetOverlay(bool visible);
+bool DisplayStats_OverlayVisible(void);
+
+#define DSTATS_INIT(disp)                   DisplayStats_Init(disp)
+#define DSTATS_FLUSH_BEGIN()                DisplayStats_FlushBegin()
+#define DSTATS_FLUSH_END(px, bytes, async)  DisplayStats_FlushEnd(px, bytes, async)
+#define DSTATS_TRANSFER_DONE()              DisplayStats_TransferDone()
+#define DSTATS_WAIT_BEGIN()                 DisplayStats_WaitBegin()
+#define DSTATS_WAIT_END()                   DisplayStats_WaitEnd()
+
+#else
+
+#define DSTATS_INIT(disp)                   ((void)0)
+#define DSTATS_FLUSH_BEGIN()                ((void)0)
+#define DSTATS_FLUSH_END(px, bytes, async)  ((void)0)
+#define DSTATS_TRANSFER_DONE()              ((void)0)
+#define DSTATS_WAIT_BEGIN()                 ((void)0)
+#define DSTATS_WAIT_END()                   ((void)0)
+
+#endif
@@ -0,0 +1,164 @@
+#include "round_mask.h"
+#include "round_span.h"
+#include <stdio.h>
+#include <string.h>
+
+// Visible span per row, inclusive. Empty rows have x_min > x_max.
+static int16_t span_x_min[LCD_HEIGHT];
+static int16_t span_x_max[LCD_HEIGHT];
+static bool span_ready = false;
+
+static round_mask_stats_t stats = {};
+
+void RoundMask_Init(void) {
+    RoundSpan_Build(LCD_WIDTH, LCD_HEIGHT, ROUND_MASK_MARGIN, span_x_min, span_x_max);
+    span_ready = true;
+
+    uint32_t visible = 0;
+    for (int32_t y = 0; y < LCD_HEIGHT; y++) {
+        if (span_x_max[y] >= span_x_min[y]) visible += span_x_max[y] - span_x_min[y] + 1;
+    }
+    printf("[RoundMask] Span table ready: %lu of %lu pixels visible (%lu%%)\n",
+           (unsigned long)visible, (unsigned long)(LCD_WIDTH * LCD_HEIGHT),
+           (unsigned long)(visible * 100 / (LCD_WIDTH * LCD_HEIGHT)));
+}
+
+void RoundMask_GetRowSpan(int32_t y, int32_t *x_min, int32_t *x_max) {
+    if (!span_ready || y < 0 || y >= LCD_HEIGHT) {
+        *x_min = 0;
+        *x_max = span_ready ? -1 : LCD_WIDTH - 1;
+        return;
+    }
+    *x_min = span_x_min[y];
+    *x_max = span_x_max[y];
+}
+
+static bool row_hits(int32_t y, int32_t x1, int32_t x2) {
+    return span_x_min[y] <= x2 && span_x_max[y] >= x1 && span_x_min[y] <= span_x_max[y];
+}
+
+bool RoundMask_TrimArea(lv_area_t *area) {
+    if (!span_ready) return true;
+
+    int32_t x1 = LV_MAX(area->x1, 0);
+    int32_t x2 = LV_MIN(area->x2, LCD_WIDTH - 1);
+    int32_t y1 = LV_MAX(area->y1, 0);
+    int32_t y2 = LV_MIN(area->y2, LCD_HEIGHT - 1);
+    if (x1 > x2 || y1 > y2) return false;
+
+    // Drop rows at the top and bottom whose span misses the area
+    while (y1 <= y2 && !row_hits(y1, x1, x2)) y1++;
+    while (y2 >= y1 && !row_hits(y2, x1, x2)) y2--;
+    if (y1 > y2) return false;
+
+    // Spans are nested around the center, the row closest to it is the widest
+    const int32_t center = LCD_HEIGHT / 2;
+    int32_t widest = (y1 <= center && y2 >= center) ? center : (y2 < center ? y2 : y1);
+
+    area->x1 = LV_MAX(x1, span_x_min[widest]);
+    area->x2 = LV_MIN(x2, span_x_max[widest]);
+    area->y1 = y1;
+    area->y2 = y2;
+    return true;
+}
+
+void RoundMask_InvalidateEventCb(lv_event_t *e) {
+    lv_area_t *area = (lv_area_t *)lv_event_get_param(e);
+    if (!area) return;
+
+    stats.inv_pixels_requested += lv_area_get_size(area);
+
+    lv_area_t trimmed = *area;
+    if (RoundMask_TrimArea(&trimmed)) {
+        *area = trimmed;
+    } else {
+        // LVGL can't drop an invalidation from this event, so shrink it to one
+        // visible pixel next to it instead of redrawing the invisible rectangle
+        const int32_t center = LCD_HEIGHT / 2;
+        int32_t y = LV_CLAMP(area->y1, center, area->y2);
+        int32_t x = LV_CLAMP(span_x_min[y], area->x1, span_x_max[y]);
+        area->x1 = area->x2 = x;
+        area->y1 = area->y2 = y;
+    }
+
+    stats.inv_pixels_kept += lv_area_get_size(area);
+}
+
+int RoundMask_SplitArea(const lv_area_t *area, lv_area_t *bands, int max_bands) {
+    round_band_t clipped = {
+        LV_MAX(area->x1, 0), LV_MAX(area->y1, 0),
+        LV_MIN(area->x2, LCD_WIDTH - 1), LV_MIN(area->y2, LCD_HEIGHT - 1)
+    };
+    if (clipped.x1 > clipped.x2 || clipped.y1 > clipped.y2) return 0;
+    if (!span_ready) {
+        bands[0] = { clipped.x1, clipped.y1, clipped.x2, clipped.y2 };
+        return 1;
+    }
+
+    round_band_t split[ROUND_MASK_MAX_BANDS];
+    if (max_bands > ROUND_MASK_MAX_BANDS) max_bands = ROUND_MASK_MAX_BANDS;
+    int count = RoundSpan_Split(span_x_min, span_x_max, LCD_HEIGHT, &clipped,
+                                ROUND_MASK_BAND_SLACK, split, max_bands);
+    for (int i = 0; i < count; i++) {
+        bands[i] = { split[i].x1, split[i].y1, split[i].x2, split[i].y2 };
+    }
+    return count;
+}
+
+int RoundMask_CompactFlush(const lv_area_t *area, uint8_t *px_map, lv_area_t *bands, int max_bands) {
+    int count = RoundMask_SplitArea(area, bands, max_bands);
+    if (count == 1 && bands[0].x1 == area->x1 && bands[0].x2 == area->x2 &&
+        bands[0].y1 == area->y1 && bands[0].y2 == area->y2) {
+        return count;
+    }
+
+    // Every band is at most as wide as the area, so the packed destination never
+    // overtakes the source and a forward memmove per row is safe
+    const int32_t px_size = sizeof(uint16_t);
+    const int32_t w = lv_area_get_width(area);
+    uint8_t *dst = px_map;
+    for (int i = 0; i < count; i++) {
+        int32_t band_w = lv_area_get_width(&bands[i]);
+        int32_t col_off = bands[i].x1 - area->x1;
+        for (int32_t y = bands[i].y1; y <= bands[i].y2; y++) {
+            const uint8_t *src = px_map + ((y - area->y1) * w + col_off) * px_size;
+            if (dst != src) memmove(dst, src, band_w * px_size);
+            dst += band_w * px_size;
+        }
+    }
+
+    stats.flushes_trimmed++;
+    stats.bands += count;
+    return count;
+}
+
+void RoundMask_CountFlush(const lv_area_t *requested, uint32_t sent_bytes, bool last) {
+    stats.flushes++;
+    stats.bytes_requested += lv_area_get_size(requested) * sizeof(uint16_t);
+    stats.bytes_sent += sent_bytes;
+    if (last) stats.frames++;
+}
+
+void RoundMask_GetStats(round_mask_stats_t *out) {
+    *out = stats;
+}
+
+void RoundMask_ResetStats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+void RoundMask_PrintStats(void) {
+    uint32_t frames = stats.frames ? stats.frames : 1;
+    uint64_t saved = stats.bytes_requested - stats.bytes_sent;
+    printf("[RoundMask] frames=%lu flushes=%lu trimmed=%lu bands=%lu\n",
+           (unsigned long)stats.frames, (unsigned long)stats.flushes,
+           (unsigned long)stats.flushes_trimmed, (unsigned long)stats.bands);
+    printf("[RoundMask] bytes/frame: requested=%lu sent=%lu saved=%lu (%lu%%)\n",
+           (unsigned long)(stats.bytes_requested / frames),
+           (unsigned long)(stats.bytes_sent / frames),
+           (unsigned long)(saved / frames),
+           (unsigned long)(stats.bytes_requested ? saved * 100 / stats.bytes_requested : 0));
+    printf("[RoundMask] invalidated pixels: requested=%llu kept=%llu\n",
+           (unsigned long long)stats.inv_pixels_requested,
+           (unsigned long long)stats.inv_pixels_kept);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+// ============================================
+// Round panel mask
+// ============================================
+// The 360x360 panel only shows a circle, about 21% of a full rectangle is
+// never visible. This module keeps a per-row [x_min, x_max] span table of the
+// visible circle (built by round_span). Invalidated areas are trimmed to it, and
+// flushes are split into bands of rows with similar spans, each sent as its own
+// narrower window, so fewer bytes go over QSPI.
+
+#include <lvgl.h>
+#include <stdint.h>
+#include <board_config.h>
+#include "round_span.h"
+
+// Set to 0 to push full rectangles as before
+#ifndef LCD_ROUND_CLIP
+#define LCD_ROUND_CLIP          1
+#endif
+
+// Extra pixels kept around the circle so anti-aliased edges are never cut
+#define ROUND_MASK_MARGIN       1
+
+typedef struct {
+    uint32_t frames;
+    uint32_t flushes;
+    uint32_t flushes_trimmed;       // flushes that were compacted to narrower bands
+    uint32_t bands;                 // windows those compacted flushes were sent as
+    uint64_t bytes_requested;       // what LVGL asked to flush
+    uint64_t bytes_sent;            // what actually went over QSPI
+    uint64_t inv_pixels_requested;  // invalidated area before trimming
+    uint64_t inv_pixels_kept;       // invalidated area after trimming
+} round_mask_stats_t;
+
+/**
+ * @brief Build the span table, call once before the display is used
+ */
+void RoundMask_Init(void);
+
+/**
+ * @brief Visible span of a panel row (inclusive), x_min > x_max if the row is empty
+ */
+void RoundMask_GetRowSpan(int32_t y, int32_t *x_min, int32_t *x_max);
+
+/**
+ * @brief Trim an area to the bounding box of its visible part
+ * @return false if no pixel of the area is visible (area is left unchanged)
+ */
+bool RoundMask_TrimArea(lv_area_t *area);
+
+/**
+ * @brief LV_EVENT_INVALIDATE_AREA handler that shrinks dirty areas to the circle
+ */
+void RoundMask_InvalidateEventCb(lv_event_t *e);
+
+/**
+ * @brief Split the visible part of an area into bands (see RoundSpan_Split)
+ * @param bands Output, room for `max_bands` (at most ROUND_MASK_MAX_BANDS used)
+ * @return number of bands, 0 if nothing of the area is visible
+ */
+int RoundMask_SplitArea(const lv_area_t *area, lv_area_t *bands, int max_bands);
+
+/**
+ * @brief Compact a rendered block in place to the visible bands of its rows
+ *
+ * The bands' pixels are packed back to back from the start of px_map, each
+ * with its own (narrower) stride, so band i can be sent as one window starting
+ * right after band i - 1. Only for buffers that LVGL does not read back after
+ * the flush (partial render mode).
+ *
+ * @param area     Area rendered in px_map
+ * @param px_map   RGB565 pixels, stride = area width
+ * @param bands    Output, room for `max_bands`
+ * @return number of bands, 0 if nothing of the area is visible (nothing needs to be sent)
+ */
+int RoundMask_CompactFlush(const lv_area_t *area, uint8_t *px_map, lv_area_t *bands, int max_bands);
+
+/**
+ * @brief Account one flush of `sent_bytes` for an area LVGL asked to flush
+ */
+void RoundMask_CountFlush(const lv_area_t *requested, uint32_t sent_bytes, bool last);
+
+void RoundMask_GetStats(round_mask_stats_t *stats);
+void RoundMask_ResetStats(void);
+void RoundMask_PrintStats(void);
@@ -0,0 +1,114 @@
+#include "round_span.h"
+
+uint32_t RoundSpan_Isqrt(uint32_t value) {
+    uint32_t result = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > value) bit >>= 2;
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+void RoundSpan_Build(int32_t width, int32_t height, int32_t margin, int16_t *x_min, int16_t *x_max) {
+    // Work in doubled coordinates so pixel centers (x + 0.5) stay integers:
+    // pixel x is visible if |2x + 1 - W| <= h, with h = sqrt((W + 2m)^2 - dy^2)
+    const int32_t diameter = width + 2 * margin;
+    const int32_t r2 = diameter * diameter;
+
+    for (int32_t y = 0; y < height; y++) {
+        int32_t dy = 2 * y + 1 - height;
+        int32_t rem = r2 - dy * dy;
+        if (rem < 0) {
+            x_min[y] = 1;
+            x_max[y] = 0;
+            continue;
+        }
+        int32_t h = (int32_t)RoundSpan_Isqrt((uint32_t)rem);
+        // x >= (W - 1 - h) / 2 rounded up, x <= (W - 1 + h) / 2 rounded down
+        int32_t lo = width - 1 - h;
+        int32_t lo_x = lo <= 0 ? 0 : (lo + 1) / 2;
+        int32_t hi_x = (width - 1 + h) / 2;
+        if (hi_x > width - 1) hi_x = width - 1;
+        x_min[y] = (int16_t)lo_x;
+        x_max[y] = (int16_t)hi_x;
+    }
+}
+
+// One pass with a fixed slack, -1 if it needs more than max_bands
+static int split_pass(const int16_t *x_min, const int16_t *x_max, int32_t height,
+                      const round_band_t *area, int32_t slack,
+                      round_band_t *bands, int max_bands) {
+    int count = 0;
+    round_band_t *band = nullptr;
+    int32_t band_min_w = 0;
+
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        if (y < 0 || y >= height) continue;
+        int32_t a = x_min[y] > area->x1 ? x_min[y] : area->x1;
+        int32_t b = x_max[y] < area->x2 ? x_max[y] : area->x2;
+        if (a > b) {
+            band = nullptr;
+            continue;
+        }
+
+        if (band) {
+            int32_t lo = a < band->x1 ? a : band->x1;
+            int32_t hi = b > band->x2 ? b : band->x2;
+            int32_t min_w = b - a + 1 < band_min_w ? b - a + 1 : band_min_w;
+            if ((hi - lo + 1) - min_w <= slack) {
+                band->x1 = lo;
+                band->x2 = hi;
+                band->y2 = y;
+                band_min_w = min_w;
+                continue;
+            }
+        }
+
+        if (count == max_bands) return -1;
+        band = &bands[count++];
+        band->x1 = a;
+        band->x2 = b;
+        band->y1 = band->y2 = y;
+        band_min_w = b - a + 1;
+    }
+    return count;
+}
+
+int RoundSpan_Split(const int16_t *x_min, const int16_t *x_max, int32_t height,
+                    const round_band_t *area, int32_t slack,
+                    round_band_t *bands, int max_bands) {
+    if (max_bands < 1) return 0;
+    if (slack < 1) slack = 1;
+
+    // A circle is convex, so at the latest a slack of the area width gives one band
+    const int32_t widest = area->x2 - area->x1 + 1;
+    for (;;) {
+        int count = split_pass(x_min, x_max, height, area, slack, bands, max_bands);
+        if (count >= 0) return count;
+        if (slack > widest) break;
+        slack *= 2;
+    }
+
+    // Only reached for a table with gaps: one bounding box of every visible row
+    round_band_t all = { area->x2 + 1, -1, area->x1 - 1, -1 };
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        if (y < 0 || y >= height) continue;
+        int32_t a = x_min[y] > area->x1 ? x_min[y] : area->x1;
+        int32_t b = x_max[y] < area->x2 ? x_max[y] : area->x2;
+        if (a > b) continue;
+        if (all.y1 < 0) all.y1 = y;
+        all.y2 = y;
+        if (a < all.x1) all.x1 = a;
+        if (b > all.x2) all.x2 = b;
+    }
+    if (all.y1 < 0) return 0;
+    bands[0] = all;
+    return 1;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+// ============================================
+// Round panel span table and band splitting
+// ============================================
+// The integer math behind round_mask: the per-row [x_min, x_max] table of the
+// visible circle and the split of a rectangle into bands of rows with similar
+// spans. No LVGL or ESP-IDF dependencies, so it also builds for the host tests.
+
+#include <stdint.h>
+
+// A band may be this many pixels wider than its narrowest row before a new band
+// starts. Smaller sends fewer bytes, but every extra band is one more window whose
+// transfer the flush has to wait for.
+#ifndef ROUND_MASK_BAND_SLACK
+#define ROUND_MASK_BAND_SLACK   32
+#endif
+
+// Most windows one flush is split into
+#ifndef ROUND_MASK_MAX_BANDS
+#define ROUND_MASK_MAX_BANDS    4
+#endif
+
+// Inclusive rectangle, same layout as lv_area_t
+typedef struct {
+    int32_t x1;
+    int32_t y1;
+    int32_t x2;
+    int32_t y2;
+} round_band_t;
+
+/**
+ * @brief Integer square root, floor(sqrt(value))
+ */
+uint32_t RoundSpan_Isqrt(uint32_t value);
+
+/**
+ * @brief Fill the visible span of each row of a width x height circle
+ *
+ * A pixel is visible when its center lies inside the circle grown by `margin`
+ * pixels. Rows with nothing visible get x_min > x_max.
+ */
+void RoundSpan_Build(int32_t width, int32_t height, int32_t margin, int16_t *x_min, int16_t *x_max);
+
+/**
+ * @brief Split the visible part of a rectangle into bands
+ *
+ * Consecutive rows are grouped while the band stays within `slack` pixels of
+ * the width of its narrowest row; each band is the bounding box of its rows'
+ * visible spans. When that needs more than `max_bands` bands the slack is
+ * doubled until it fits.
+ *
+ * @param x_min, x_max Span table from RoundSpan_Build, `height` rows
+ * @param area         Rectangle to split, already inside the panel
+ * @return number of bands written, 0 if nothing of the area is visible
+ */
+int RoundSpan_Split(const int16_t *x_min, const int16_t *x_max, int32_t height,
+                    const round_band_t *area, int32_t slack,
+                    round_band_t *bands, int max_bands);
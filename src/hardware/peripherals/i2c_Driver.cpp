@@ -4,38 +4,35 @@
  */
 
 #include "I2C_Driver.h"
+#include "i2c_bus.h"
+#include "tca9554_power.h"
+#include "hardware/touch/touch_cst816.h"
 
 void I2C_Init(void) {
-  // Initialize I2C bus with specified SDA and SCL pins
-  Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN);
+  // Main bus (SDA/SCL from board_config.h), owned by the bus task from here on
+  i2c_bus_init(I2C_BUS_CLOCK_HZ);
+
+  // Touch reads go ahead of expander and other traffic
+#if defined(BOARD_1_85C)
+  i2c_bus_set_device_priority(CST816_ADDR, I2C_PRIO_HIGH);
+#endif
+  i2c_bus_set_device_priority(TCA9554_ADDRESS, I2C_PRIO_NORMAL);
 }
 
 
 bool I2C_Read(uint8_t Driver_addr, uint8_t Reg_addr, uint8_t *Reg_data, uint32_t Length)
 {
-  Wire.beginTransmission(Driver_addr);
-  Wire.write(Reg_addr); 
-  if ( Wire.endTransmission(true)){
+  if (!i2c_bus_read_reg(Driver_addr, Reg_addr, Reg_data, Length)) {
     printf("The I2C transmission fails. - I2C Read\r\n");
-    return -1;
-  }
-  Wire.requestFrom(Driver_addr, Length);
-  for (int i = 0; i < Length; i++) {
-    *Reg_data++ = Wire.read();
+    return false;
   }
-  return 0;
+  return true;
 }
 bool I2C_Write(uint8_t Driver_addr, uint8_t Reg_addr, const uint8_t *Reg_data, uint32_t Length)
 {
-  Wire.beginTransmission(Driver_addr);
-  Wire.write(Reg_addr);       
-  for (int i = 0; i < Length; i++) {
-    Wire.write(*Reg_data++);
-  }
-  if ( Wire.endTransmission(true))
-  {
+  if (!i2c_bus_write_reg(Driver_addr, Reg_addr, Reg_data, Length)) {
     printf("The I2C transmission fails. - I2C Write\r\n");
-    return -1;
+    return false;
   }
-  return 0;
+  return true;
 }
\ No newline at end of file
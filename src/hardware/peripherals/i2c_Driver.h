@@ -5,8 +5,9 @@
 /**
  * @brief Initialize I2C bus for peripheral communication
  * 
- * Configures I2C pins and starts Wire library for communication
- * with touch controller, GPIO expander, and other peripherals.
+ * Starts the queued bus manager (i2c_bus.h) on the main bus at
+ * I2C_BUS_CLOCK_HZ for the touch controller, GPIO expander, and other
+ * peripherals, and sets the per-device priorities (touch first).
  * Uses pin definitions from board_config.h to support different hardware variants.
  */
 void I2C_Init(void);
@@ -0,0 +1,352 @@
+// ============================================
+// Own Header (first!)
+// ============================================
+#include "i2c_bus.h"
+
+// ============================================
+// System & Framework Headers
+// ============================================
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include <Arduino.h>
+#include <Wire.h>
+#include <esp_timer.h>
+#include "board_config.h"
+#else
+#include <time.h>
+#endif
+
+// ============================================
+// Hardware Layer
+// ============================================
+#include "i2c_bus_mock.h"
+
+static const I2cBackend *bus_backend = nullptr;
+static uint32_t bus_clock_hz = 0;
+static I2cDeviceStats devices[I2C_BUS_MAX_DEVICES];
+static size_t device_count = 0;
+
+#ifdef ESP_PLATFORM
+static TaskHandle_t bus_task_handle = nullptr;
+static QueueHandle_t queues[I2C_PRIO_COUNT];
+static SemaphoreHandle_t work_sem = nullptr;      // one count per queued transaction
+static portMUX_TYPE device_lock = portMUX_INITIALIZER_UNLOCKED;
+#define DEVICE_LOCK()    portENTER_CRITICAL(&device_lock)
+#define DEVICE_UNLOCK()  portEXIT_CRITICAL(&device_lock)
+#else
+// Single threaded on the host; the queues are only used while the bus is held
+static I2cTransaction *host_queues[I2C_PRIO_COUNT][I2C_BUS_QUEUE_LENGTH];
+static size_t host_queue_head[I2C_PRIO_COUNT];
+static size_t host_queue_count[I2C_PRIO_COUNT];
+static bool host_hold = false;
+#define DEVICE_LOCK()
+#define DEVICE_UNLOCK()
+#endif
+
+static int64_t now_us() {
+#ifdef ESP_PLATFORM
+  return esp_timer_get_time();
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+// ============================================
+// Wire backend
+// ============================================
+#ifdef ESP_PLATFORM
+static bool wire_begin(uint32_t clock_hz) {
+  return Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN, clock_hz);
+}
+
+static I2cResult wire_transfer(uint8_t addr, const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len) {
+  if (tx_len) {
+    Wire.beginTransmission(addr);
+    Wire.write(tx, tx_len);
+    if (Wire.endTransmission(true)) return I2C_ERR_NACK;
+  }
+  if (rx_len) {
+    size_t got = Wire.requestFrom(addr, rx_len);
+    for (size_t i = 0; i < got; i++) {
+      rx[i] = Wire.read();
+    }
+    if (got != rx_len) return I2C_ERR_READ;
+  }
+  return I2C_OK;
+}
+
+static const I2cBackend wire_backend = { "wire", wire_begin, wire_transfer };
+#endif
+
+// ============================================
+// Devices
+// ============================================
+static I2cDeviceStats *device_get(uint8_t addr) {
+  for (size_t i = 0; i < device_count; i++) {
+    if (devices[i].addr == addr) return &devices[i];
+  }
+  if (device_count == I2C_BUS_MAX_DEVICES) return nullptr;
+  I2cDeviceStats *dev = &devices[device_count++];
+  memset(dev, 0, sizeof(*dev));
+  dev->addr = addr;
+  dev->prio = I2C_PRIO_NORMAL;
+  return dev;
+}
+
+static void time_add(I2cTimeStat *stat, int64_t us) {
+  stat->sum_us += (uint64_t)us;
+  if ((uint32_t)us > stat->max_us) stat->max_us = (uint32_t)us;
+}
+
+// Runs the transfer; t must not be touched after done() was called
+static void execute(I2cTransaction *t) {
+  int64_t start = now_us();
+  I2cResult result = bus_backend->transfer(t->addr, t->tx, t->tx_len, t->rx, t->rx_len);
+  int64_t end = now_us();
+
+  DEVICE_LOCK();
+  I2cDeviceStats *dev = device_get(t->addr);
+  if (dev) {
+    dev->transactions++;
+    if (result != I2C_OK) dev->errors++;
+    dev->bytes += t->tx_len + t->rx_len;
+    time_add(&dev->wait, start - t->submit_us);
+    time_add(&dev->bus, end - start);
+  }
+  DEVICE_UNLOCK();
+
+  i2c_done_cb_t done = t->done;
+  t->result = result;
+  if (done) done(t);
+}
+
+#ifdef ESP_PLATFORM
+static void bus_task(void *arg) {
+  for (;;) {
+    xSemaphoreTake(work_sem, portMAX_DELAY);
+    // Highest priority first; the count guarantees one of the queues has an entry
+    I2cTransaction *t = nullptr;
+    for (int p = 0; p < I2C_PRIO_COUNT && !t; p++) {
+      if (xQueueReceive(queues[p], &t, 0) != pdTRUE) t = nullptr;
+    }
+    if (t) execute(t);
+  }
+}
+#endif
+
+// ============================================
+// Public API
+// ============================================
+bool i2c_bus_init(uint32_t clock_hz, const I2cBackend *backend) {
+  if (bus_backend) return true;
+
+#ifdef ESP_PLATFORM
+  if (!backend) backend = &wire_backend;
+#else
+  if (!backend) backend = i2c_mock_backend();
+#endif
+  if (!backend->begin(clock_hz)) {
+    printf("[I2C] %s backend failed to start\n", backend->name);
+    return false;
+  }
+  bus_clock_hz = clock_hz;
+
+#ifdef ESP_PLATFORM
+  work_sem = xSemaphoreCreateCounting(I2C_PRIO_COUNT * I2C_BUS_QUEUE_LENGTH, 0);
+  for (int p = 0; p < I2C_PRIO_COUNT; p++) {
+    queues[p] = xQueueCreate(I2C_BUS_QUEUE_LENGTH, sizeof(I2cTransaction *));
+  }
+  if (xTaskCreatePinnedToCore(bus_task, "i2c", I2C_BUS_TASK_STACK_SIZE, nullptr,
+                              I2C_BUS_TASK_PRIORITY, &bus_task_handle, I2C_BUS_TASK_CORE) != pdPASS) {
+    printf("[I2C] Failed to create bus task, transfers run in the caller\n");
+    bus_task_handle = nullptr;
+  }
+#endif
+  bus_backend = backend;
+  printf("[I2C] Bus at %lu kHz (%s)\n", (unsigned long)(clock_hz / 1000), backend->name);
+  return true;
+}
+
+void i2c_bus_set_device_priority(uint8_t addr, I2cPriority prio) {
+  if (prio >= I2C_PRIO_COUNT) return;
+  DEVICE_LOCK();
+  I2cDeviceStats *dev = device_get(addr);
+  if (dev) dev->prio = prio;
+  DEVICE_UNLOCK();
+}
+
+static I2cPriority device_priority(uint8_t addr) {
+  DEVICE_LOCK();
+  I2cDeviceStats *dev = device_get(addr);
+  I2cPriority prio = dev ? dev->prio : I2C_PRIO_NORMAL;
+  DEVICE_UNLOCK();
+  return prio;
+}
+
+void i2c_transaction_read_reg(I2cTransaction *t, uint8_t addr, uint8_t reg, uint8_t *rx, size_t len) {
+  memset(t, 0, sizeof(*t));
+  t->addr = addr;
+  t->tx[0] = reg;
+  t->tx_len = 1;
+  t->rx = rx;
+  t->rx_len = len;
+}
+
+bool i2c_transaction_write_reg(I2cTransaction *t, uint8_t addr, uint8_t reg, const uint8_t *data, size_t len) {
+  memset(t, 0, sizeof(*t));
+  if (len >= I2C_BUS_MAX_WRITE) {
+    t->result = I2C_ERR_ARG;
+    return false;
+  }
+  t->addr = addr;
+  t->tx[0] = reg;
+  if (len) memcpy(&t->tx[1], data, len);
+  t->tx_len = (uint8_t)(len + 1);
+  return true;
+}
+
+static bool submit(I2cTransaction *t, bool wait_for_space) {
+  if (!t || (t->tx_len == 0 && t->rx_len == 0) || t->tx_len > I2C_BUS_MAX_WRITE) {
+    if (t) t->result = I2C_ERR_ARG;
+    return false;
+  }
+  if (!bus_backend) {
+    t->result = I2C_ERR_QUEUE;
+    return false;
+  }
+  t->result = I2C_PENDING;
+  t->submit_us = now_us();
+
+#ifdef ESP_PLATFORM
+  if (bus_task_handle && xTaskGetCurrentTaskHandle() != bus_task_handle) {
+    I2cPriority prio = device_priority(t->addr);
+    if (xQueueSend(queues[prio], &t, wait_for_space ? portMAX_DELAY : 0) != pdTRUE) {
+      t->result = I2C_ERR_QUEUE;
+      return false;
+    }
+    xSemaphoreGive(work_sem);
+    return true;
+  }
+#else
+  if (host_hold && !wait_for_space) {
+    I2cPriority prio = device_priority(t->addr);
+    if (host_queue_count[prio] == I2C_BUS_QUEUE_LENGTH) {
+      t->result = I2C_ERR_QUEUE;
+      return false;
+    }
+    host_queues[prio][(host_queue_head[prio] + host_queue_count[prio]) % I2C_BUS_QUEUE_LENGTH] = t;
+    host_queue_count[prio]++;
+    return true;
+  }
+#endif
+  // No bus task (host, or a done callback submitting more): run it right here
+  execute(t);
+  return true;
+}
+
+bool i2c_bus_submit(I2cTransaction *t) {
+  return submit(t, false);
+}
+
+#ifdef ESP_PLATFORM
+static void give_done_sem(I2cTransaction *t) {
+  xSemaphoreGive((SemaphoreHandle_t)t->user);
+}
+#endif
+
+static bool run_blocking(I2cTransaction *t) {
+#ifdef ESP_PLATFORM
+  StaticSemaphore_t sem_buf;
+  SemaphoreHandle_t sem = xSemaphoreCreateBinaryStatic(&sem_buf);
+  t->done = give_done_sem;
+  t->user = sem;
+  if (submit(t, true)) xSemaphoreTake(sem, portMAX_DELAY);
+  vSemaphoreDelete(sem);
+#else
+  if (!submit(t, true)) return false;
+#endif
+  return t->result == I2C_OK;
+}
+
+bool i2c_bus_read_reg(uint8_t addr, uint8_t reg, uint8_t *data, size_t len) {
+  I2cTransaction t;
+  i2c_transaction_read_reg(&t, addr, reg, data, len);
+  return run_blocking(&t);
+}
+
+bool i2c_bus_write_reg(uint8_t addr, uint8_t reg, const uint8_t *data, size_t len) {
+  I2cTransaction t;
+  if (!i2c_transaction_write_reg(&t, addr, reg, data, len)) return false;
+  return run_blocking(&t);
+}
+
+void i2c_bus_print_stats(void) {
+  static const char *prio_names[I2C_PRIO_COUNT] = { "high", "normal", "low" };
+
+  if (!bus_backend) {
+    printf("[I2C] Bus not initialized\n");
+    return;
+  }
+  printf("[I2C] %s backend, %lu kHz\n", bus_backend->name, (unsigned long)(bus_clock_hz / 1000));
+  for (size_t i = 0; i < device_count; i++) {
+    const I2cDeviceStats *dev = &devices[i];
+    if (dev->transactions == 0) {
+      printf("[I2C] 0x%02x %-6s no transactions\n", dev->addr, prio_names[dev->prio]);
+      continue;
+    }
+    printf("[I2C] 0x%02x %-6s %6lu tx %4lu err %7lu bytes | wait avg %5lu max %6lu us | bus avg %5lu max %6lu us\n",
+           dev->addr, prio_names[dev->prio], (unsigned long)dev->transactions,
+           (unsigned long)dev->errors, (unsigned long)dev->bytes,
+           (unsigned long)(dev->wait.sum_us / dev->transactions), (unsigned long)dev->wait.max_us,
+           (unsigned long)(dev->bus.sum_us / dev->transactions), (unsigned long)dev->bus.max_us);
+  }
+}
+
+void i2c_bus_reset_stats(void) {
+  DEVICE_LOCK();
+  for (size_t i = 0; i < device_count; i++) {
+    I2cPriority prio = devices[i].prio;
+    uint8_t addr = devices[i].addr;
+    memset(&devices[i], 0, sizeof(devices[i]));
+    devices[i].addr = addr;
+    devices[i].prio = prio;
+  }
+  DEVICE_UNLOCK();
+}
+
+bool i2c_bus_get_stats(uint8_t addr, I2cDeviceStats *stats) {
+  bool found = false;
+  DEVICE_LOCK();
+  for (size_t i = 0; i < device_count; i++) {
+    if (devices[i].addr == addr) {
+      *stats = devices[i];
+      found = true;
+      break;
+    }
+  }
+  DEVICE_UNLOCK();
+  return found;
+}
+
+#ifndef ESP_PLATFORM
+void i2c_bus_hold(bool hold) {
+  host_hold = hold;
+  if (hold) return;
+  // Same order as the bus task: always the highest priority queue first
+  for (;;) {
+    I2cTransaction *t = nullptr;
+    for (int p = 0; p < I2C_PRIO_COUNT && !t; p++) {
+      if (host_queue_count[p] == 0) continue;
+      t = host_queues[p][host_queue_head[p]];
+      host_queue_head[p] = (host_queue_head[p] + 1) % I2C_BUS_QUEUE_LENGTH;
+      host_queue_count[p]--;
+    }
+    if (!t) break;
+    execute(t);
+  }
+}
+#endif
@@ -0,0 +1,159 @@
+/**
+ * @file i2c_bus.h
+ * @brief Queued I2C bus shared by touch, the GPIO expander and other devices
+ *
+ * Every transfer on the main bus goes through one bus task, which owns the
+ * Wire driver. Transactions wait in per-priority queues (touch first) and
+ * report completion through a callback or their status field, so callers
+ * never have to block; the blocking helpers are built on top. Per-device
+ * counters record queue wait and bus time of every transaction.
+ *
+ * The transfer itself is a backend: Wire on the ESP32, a register-file
+ * mock (i2c_bus_mock.h) on the host, where transactions run synchronously
+ * in the caller unless the bus is held (i2c_bus_hold).
+ */
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/// Bus clock, both the CST816 and the TCA9554 support fast mode
+#ifndef I2C_BUS_CLOCK_HZ
+#define I2C_BUS_CLOCK_HZ      400000
+#endif
+
+/// Bytes a transaction can write, register address included
+#define I2C_BUS_MAX_WRITE     16
+/// Devices with their own priority and stats
+#define I2C_BUS_MAX_DEVICES   8
+/// Pending transactions per priority
+#define I2C_BUS_QUEUE_LENGTH  8
+
+#define I2C_BUS_TASK_CORE        1
+#define I2C_BUS_TASK_STACK_SIZE  3072
+/// Above the touch input task, a transfer is short and everybody waits for it
+#define I2C_BUS_TASK_PRIORITY    5
+
+enum I2cPriority {
+  I2C_PRIO_HIGH = 0,    ///< touch
+  I2C_PRIO_NORMAL,      ///< GPIO expander, default for unknown devices
+  I2C_PRIO_LOW,         ///< sensors, bulk reads
+  I2C_PRIO_COUNT
+};
+
+enum I2cResult {
+  I2C_OK = 0,
+  I2C_PENDING,
+  I2C_ERR_NACK,         ///< address or data not acknowledged
+  I2C_ERR_READ,         ///< device returned fewer bytes than requested
+  I2C_ERR_QUEUE,        ///< queue full or bus not initialized
+  I2C_ERR_ARG
+};
+
+struct I2cTimeStat {
+  uint64_t sum_us;
+  uint32_t max_us;
+};
+
+/**
+ * @brief Counters of one device, see i2c_bus_get_stats()
+ */
+struct I2cDeviceStats {
+  uint8_t addr;
+  I2cPriority prio;
+  uint32_t transactions;
+  uint32_t errors;
+  uint32_t bytes;       ///< written and read, register addresses included
+  I2cTimeStat wait;     ///< submit to start of transfer
+  I2cTimeStat bus;      ///< transfer itself
+};
+
+/**
+ * @brief Transfer backend, runs on the bus task
+ */
+struct I2cBackend {
+  const char *name;
+  bool (*begin)(uint32_t clock_hz);
+  /// Write tx (if any), then read rx (if any), stop after each part
+  I2cResult (*transfer)(uint8_t addr, const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len);
+};
+
+struct I2cTransaction;
+typedef void (*i2c_done_cb_t)(I2cTransaction *t);
+
+/**
+ * @brief One queued transfer, owned by the caller until it completed
+ */
+struct I2cTransaction {
+  uint8_t addr;
+  uint8_t tx[I2C_BUS_MAX_WRITE];
+  uint8_t tx_len;
+  uint8_t *rx;
+  size_t rx_len;
+  i2c_done_cb_t done;   ///< called on the bus task, may be null
+  void *user;
+  volatile I2cResult result;
+  int64_t submit_us;
+};
+
+/**
+ * @brief Start the bus and its task
+ * @param clock_hz Bus clock
+ * @param backend Transfer backend, null for the platform default (Wire, or the mock on the host)
+ */
+bool i2c_bus_init(uint32_t clock_hz = I2C_BUS_CLOCK_HZ, const I2cBackend *backend = nullptr);
+
+/**
+ * @brief Queue priority of a device, transactions to it inherit it
+ */
+void i2c_bus_set_device_priority(uint8_t addr, I2cPriority prio);
+
+/**
+ * @brief Prepare a register read: write reg, then read len bytes into rx
+ */
+void i2c_transaction_read_reg(I2cTransaction *t, uint8_t addr, uint8_t reg, uint8_t *rx, size_t len);
+
+/**
+ * @brief Prepare a register write of len bytes (at most I2C_BUS_MAX_WRITE - 1)
+ * @return false if data does not fit
+ */
+bool i2c_transaction_write_reg(I2cTransaction *t, uint8_t addr, uint8_t reg, const uint8_t *data, size_t len);
+
+/**
+ * @brief Queue a transaction, never blocks
+ *
+ * t->result stays I2C_PENDING until the transfer is done, then t->done is
+ * called. t (and rx) must stay valid until then.
+ * @return false if it could not be queued (t->result says why)
+ */
+bool i2c_bus_submit(I2cTransaction *t);
+
+/**
+ * @brief Blocking register read/write, safe from any task
+ * @return true on success
+ */
+bool i2c_bus_read_reg(uint8_t addr, uint8_t reg, uint8_t *data, size_t len);
+bool i2c_bus_write_reg(uint8_t addr, uint8_t reg, const uint8_t *data, size_t len);
+
+/**
+ * @brief Per-device transaction counts, queue wait and bus time
+ */
+void i2c_bus_print_stats(void);
+void i2c_bus_reset_stats(void);
+
+/**
+ * @brief Copy the counters of a device
+ * @return false if no transaction or priority was ever recorded for addr
+ */
+bool i2c_bus_get_stats(uint8_t addr, I2cDeviceStats *stats);
+
+#ifndef ESP_PLATFORM
+/**
+ * @brief Host only: hold back queued transactions like a busy bus task
+ *
+ * While held, i2c_bus_submit() puts transactions into the priority queues
+ * (I2C_ERR_QUEUE when one is full); releasing runs them highest priority
+ * first. The blocking helpers still run right away.
+ */
+void i2c_bus_hold(bool hold);
+#endif
@@ -0,0 +1,59 @@
+/**
+ * @file i2c_bus_mock.h
+ * @brief Register-file I2C backend for running drivers without hardware
+ *
+ * Each mock device is 256 registers with an auto-incrementing register
+ * pointer, like the CST816 and the TCA9554: a write sets the pointer from
+ * its first byte and stores the rest, a read returns registers from the
+ * pointer on. Transfers are counted per device and the time they would
+ * take on the wire at the configured clock is accumulated, so driver
+ * changes can be compared by transaction count and bus time on the host.
+ * In real-time mode a transfer also takes that long, so the bus stats of
+ * i2c_bus measure it.
+ */
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "i2c_bus.h"
+
+#define I2C_MOCK_MAX_DEVICES  4
+
+struct I2cMockDevice {
+  uint8_t addr;
+  uint8_t regs[256];
+  uint8_t pointer;
+  bool nack;              ///< fail every transfer, e.g. a missing device
+  uint32_t writes;        ///< write transfers (register pointer set included)
+  uint32_t reads;         ///< read transfers
+  uint64_t wire_ns;       ///< wire time of the transfers to this device
+  /// Called after a write with the first register written, for devices with side effects
+  void (*on_write)(I2cMockDevice *dev, uint8_t reg, size_t len);
+};
+
+/**
+ * @brief Backend to pass to i2c_bus_init(), the default on the host
+ */
+const I2cBackend *i2c_mock_backend(void);
+
+/**
+ * @brief Add a device (or get the existing one) at addr, registers start zeroed
+ */
+I2cMockDevice *i2c_mock_add_device(uint8_t addr);
+I2cMockDevice *i2c_mock_get_device(uint8_t addr);
+
+/**
+ * @brief Wire time of all transfers so far, start/stop and ack bits included
+ */
+uint64_t i2c_mock_bus_time_us(void);
+
+/**
+ * @brief Zero the transfer counters and the bus time, devices stay
+ */
+void i2c_mock_reset_counters(void);
+
+/**
+ * @brief Spin for the wire time of every transfer (off by default)
+ */
+void i2c_mock_set_realtime(bool on);
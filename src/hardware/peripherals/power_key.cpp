@@ -14,6 +14,7 @@
 // Core System
 // ============================================
 #include "core/state_manager.h"
+#include "core/persistence.h"
 
 // ============================================
 // Hardware (related modules)
@@ -74,6 +75,9 @@ void wake_up(void)
 
 void fall_asleep(void)
 {
+    // Settings and life totals still waiting for the write-behind worker
+    persistence_flush();
+
     // Power down display and touch
     // ### KORREKTUR: Alten Code durch neuen Treiber-Aufruf ersetzen ###
     Set_Backlight(0); // Schaltet die Hintergrundbeleuchtung aus
@@ -1,25 +1,118 @@
 #include "tca9554_power.h"
+#include "i2c_bus.h"
+#include "board_config.h"
 
-/*****************************************************  Operation register REG   ****************************************************/   
-uint8_t Read_REG(uint8_t REG)                             // Read the value of the TCA9554PWR register REG
+#ifdef ESP_PLATFORM
+#include <Arduino.h>
+#endif
+
+// Register access is shared by the display reset (setup) and the touch reset
+// (boot bring-up on the other core). The recursive lock keeps each
+// read-modify-write of a register and its shadow copy atomic.
+#ifdef ESP_PLATFORM
+static SemaphoreHandle_t exio_mutex = NULL;
+#endif
+
+// Shadow copies of the write-only-by-us registers. The expander only changes
+// them when we write, so after init every pin update is a single write and
+// reading the output or mode state costs no I2C at all.
+static uint8_t shadow_output = 0xFF;                      // Power-on defaults
+static uint8_t shadow_polarity = 0x00;
+static uint8_t shadow_config = 0xFF;
+static bool shadow_valid = false;
+
+// Input register cache, refreshed only after the INT line reported a change
+static uint8_t cached_input = 0;
+static volatile bool input_dirty = true;
+static bool int_attached = false;
+
+static TCA9554Stats exio_stats;
+
+#ifdef ESP_PLATFORM
+static void exio_lock()
 {
-  Wire.beginTransmission(TCA9554_ADDRESS);                
-  Wire.write(REG);                                        
-  uint8_t result = Wire.endTransmission();               
-  if (result != 0) {                                     
+  if (exio_mutex) xSemaphoreTakeRecursive(exio_mutex, portMAX_DELAY);
+}
+
+static void exio_unlock()
+{
+  if (exio_mutex) xSemaphoreGiveRecursive(exio_mutex);
+}
+
+static void ARDUINO_ISR_ATTR exio_int_isr()
+{
+  input_dirty = true;
+}
+#else
+// Single threaded on the host
+static void exio_lock() {}
+static void exio_unlock() {}
+
+void TCA9554_SimulateInt(void)
+{
+  input_dirty = true;
+}
+#endif
+
+static uint8_t *shadow_for(uint8_t REG)
+{
+  switch (REG) {
+    case TCA9554_OUTPUT_REG:   return &shadow_output;
+    case TCA9554_Polarity_REG: return &shadow_polarity;
+    case TCA9554_CONFIG_REG:   return &shadow_config;
+    default:                   return NULL;
+  }
+}
+
+// Write a shadowed register if the value changed, one I2C transaction
+static uint8_t update_REG(uint8_t REG, uint8_t Data)
+{
+  uint8_t *shadow = shadow_for(REG);
+  exio_lock();
+  if (shadow_valid && shadow && *shadow == Data) {
+    exio_stats.writes_skipped++;
+    exio_unlock();
+    return 0;
+  }
+  uint8_t result = Write_REG(REG, Data);
+  exio_unlock();
+  return result;
+}
+
+static bool read_REG_checked(uint8_t REG, uint8_t *value)
+{
+  *value = 0;
+  exio_lock();
+  exio_stats.reads++;
+  bool ok = i2c_bus_read_reg(TCA9554_ADDRESS, REG, value, 1);
+  if (!ok) {
     printf("Data Transfer Failure !!!\r\n");
+  } else if (REG == TCA9554_INPUT_REG) {
+    // Reading the input register also clears the INT line
+    cached_input = *value;
   }
-  Wire.requestFrom(TCA9554_ADDRESS, 1);                   
-  uint8_t bitsStatus = Wire.read();                        
+  exio_unlock();
+  return ok;
+}
+
+/*****************************************************  Operation register REG   ****************************************************/   
+uint8_t Read_REG(uint8_t REG)                             // Read the value of the TCA9554PWR register REG
+{
+  uint8_t bitsStatus;
+  read_REG_checked(REG, &bitsStatus);
   return bitsStatus;                                     
 }
 uint8_t Write_REG(uint8_t REG,uint8_t Data)              // Write Data to the REG register of the TCA9554PWR
 {
-  Wire.beginTransmission(TCA9554_ADDRESS);                
-  Wire.write(REG);                                        
-  Wire.write(Data);                                       
-  uint8_t result = Wire.endTransmission();                  
-  if (result != 0) {    
+  exio_lock();
+  exio_stats.writes++;
+  bool ok = i2c_bus_write_reg(TCA9554_ADDRESS, REG, &Data, 1);
+  uint8_t *shadow = shadow_for(REG);
+  if (ok && shadow) *shadow = Data;
+  // Output pins read back their new level without raising INT
+  input_dirty = true;
+  exio_unlock();
+  if (!ok) {    
     printf("Data write failure!!!\r\n");
     return -1;
   }
@@ -28,66 +121,157 @@ uint8_t Write_REG(uint8_t REG,uint8_t Data)              // Write Data to the RE
 /********************************************************** Set EXIO mode **********************************************************/       
 void Mode_EXIO(uint8_t Pin,uint8_t State)                 // Set the mode of the TCA9554PWR Pin. The default is Output mode (output mode or input mode). State: 0= Output mode 1= input mode   
 {
-  uint8_t bitsStatus = Read_REG(TCA9554_CONFIG_REG);      
-  uint8_t Data = (0x01 << (Pin-1)) | bitsStatus;   
-  uint8_t result = Write_REG(TCA9554_CONFIG_REG,Data); 
-  if (result != 0) { 
-    printf("I/O Configuration Failure !!!\r\n");
+  if (Pin < 1 || Pin > 8) {
+    printf("Parameter error, please enter the correct parameter!\r\n");
+    return;
   }
+  uint8_t mask = 0x01 << (Pin-1);
+  Mode_EXIO_Mask(mask, State ? mask : 0);
 }
 void Mode_EXIOS(uint8_t PinState)                         // Set the mode of the 7 pins from the TCA9554PWR with PinState   
 {
-  uint8_t result = Write_REG(TCA9554_CONFIG_REG,PinState);  
+  uint8_t result = update_REG(TCA9554_CONFIG_REG,PinState);  
   if (result != 0) {   
     printf("I/O Configuration Failure !!!\r\n");
   }
 }
+void Mode_EXIO_Mask(uint8_t Mask,uint8_t Modes)           // Set the mode of all pins in Mask at once, 1 bits in Modes = input mode
+{
+  exio_lock();
+  uint8_t current = shadow_valid ? shadow_config : Read_REG(TCA9554_CONFIG_REG);
+  uint8_t Data = (current & ~Mask) | (Modes & Mask);
+  uint8_t result = update_REG(TCA9554_CONFIG_REG,Data); 
+  exio_unlock();
+  if (result != 0) { 
+    printf("I/O Configuration Failure !!!\r\n");
+  }
+}
 /********************************************************** Read EXIO status **********************************************************/       
 uint8_t Read_EXIO(uint8_t Pin)                            // Read the level of the TCA9554PWR Pin
 {
-  uint8_t inputBits = Read_REG(TCA9554_INPUT_REG);          
+  uint8_t inputBits = Read_EXIOS(TCA9554_INPUT_REG);          
   uint8_t bitStatus = (inputBits >> (Pin-1)) & 0x01; 
   return bitStatus;                                  
 }
 uint8_t Read_EXIOS(uint8_t REG = TCA9554_INPUT_REG)       // Read the level of all pins of TCA9554PWR, the default read input level state, want to get the current IO output state, pass the parameter TCA9554_OUTPUT_REG, such as Read_EXIOS(TCA9554_OUTPUT_REG);
 {
-  uint8_t inputBits = Read_REG(REG);                     
+  exio_lock();
+  uint8_t inputBits;
+  uint8_t *shadow = shadow_for(REG);
+  if (shadow_valid && shadow) {
+    inputBits = *shadow;
+    exio_stats.reads_cached++;
+  } else if (REG == TCA9554_INPUT_REG && int_attached && !input_dirty) {
+    // No input change since the last read (only pins in input mode raise INT)
+    inputBits = cached_input;
+    exio_stats.reads_cached++;
+  } else {
+    if (REG == TCA9554_INPUT_REG) input_dirty = false;
+    inputBits = Read_REG(REG);
+  }
+  exio_unlock();
   return inputBits;     
 }
+bool TCA9554_InputChanged(void)                           // True when the INT line reported an input change since the last input read
+{
+  return !int_attached || input_dirty;
+}
 
 /********************************************************** Set the EXIO output status **********************************************************/  
 void Set_EXIO(uint8_t Pin,uint8_t State)                  // Sets the level state of the Pin without affecting the other pins
 {
-  uint8_t Data;
   if(State < 2 && Pin < 9 && Pin > 0){  
-    uint8_t bitsStatus = Read_EXIOS(TCA9554_OUTPUT_REG);
-    if(State == 1)                                     
-      Data = (0x01 << (Pin-1)) | bitsStatus; 
-    else if(State == 0)                  
-      Data = (~(0x01 << (Pin-1))) & bitsStatus;      
-    uint8_t result = Write_REG(TCA9554_OUTPUT_REG,Data);  
-    if (result != 0) {                         
-      printf("Failed to set GPIO!!!\r\n");
-    }
+    uint8_t mask = 0x01 << (Pin-1);
+    Set_EXIO_Mask(mask, State ? mask : 0);
   }
   else                                           
     printf("Parameter error, please enter the correct parameter!\r\n");
 }
 void Set_EXIOS(uint8_t PinState)                          // Set 7 pins to the PinState state such as :PinState=0x23, 0010 0011 state (the highest bit is not used)
 {
-  uint8_t result = Write_REG(TCA9554_OUTPUT_REG,PinState); 
+  uint8_t result = update_REG(TCA9554_OUTPUT_REG,PinState); 
   if (result != 0) {                  
     printf("Failed to set GPIO!!!\r\n");
   }
 }
+void Set_EXIO_Mask(uint8_t Mask,uint8_t Levels)           // Set the level of all pins in Mask at once (one write), other pins keep their level
+{
+  exio_lock();
+  uint8_t current = shadow_valid ? shadow_output : Read_REG(TCA9554_OUTPUT_REG);
+  uint8_t Data = (current & ~Mask) | (Levels & Mask);
+  uint8_t result = update_REG(TCA9554_OUTPUT_REG,Data);  
+  exio_unlock();
+  if (result != 0) {                         
+    printf("Failed to set GPIO!!!\r\n");
+  }
+}
 /********************************************************** Flip EXIO state **********************************************************/  
 void Set_Toggle(uint8_t Pin)                              // Flip the level of the TCA9554PWR Pin
 {
-    uint8_t bitsStatus = Read_EXIO(Pin);                 
-    Set_EXIO(Pin,(bool)!bitsStatus); 
+  if (Pin < 1 || Pin > 8) return;
+  exio_lock();
+  uint8_t bitsStatus = (Read_EXIOS(TCA9554_OUTPUT_REG) >> (Pin-1)) & 0x01;
+  Set_EXIO(Pin,(bool)!bitsStatus); 
+  exio_unlock();
 }
 /********************************************************* TCA9554PWR Initializes the device ***********************************************************/  
 void TCA9554PWR_Init(uint8_t PinState)                  // Set the seven pins to PinState state, for example :PinState=0x23, 0010 0011 State  (Output mode or input mode) 0= Output mode 1= Input mode. The default value is output mode
 {                  
+#ifdef ESP_PLATFORM
+  if (!exio_mutex)
+    exio_mutex = xSemaphoreCreateRecursiveMutex();
+#endif
+
+  // Load the shadows once, the expander may not have been power cycled with us.
+  // Without all three the registers keep being read over I2C.
+  exio_lock();
+  uint8_t output, polarity, config;
+  bool loaded = read_REG_checked(TCA9554_OUTPUT_REG, &output);
+  loaded = read_REG_checked(TCA9554_Polarity_REG, &polarity) && loaded;
+  loaded = read_REG_checked(TCA9554_CONFIG_REG, &config) && loaded;
+  if (loaded) {
+    shadow_output = output;
+    shadow_polarity = polarity;
+    shadow_config = config;
+  } else {
+    printf("[EXIO] Shadow registers not loaded, reading them over I2C\n");
+  }
+  shadow_valid = loaded;
   Mode_EXIOS(PinState);      
+  exio_unlock();
+
+#if defined(ESP_PLATFORM) && defined(EXIO_PIN_INT)
+  // Open-drain, low while an input differs from the last input register read
+  if (!int_attached) {
+    pinMode(EXIO_PIN_INT, INPUT_PULLUP);
+    attachInterrupt(EXIO_PIN_INT, exio_int_isr, FALLING);
+    int_attached = true;
+  }
+#elif !defined(ESP_PLATFORM)
+  int_attached = true;                                    // driven by TCA9554_SimulateInt()
+#endif
+}
+
+/********************************************************* Statistics ***********************************************************/  
+void TCA9554_GetStats(TCA9554Stats *out)
+{
+  exio_lock();
+  *out = exio_stats;
+  exio_unlock();
+}
+void TCA9554_ResetStats(void)
+{
+  exio_lock();
+  exio_stats = {};
+  exio_unlock();
+}
+void TCA9554_PrintStats(void)
+{
+  TCA9554Stats s;
+  TCA9554_GetStats(&s);
+  printf("[EXIO] %lu register reads, %lu register writes, %lu reads from shadow/cache, %lu writes skipped (unchanged)\n",
+         (unsigned long)s.reads, (unsigned long)s.writes,
+         (unsigned long)s.reads_cached, (unsigned long)s.writes_skipped);
+  printf("[EXIO] output 0x%02x config 0x%02x polarity 0x%02x, input INT %s\n",
+         shadow_output, shadow_config, shadow_polarity, int_attached ? "on" : "off");
 }
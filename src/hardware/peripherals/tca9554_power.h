@@ -1,7 +1,10 @@
 #pragma once
 
 #include <stdio.h>
-#include "i2c_Driver.h"
+#include <stdint.h>
+#ifdef ESP_PLATFORM
+#include "i2c_Driver.h"                                   // Wire and board pins for the drivers including this header
+#endif
 
 #define TCA9554_EXIO1 0x01
 #define TCA9554_EXIO2 0x02
@@ -32,19 +35,39 @@
 #define EXIO_PIN7   7
 #define EXIO_PIN8   8
 
+/// Register transfers and the ones saved by the shadow copies
+struct TCA9554Stats {
+  uint32_t reads;                                           // Input/other register reads over I2C
+  uint32_t writes;                                          // Register writes over I2C
+  uint32_t reads_cached;                                    // Output/config/polarity from shadow, input unchanged per INT
+  uint32_t writes_skipped;                                  // Writes of a value the register already had
+};
+
 /*****************************************************  Operation register REG   ****************************************************/   
 uint8_t Read_REG(uint8_t REG);                              // Read the value of the TCA9554PWR register REG
 uint8_t Write_REG(uint8_t REG,uint8_t Data);                // Write Data to the REG register of the TCA9554PWR
 /********************************************************** Set EXIO mode **********************************************************/       
 void Mode_EXIO(uint8_t Pin,uint8_t State);                  // Set the mode of the TCA9554PWR Pin. The default is Output mode (output mode or input mode). State: 0= Output mode 1= input mode   
 void Mode_EXIOS(uint8_t PinState);                          // Set the mode of the 7 pins from the TCA9554PWR with PinState  
+void Mode_EXIO_Mask(uint8_t Mask,uint8_t Modes);            // Set the mode of all pins in Mask at once, 1 bits in Modes = input mode
 /********************************************************** Read EXIO status **********************************************************/       
 uint8_t Read_EXIO(uint8_t Pin);                             // Read the level of the TCA9554PWR Pin
-uint8_t Read_EXIOS(uint8_t REG);                            // Read the level of all pins of TCA9554PWR, the default read input level state, want to get the current IO output state, pass the parameter TCA9554_OUTPUT_REG, such as Read_EXIOS(TCA9554_OUTPUT_REG);
+bool TCA9554_InputChanged(void);                            // True when the INT line reported an input change since the last input read
+uint8_t Read_EXIOS(uint8_t REG);                            // Output, polarity and config come from the shadow copies. Read the level of all pins of TCA9554PWR, the default read input level state, want to get the current IO output state, pass the parameter TCA9554_OUTPUT_REG, such as Read_EXIOS(TCA9554_OUTPUT_REG);
 /********************************************************** Set the EXIO output status **********************************************************/  
 void Set_EXIO(uint8_t Pin,uint8_t State);                   // Sets the level state of the Pin without affecting the other pins
 void Set_EXIOS(uint8_t PinState);                           // Set 7 pins to the PinState state such as :PinState=0x23, 0010 0011 state (the highest bit is not used)
+void Set_EXIO_Mask(uint8_t Mask,uint8_t Levels);            // Set the level of all pins in Mask at once (one write), other pins keep their level, e.g. Set_EXIO_Mask(0x03, 0x00)
 /********************************************************** Flip EXIO state **********************************************************/  
 void Set_Toggle(uint8_t Pin);                               // Flip the level of the TCA9554PWR Pin
 /********************************************************* TCA9554PWR Initializes the device ***********************************************************/  
-void TCA9554PWR_Init(uint8_t PinState = 0x00);              // Set the seven pins to PinState state, for example :PinState=0x23, 0010 0011 State (the highest bit is not used) (Output mode or input mode) 0= Output mode 1= Input mode. The default value is output mode
+void TCA9554PWR_Init(uint8_t PinState = 0x00);              // Loads the shadow registers and attaches EXIO_PIN_INT. Set the seven pins to PinState state, for example :PinState=0x23, 0010 0011 State (the highest bit is not used) (Output mode or input mode) 0= Output mode 1= Input mode. The default value is output mode
+
+/********************************************************* Statistics ***********************************************************/  
+void TCA9554_GetStats(TCA9554Stats *out);
+void TCA9554_ResetStats(void);
+void TCA9554_PrintStats(void);
+
+#ifndef ESP_PLATFORM
+void TCA9554_SimulateInt(void);                             // Host only: the INT line fell, as the pin interrupt would report it
+#endif
@@ -5,19 +5,23 @@
 #include "hardware/peripherals/power_key.h"
 #include "data/constants.h"
 #include <Arduino.h>
+#include <atomic>
 
 // NVS Keys (defined in power_settings.cpp and constants.h)
 #define KEY_AUTO_DIM_TIME "auto_dim_time"
 #define KEY_SLEEP_TIME "sleep_time"
 #define KEY_BATTERY_SAVER "battery_saver"
 
-// Inactivity tracking
+// Inactivity tracking. Touches arrive on the UI task, which only sets
+// touch_activity and reads the flags; everything else is written by
+// power_check_inactivity() on the loop task.
+static std::atomic<bool> touch_activity(false);
 static unsigned long last_activity_time = 0;
-static bool display_is_sleeping = false;
-static bool display_is_dimmed = false;
-static bool display_is_low_battery_dimmed = false; // Track if dimmed due to low battery
+static volatile bool display_is_sleeping = false;
+static volatile bool display_is_dimmed = false;
+static volatile bool display_is_low_battery_dimmed = false; // Track if dimmed due to low battery
 static int original_brightness = 50; // Default brightness (0-100)
-static unsigned long last_wake_time = 0;  // Track when display was last woken
+static volatile unsigned long last_wake_time = 0;  // Track when display was last woken
 static const unsigned long TOUCH_IGNORE_DELAY = 300; // Ignore touches for 300ms after wake
 
 // Critical battery shutdown tracking
@@ -41,28 +45,41 @@ void power_management_init()
 }
 
 void power_reset_inactivity_timer()
+{
+  // Applied by the next power_check_inactivity(), which owns the backlight
+  touch_activity.store(true);
+}
+
+// Loop task: restart the inactivity timer and undo sleep/dim after a touch
+static void apply_activity()
 {
   last_activity_time = millis();
   
-  // Wake display if sleeping
+  // Wake display if sleeping. The wake time is set before the flags clear,
+  // so the UI task never sees an awake display without it.
   if (display_is_sleeping) {
-    power_wake_display();
     last_wake_time = millis(); // Mark wake time to ignore touches briefly
+    power_wake_display();
   }
   
   // Restore brightness if dimmed (but not if low battery dimmed)
   if (display_is_dimmed && !display_is_low_battery_dimmed) {
+    last_wake_time = millis(); // Mark wake time to ignore touches briefly
     original_brightness = player_store.getInt(KEY_BRIGHTNESS, 50); // 0-100
     Set_Backlight(original_brightness);
     display_is_dimmed = false;
-    last_wake_time = millis(); // Mark wake time to ignore touches briefly
   }
 }
 
 bool power_should_ignore_touch()
 {
-  // Ignore touches for a short time after waking from sleep/dim
-  if (last_wake_time > 0 && (millis() - last_wake_time) < TOUCH_IGNORE_DELAY) {
+  // The touch that wakes the display is ignored until the loop task has
+  // applied it, as are touches for a short time after waking from sleep/dim
+  if (display_is_sleeping || (display_is_dimmed && !display_is_low_battery_dimmed)) {
+    return true;
+  }
+  unsigned long wake_time = last_wake_time;
+  if (wake_time > 0 && (millis() - wake_time) < TOUCH_IGNORE_DELAY) {
     return true;
   }
   return false;
@@ -70,6 +87,10 @@ bool power_should_ignore_touch()
 
 void power_check_inactivity()
 {
+  if (touch_activity.exchange(false)) {
+    apply_activity();
+  }
+
   // Skip if display is already sleeping
   if (display_is_sleeping) {
     return;
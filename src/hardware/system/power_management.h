@@ -6,7 +6,7 @@
 // Power management functions
 void power_management_init();
 void power_check_inactivity();
-void power_reset_inactivity_timer();
+void power_reset_inactivity_timer(); // Any task, applied by the next power_check_inactivity()
 bool power_should_ignore_touch(); // Check if touches should be ignored after wake
 void power_set_brightness(int level); // Level 0-100 (for compatibility)
 void power_sleep_display();
@@ -10,34 +10,78 @@
 #include <lvgl.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <freertos/semphr.h>
 
+// ============================================
+// Core System
+// ============================================
+#include "core/ui_task.h"
+
+// ============================================
+// UI Helpers
+// ============================================
+#include "ui/helpers/transition.h"
+
+#define SHUTDOWN_FADE_MS 1000
+
+static SemaphoreHandle_t fade_done_sem = nullptr;
+static void (*fade_done_cb)(void) = nullptr;
+
+static void shutdown_fade_done(lv_anim_t *a)
+{
+    printf("[Shutdown] Animation completed\n");
+    if (fade_done_cb)
+        fade_done_cb();
+    if (fade_done_sem)
+        xSemaphoreGive(fade_done_sem);
+}
 
-/**
- * @brief Display shutdown animation before power off
- * 
- * Shows a smooth fade-out animation of the entire screen over 1 second
- * to provide visual feedback before the device shuts down.
- */
-void show_shutdown_animation()
+// Runs on the UI task
+static void start_shutdown_fade(void *arg)
 {
-    // Simple shutdown animation: fade-out of the entire screen
+    // The snapshot fade blends one image instead of redrawing the screen
+    // tree every frame; without memory for it fall back to the opa fade
+    if (transition_fade_out_screen(SHUTDOWN_FADE_MS, shutdown_fade_done))
+        return;
+
     lv_obj_t *screen = lv_scr_act();
-    if (screen) {
-        printf("[Shutdown] Showing shutdown animation...\n");
-        
-        // Fade-out animation for 1 second
-        lv_anim_t fade_anim;
-        lv_anim_init(&fade_anim);
-        lv_anim_set_var(&fade_anim, screen);
-        lv_anim_set_values(&fade_anim, LV_OPA_COVER, LV_OPA_TRANSP);
-        lv_anim_set_time(&fade_anim, 1000);
-        lv_anim_set_exec_cb(&fade_anim, (lv_anim_exec_xcb_t)lv_obj_set_style_opa);
-        lv_anim_set_ready_cb(&fade_anim, [](lv_anim_t *a){
-            printf("[Shutdown] Animation completed\n");
-        });
-        lv_anim_start(&fade_anim);
-        
-        // Wait briefly to show animation
-        vTaskDelay(pdMS_TO_TICKS(1100));
+    lv_anim_t fade_anim;
+    lv_anim_init(&fade_anim);
+    lv_anim_set_var(&fade_anim, screen);
+    lv_anim_set_values(&fade_anim, LV_OPA_COVER, LV_OPA_TRANSP);
+    lv_anim_set_time(&fade_anim, SHUTDOWN_FADE_MS);
+    lv_anim_set_exec_cb(&fade_anim, [](void *obj, int32_t opa) {
+        lv_obj_set_style_opa((lv_obj_t *)obj, (lv_opa_t)opa, 0);
+    });
+    lv_anim_set_ready_cb(&fade_anim, shutdown_fade_done);
+    lv_anim_start(&fade_anim);
+}
+
+void show_shutdown_animation(void (*on_done)(void))
+{
+    if (!lv_scr_act()) {
+        if (on_done)
+            on_done();
+        return;
+    }
+    printf("[Shutdown] Showing shutdown animation...\n");
+    fade_done_cb = on_done;
+
+    if (ui_is_ui_task()) {
+        // The fade only advances once this handler returns to the UI loop
+        start_shutdown_fade(nullptr);
+        return;
+    }
+
+    if (!fade_done_sem)
+        fade_done_sem = xSemaphoreCreateBinary();
+    xSemaphoreTake(fade_done_sem, 0);  // drop a give left from an earlier fade
+    if (!ui_post(start_shutdown_fade, nullptr)) {
+        fade_done_cb = nullptr;
+        if (on_done)
+            on_done();
+        return;
     }
+    if (xSemaphoreTake(fade_done_sem, pdMS_TO_TICKS(SHUTDOWN_FADE_MS + 500)) != pdTRUE)
+        printf("[Shutdown] Fade did not finish in time\n");
 }
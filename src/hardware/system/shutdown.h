@@ -4,4 +4,14 @@
 #define FADE_DUR 500 // ms
 #define HOLD_DUR 500 // ms
 
-void show_shutdown_animation();
\ No newline at end of file
+/**
+ * @brief Fade the screen to black before power off
+ *
+ * From another task this posts the fade to the UI task and blocks until it is
+ * done. On the UI task (an event handler) it cannot wait, the fade runs once
+ * the handler returns: power off from on_done then.
+ *
+ * @param on_done Called when the screen is black, on the UI task (right away
+ *                if no fade could be started)
+ */
+void show_shutdown_animation(void (*on_done)(void) = nullptr);
\ No newline at end of file
@@ -1,10 +1,11 @@
 #include "touch_cst816.h"
 #include "board_config.h"
 #include "hardware/system/power_management.h"
+#include "touch_input.h"
+#include "hardware/peripherals/i2c_bus.h"
 
 
 struct CST816_Touch touch_data = {0};
-uint8_t Touch_interrupts=0;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -13,17 +14,11 @@ uint8_t Touch_interrupts=0;
 bool I2C_Read_Touch(uint16_t Driver_addr, uint8_t Reg_addr, uint8_t *Reg_data, uint32_t Length)
 {
 #if defined(BOARD_1_85C)
-  // C-Variante: Haupt-I2C Bus (Wire)
-  Wire.beginTransmission(Driver_addr);
-  Wire.write(Reg_addr); 
-  if ( Wire.endTransmission(true)){
+  // C-Variante: Haupt-I2C Bus über den Bus-Manager (Touch hat höchste Priorität)
+  if (!i2c_bus_read_reg(Driver_addr, Reg_addr, Reg_data, Length)) {
     printf("The I2C transmission fails. - I2C Read\r\n");
     return true;
   }
-  Wire.requestFrom(Driver_addr, Length);
-  for (int i = 0; i < Length; i++) {
-    *Reg_data++ = Wire.read();
-  }
 #else
   // Nicht-C: Separater Touch-I2C Bus (Wire1) wie im Demo
   Wire1.beginTransmission(Driver_addr);
@@ -43,13 +38,8 @@ bool I2C_Read_Touch(uint16_t Driver_addr, uint8_t Reg_addr, uint8_t *Reg_data, u
 bool I2C_Write_Touch(uint8_t Driver_addr, uint8_t Reg_addr, const uint8_t *Reg_data, uint32_t Length)
 {
 #if defined(BOARD_1_85C)
-  // C-Variante: Haupt-I2C Bus (Wire)
-  Wire.beginTransmission(Driver_addr);
-  Wire.write(Reg_addr);       
-  for (int i = 0; i < Length; i++) {
-    Wire.write(*Reg_data++);
-  }
-  if ( Wire.endTransmission(true))
+  // C-Variante: Haupt-I2C Bus über den Bus-Manager
+  if (!i2c_bus_write_reg(Driver_addr, Reg_addr, Reg_data, Length))
   {
     printf("The I2C transmission fails. - I2C Write\r\n");
     return false;
@@ -71,10 +61,10 @@ bool I2C_Write_Touch(uint8_t Driver_addr, uint8_t Reg_addr, const uint8_t *Reg_d
 }
 
 /*!
-    @brief  handle interrupts
+    @brief  handle interrupts, the input task does the read
 */
 void ARDUINO_ISR_ATTR Touch_CST816_ISR(void) {
-  Touch_interrupts = true;
+  touch_input_notify_from_isr();
 }
 
 
@@ -141,7 +131,7 @@ uint16_t CST816_Read_cfg(void) {
     @brief  Fall asleep automatically
 */
 void CST816_AutoSleep(bool Sleep_State) {
-  CST816_Touch_Reset();
+  // No reset here: Touch_Init() already reset the controller right before
   uint8_t Sleep_State_Set = (uint8_t)(!Sleep_State);
   Sleep_State_Set = 10;
   I2C_Write_Touch(CST816_ADDR, CST816_REG_DisAutoSleep, &Sleep_State_Set, 1);
@@ -175,21 +165,6 @@ uint8_t Touch_Read_Data(void) {
   return true;
 }
 
-void example_touchpad_read(void){
-  Touch_Read_Data();
-  if (touch_data.gesture != NONE ||  touch_data.points != 0x00) {
-      printf("Touch : X=%u Y=%u points=%d\r\n",  touch_data.x , touch_data.y,touch_data.points);
-  }
-}
-
-void Touch_Loop(void){
-  if(Touch_interrupts){
-    Touch_interrupts = false;
-    example_touchpad_read();
-  }
-}
-
-
 /*!
     @brief  get the gesture event name
 */
@@ -86,14 +86,6 @@ struct CST816_Touch{
  */
 uint8_t Touch_Init();
 
-/**
- * @brief Main touch processing loop function
- * 
- * Should be called regularly to update touch state
- * and process new touch events.
- */
-void Touch_Loop(void);
-
 /**
  * @brief Hardware reset of CST816 touch controller
  * @return 0 on success, error code on failure
@@ -124,18 +116,11 @@ String Touch_GestureName(void);
  */
 uint8_t Touch_Read_Data(void);
 
-/**
- * @brief Example function for reading touchpad data
- * 
- * Demonstrates basic touch data acquisition.
- * Used for testing and debugging.
- */
-void example_touchpad_read(void);
-
 /**
  * @brief Interrupt service routine for touch events
  * 
  * IRAM_ATTR ensures function is stored in RAM for fast execution.
- * Called when touch interrupt pin is triggered.
+ * Called when touch interrupt pin is triggered, wakes the input task
+ * (see touch_input.h).
  */
 void IRAM_ATTR Touch_CST816_ISR(void);
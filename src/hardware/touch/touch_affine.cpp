@@ -0,0 +1,93 @@
+// ============================================
+// Own Header (first!)
+// ============================================
+#include "touch_affine.h"
+
+// ============================================
+// System & Framework Headers
+// ============================================
+#include <math.h>
+
+static bool to_q16(double value, int32_t *out) {
+  double scaled = value * TOUCH_AFFINE_ONE;
+  if (!(fabs(scaled) < 2147483647.0)) return false;   // also rejects NaN
+  *out = (int32_t)lround(scaled);
+  return true;
+}
+
+void touch_affine_identity(TouchAffine *m) {
+  m->a = TOUCH_AFFINE_ONE; m->b = 0; m->c = 0;
+  m->d = 0; m->e = TOUCH_AFFINE_ONE; m->f = 0;
+}
+
+void touch_affine_from_scale_offset(float scale_x, float scale_y, float offset_x, float offset_y,
+                                    int32_t center_x, int32_t center_y, TouchAffine *m) {
+  // x' = cx + (x - cx) * sx + ox
+  touch_affine_identity(m);
+  to_q16(scale_x, &m->a);
+  to_q16(center_x - (double)center_x * scale_x + offset_x, &m->c);
+  to_q16(scale_y, &m->e);
+  to_q16(center_y - (double)center_y * scale_y + offset_y, &m->f);
+}
+
+bool touch_affine_solve(const TouchCalPoint *raw, const TouchCalPoint *screen, size_t count,
+                        TouchAffine *m, float *rms_px) {
+  if (!raw || !screen || !m || count < 3) return false;
+
+  // Work around the centroid of the raw points: the linear part then comes from
+  // a 2x2 system and the translation is just the mean, which keeps it well
+  // conditioned with coordinates in the hundreds.
+  double mx = 0, my = 0, msx = 0, msy = 0;
+  for (size_t i = 0; i < count; i++) {
+    mx += raw[i].x;
+    my += raw[i].y;
+    msx += screen[i].x;
+    msy += screen[i].y;
+  }
+  mx /= count; my /= count; msx /= count; msy /= count;
+
+  double suu = 0, suv = 0, svv = 0;
+  double sux = 0, svx = 0, suy = 0, svy = 0;
+  for (size_t i = 0; i < count; i++) {
+    double u = raw[i].x - mx, v = raw[i].y - my;
+    double sx = screen[i].x - msx, sy = screen[i].y - msy;
+    suu += u * u; suv += u * v; svv += v * v;
+    sux += u * sx; svx += v * sx;
+    suy += u * sy; svy += v * sy;
+  }
+
+  // Points on (or within a pixel or so of) one line leave one direction
+  // undetermined: det / spread^2 is about the ratio of the narrow to the wide
+  // variance of the points, require the narrow one to be 1% of the wide one
+  double det = suu * svv - suv * suv;
+  double spread = suu + svv;
+  if (spread <= 0 || det <= 1e-2 * spread * spread) return false;
+
+  double a = (sux * svv - svx * suv) / det;
+  double b = (svx * suu - sux * suv) / det;
+  double d = (suy * svv - svy * suv) / det;
+  double e = (svy * suu - suy * suv) / det;
+  double c = msx - a * mx - b * my;
+  double f = msy - d * mx - e * my;
+
+  TouchAffine fit;
+  if (!to_q16(a, &fit.a) || !to_q16(b, &fit.b) || !to_q16(c, &fit.c) ||
+      !to_q16(d, &fit.d) || !to_q16(e, &fit.e) || !to_q16(f, &fit.f)) {
+    return false;
+  }
+
+  if (rms_px) {
+    // Residual of the rounded fixed-point transform, i.e. what the read path does
+    double err = 0;
+    for (size_t i = 0; i < count; i++) {
+      int32_t x, y;
+      touch_affine_apply(&fit, raw[i].x, raw[i].y, &x, &y);
+      double dx = x - screen[i].x, dy = y - screen[i].y;
+      err += dx * dx + dy * dy;
+    }
+    *rms_px = (float)sqrt(err / count);
+  }
+
+  *m = fit;
+  return true;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file touch_affine.h
+ * @brief Fixed-point affine touch transform and its least-squares solver
+ *
+ * Maps raw controller coordinates to screen pixels with
+ *
+ *   x' = a * x + b * y + c
+ *   y' = d * x + e * y + f
+ *
+ * which covers scale, rotation, shear and offset. Coefficients are Q16
+ * (65536 = 1.0, c/f in Q16 pixels), so applying it per sample is integer
+ * only. The solver fits all calibration points at once; it uses floating
+ * point but runs once per calibration. No Arduino or LVGL dependencies,
+ * the solver builds and runs on the host as well.
+ */
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#define TOUCH_AFFINE_SHIFT    16
+#define TOUCH_AFFINE_ONE      (1 << TOUCH_AFFINE_SHIFT)
+/// Stored blob layout, bump when TouchAffineBlob changes
+#define TOUCH_AFFINE_VERSION  1
+
+struct TouchAffine {
+  int32_t a, b, c;
+  int32_t d, e, f;
+};
+
+struct TouchCalPoint {
+  int32_t x;
+  int32_t y;
+};
+
+/**
+ * @brief Calibration as kept in NVS, one blob
+ */
+struct TouchAffineBlob {
+  uint16_t version;     ///< TOUCH_AFFINE_VERSION
+  uint16_t points;      ///< points the fit was solved from
+  TouchAffine m;
+  uint32_t rms_milli_px;  ///< fit residual, 1/1000 px
+};
+
+void touch_affine_identity(TouchAffine *m);
+
+/**
+ * @brief Convert the old per-axis scale around the center plus offset
+ */
+void touch_affine_from_scale_offset(float scale_x, float scale_y, float offset_x, float offset_y,
+                                    int32_t center_x, int32_t center_y, TouchAffine *m);
+
+/**
+ * @brief Least-squares fit of screen = M * raw over all points
+ * @param raw Measured controller coordinates
+ * @param screen Where those touches were meant to land
+ * @param count Number of point pairs, at least 3
+ * @param m Result
+ * @param rms_px Optional, root mean square residual in pixels
+ * @return false for fewer than 3 points or points on (nearly) one line
+ */
+bool touch_affine_solve(const TouchCalPoint *raw, const TouchCalPoint *screen, size_t count,
+                        TouchAffine *m, float *rms_px);
+
+/**
+ * @brief Apply the transform, rounds to the nearest pixel
+ */
+static inline void touch_affine_apply(const TouchAffine *m, int32_t x, int32_t y, int32_t *out_x, int32_t *out_y)
+{
+  const int64_t half = 1 << (TOUCH_AFFINE_SHIFT - 1);
+  *out_x = (int32_t)(((int64_t)m->a * x + (int64_t)m->b * y + m->c + half) >> TOUCH_AFFINE_SHIFT);
+  *out_y = (int32_t)(((int64_t)m->d * x + (int64_t)m->e * y + m->f + half) >> TOUCH_AFFINE_SHIFT);
+}
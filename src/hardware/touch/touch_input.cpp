@@ -0,0 +1,263 @@
+// ============================================
+// Own Header (first!)
+// ============================================
+#include "touch_input.h"
+
+// ============================================
+// System & Framework Headers
+// ============================================
+#include <Arduino.h>
+#include <atomic>
+#include <esp_timer.h>
+
+// ============================================
+// Core System
+// ============================================
+#include "core/ui_task.h"
+#include "core/latency_trace.h"
+
+// ============================================
+// Hardware Layer
+// ============================================
+#include "touch_cst816.h"
+
+static_assert((TOUCH_QUEUE_LENGTH & (TOUCH_QUEUE_LENGTH - 1)) == 0, "TOUCH_QUEUE_LENGTH must be a power of two");
+
+struct LatencyStat {
+  uint32_t samples;
+  uint32_t max_us;
+  uint64_t sum_us;
+};
+
+struct TouchInputStats {
+  uint32_t irq_reads;       ///< reads woken by the interrupt
+  uint32_t hold_polls;      ///< reads while touched without an interrupt
+  uint32_t dropped;         ///< queue full, the sample replaced the newest queued one or was skipped
+  uint32_t feeds;           ///< lv_indev_read() runs on the UI task
+  LatencyStat isr_to_read;    ///< interrupt to indev read callback
+  LatencyStat isr_to_handled; ///< interrupt to LVGL done with the sample (event handlers ran)
+};
+
+static TouchInputStats stats;
+static volatile uint32_t isr_count = 0;
+
+static lv_indev_t *touch_indev = nullptr;
+static TaskHandle_t input_task_handle = nullptr;
+static volatile int64_t last_isr_us = 0;
+static volatile uint32_t last_isr_seq = 0;
+
+// Single producer (input task), single consumer (UI task). A pop and the
+// overwrite of the newest slot on a full queue hold queue_lock.
+static TouchSample queue[TOUCH_QUEUE_LENGTH];
+static std::atomic<uint32_t> queue_head(0);   // next slot to write
+static std::atomic<uint32_t> queue_tail(0);   // next slot to read
+static portMUX_TYPE queue_lock = portMUX_INITIALIZER_UNLOCKED;
+static std::atomic<bool> feed_pending(false);
+
+// Interrupt time of the sample LVGL is processing, 0 if none or a hold poll
+static int64_t processing_isr_us = 0;
+static bool last_pressed = false;
+static lv_timer_t *throw_timer = nullptr;
+
+static void latency_add(LatencyStat *stat, int64_t since_us, int64_t now_us) {
+  uint32_t us = (uint32_t)(now_us - since_us);
+  stat->samples++;
+  stat->sum_us += us;
+  if (us > stat->max_us) stat->max_us = us;
+}
+
+static void queue_push(const TouchSample &sample) {
+  uint32_t head = queue_head.load(std::memory_order_relaxed);
+  if (head - queue_tail.load(std::memory_order_acquire) < TOUCH_QUEUE_LENGTH) {
+    queue[head & (TOUCH_QUEUE_LENGTH - 1)] = sample;
+    queue_head.store(head + 1, std::memory_order_release);
+    return;
+  }
+
+  // Full: the sample replaces the newest queued one, so the latest state still
+  // reaches LVGL. A lost release would leave LVGL pressed until the next touch,
+  // so a press never replaces a queued release (the next hold poll repeats it).
+  portENTER_CRITICAL(&queue_lock);
+  if (head - queue_tail.load(std::memory_order_relaxed) < TOUCH_QUEUE_LENGTH) {
+    // The UI task made room in the meantime
+    queue[head & (TOUCH_QUEUE_LENGTH - 1)] = sample;
+    queue_head.store(head + 1, std::memory_order_release);
+  } else {
+    TouchSample *newest = &queue[(head - 1) & (TOUCH_QUEUE_LENGTH - 1)];
+    if (newest->points != 0 || sample.points == 0) *newest = sample;
+    stats.dropped++;
+  }
+  portEXIT_CRITICAL(&queue_lock);
+}
+
+// LVGL has run all handlers of the sample passed out by the last pop
+static void finish_processing(int64_t now_us) {
+  if (processing_isr_us) latency_add(&stats.isr_to_handled, processing_isr_us, now_us);
+  processing_isr_us = 0;
+}
+
+// While a scroll is still throwing after the release LVGL needs reads to animate it;
+// event mode has no read timer, so keep one alive until the scroll settles
+static void throw_timer_cb(lv_timer_t *timer) {
+  if (last_pressed || !lv_indev_get_scroll_obj(touch_indev)) {
+    lv_timer_delete(timer);
+    throw_timer = nullptr;
+    return;
+  }
+  lv_indev_read(touch_indev);
+}
+
+// Runs on the UI task
+static void touch_input_feed(void *arg) {
+  feed_pending.store(false);
+  stats.feeds++;
+  lv_indev_read(touch_indev);
+  finish_processing(esp_timer_get_time());
+  LTRACE_END();
+
+  if (!last_pressed && !throw_timer && lv_indev_get_scroll_obj(touch_indev)) {
+    throw_timer = lv_timer_create(throw_timer_cb, LV_DEF_REFR_PERIOD, nullptr);
+  }
+}
+
+// Without the input task the read callback is polled and reads the controller itself
+static bool read_direct(TouchSample *sample) {
+  touch_data.points = 0;
+  touch_data.gesture = NONE;
+  Touch_Read_Data();
+  *sample = {};
+  sample->read_us = esp_timer_get_time();
+  sample->points = touch_data.points;
+  sample->gesture = touch_data.gesture;
+  sample->x = touch_data.x;
+  sample->y = touch_data.y;
+  return true;
+}
+
+// Have the UI task read the queue, false if the post failed
+static bool post_feed(void) {
+  if (feed_pending.exchange(true)) return true;
+  if (ui_post(touch_input_feed, nullptr)) return true;
+  feed_pending.store(false);
+  return false;
+}
+
+static void input_task(void *arg) {
+  bool touched = false;
+  // Samples are queued but no feed could be posted (UI task not running yet or
+  // its queue full). After a release no further sample comes to post one, so
+  // retry until the UI task takes them.
+  bool feed_retry = false;
+  TickType_t last_read = 0;
+  for (;;) {
+    // No timeout while released: without an interrupt nothing is read
+    TickType_t wait = touched ? pdMS_TO_TICKS(TOUCH_HOLD_POLL_MS) : portMAX_DELAY;
+    if (feed_retry) wait = pdMS_TO_TICKS(TOUCH_FEED_RETRY_MS);
+    uint32_t notified = ulTaskNotifyTake(pdTRUE, wait);
+
+    if (!notified && feed_retry) {
+      feed_retry = !post_feed();
+      // Read only when the hold poll is due as well
+      if (!touched || xTaskGetTickCount() - last_read < pdMS_TO_TICKS(TOUCH_HOLD_POLL_MS)) continue;
+    }
+    last_read = xTaskGetTickCount();
+
+    // One burst read of gesture, point count and coordinates
+    TouchSample sample;
+    read_direct(&sample);
+    if (notified) {
+      sample.isr_us = last_isr_us;
+      sample.seq = last_isr_seq;
+      stats.irq_reads++;
+    } else {
+      stats.hold_polls++;
+    }
+    touched = sample.points != 0;
+
+    queue_push(sample);
+    feed_retry = !post_feed();
+  }
+}
+
+void IRAM_ATTR touch_input_notify_from_isr(void) {
+  // Trace point: starts the latency sequence (core/latency_trace.h)
+  last_isr_seq = ++isr_count;
+  last_isr_us = esp_timer_get_time();
+  if (!input_task_handle) return;
+
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(input_task_handle, &woken);
+  if (woken == pdTRUE) portYIELD_FROM_ISR();
+}
+
+bool touch_input_pop(TouchSample *sample, bool *more) {
+  if (!input_task_handle) {
+    *more = false;
+    return read_direct(sample);
+  }
+
+  // Reading the next sample means LVGL is done with the previous one
+  finish_processing(esp_timer_get_time());
+
+  portENTER_CRITICAL(&queue_lock);
+  uint32_t tail = queue_tail.load(std::memory_order_relaxed);
+  uint32_t head = queue_head.load(std::memory_order_acquire);
+  if (tail == head) {
+    portEXIT_CRITICAL(&queue_lock);
+    *more = false;
+    return false;
+  }
+  *sample = queue[tail & (TOUCH_QUEUE_LENGTH - 1)];
+  queue_tail.store(tail + 1, std::memory_order_release);
+  portEXIT_CRITICAL(&queue_lock);
+  *more = tail + 1 != head;
+
+  last_pressed = sample->points != 0;
+  if (sample->isr_us) {
+    latency_add(&stats.isr_to_read, sample->isr_us, esp_timer_get_time());
+    processing_isr_us = sample->isr_us;
+  }
+  return true;
+}
+
+void touch_input_start(lv_indev_t *indev) {
+  if (input_task_handle || !indev) return;
+  touch_indev = indev;
+
+  // LVGL no longer polls; touch_input_feed() reads when samples are queued
+  lv_indev_set_mode(indev, LV_INDEV_MODE_EVENT);
+
+  if (xTaskCreatePinnedToCore(input_task, "touch", TOUCH_TASK_STACK_SIZE, nullptr,
+                              TOUCH_TASK_PRIORITY, &input_task_handle, TOUCH_TASK_CORE) != pdPASS) {
+    printf("[Touch] Failed to create input task, polling instead\n");
+    input_task_handle = nullptr;
+    lv_indev_set_mode(indev, LV_INDEV_MODE_TIMER);
+    return;
+  }
+  printf("[Touch] Input task running on core %d\n", TOUCH_TASK_CORE);
+}
+
+static void print_latency(const char *name, const LatencyStat *stat) {
+  if (stat->samples == 0) {
+    printf("[Touch] %-17s no samples\n", name);
+    return;
+  }
+  printf("[Touch] %-17s avg %5lu us max %6lu us (%lu samples)\n", name,
+         (unsigned long)(stat->sum_us / stat->samples), (unsigned long)stat->max_us,
+         (unsigned long)stat->samples);
+}
+
+void touch_input_print_stats(void) {
+  printf("[Touch] %s, %lu interrupts, %lu reads (%lu on interrupt, %lu while held), %lu dropped, %lu LVGL reads\n",
+         input_task_handle ? "event mode" : "polled",
+         (unsigned long)isr_count, (unsigned long)(stats.irq_reads + stats.hold_polls),
+         (unsigned long)stats.irq_reads, (unsigned long)stats.hold_polls,
+         (unsigned long)stats.dropped, (unsigned long)stats.feeds);
+  print_latency("touch -> read", &stats.isr_to_read);
+  print_latency("touch -> handled", &stats.isr_to_handled);
+}
+
+void touch_input_reset_stats(void) {
+  memset(&stats, 0, sizeof(stats));
+  isr_count = 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file touch_input.h
+ * @brief Interrupt-driven touch sampling for the LVGL pointer indev
+ *
+ * The CST816 interrupt wakes a small input task that does one burst read
+ * of the touch registers and queues a timestamped sample. While a finger is
+ * down and the controller stays quiet, the task re-reads every
+ * TOUCH_HOLD_POLL_MS so long presses and releases are seen; with no touch
+ * the bus stays idle. The indev runs in LVGL's event mode and is read on
+ * the UI task only when samples are waiting.
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <stdint.h>
+
+/// Samples queued between the input task and the UI task (power of two)
+#ifndef TOUCH_QUEUE_LENGTH
+#define TOUCH_QUEUE_LENGTH    16
+#endif
+
+/// Re-read interval while touched and no interrupt arrives
+#ifndef TOUCH_HOLD_POLL_MS
+#define TOUCH_HOLD_POLL_MS    20
+#endif
+
+/// Retry interval for handing queued samples to a busy UI task
+#ifndef TOUCH_FEED_RETRY_MS
+#define TOUCH_FEED_RETRY_MS   5
+#endif
+
+#define TOUCH_TASK_CORE       0
+#define TOUCH_TASK_STACK_SIZE 3072
+/// Above the UI task, a read is short and should not wait for a redraw
+#define TOUCH_TASK_PRIORITY   4
+
+/**
+ * @brief One controller read
+ */
+struct TouchSample {
+  uint16_t x;         ///< raw panel coordinates
+  uint16_t y;
+  uint8_t points;     ///< 0 = released
+  uint8_t gesture;    ///< GESTURE code
+  uint32_t seq;       ///< interrupt sequence ID, for latency tracing
+  int64_t isr_us;     ///< interrupt time, 0 for a hold poll
+  int64_t read_us;    ///< I2C read finished
+};
+
+/**
+ * @brief Start the input task and switch indev to event mode
+ *
+ * Call once after the indev was created; Touch_Init() may run before or after.
+ */
+void touch_input_start(lv_indev_t *indev);
+
+/**
+ * @brief Called by the CST816 interrupt
+ */
+void IRAM_ATTR touch_input_notify_from_isr(void);
+
+/**
+ * @brief Take the oldest queued sample, for the indev read callback
+ * @param more Set to true when further samples are waiting
+ * @return false if the queue is empty
+ */
+bool touch_input_pop(TouchSample *sample, bool *more);
+
+/**
+ * @brief Interrupt, read and latency counters
+ */
+void touch_input_print_stats(void);
+void touch_input_reset_stats(void);
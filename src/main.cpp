@@ -18,16 +18,24 @@
 #include "core/gui_main.h"
 #include "core/main.h"
 #include "core/state_manager.h"
+#include "core/serial_console.h"
+#include "core/boot_profiler.h"
+#include "core/bringup.h"
+#include "core/ui_task.h"
+#include "core/persistence.h"
+#include "core/latency_trace.h"
 
 // ============================================
 // Hardware Layer
 // ============================================
 #include "hardware/peripherals/i2c_Driver.h"
+#include "hardware/peripherals/i2c_bus.h"
 #include "hardware/peripherals/tca9554_power.h"
 #include "hardware/peripherals/power_key.h"
 #include "hardware/display/display_st77916.h"
 #include "hardware/display/lvgl_driver.h"
 #include "hardware/touch/touch_cst816.h"
+#include "hardware/touch/touch_input.h"
 #include "hardware/system/battery_state.h"
 #include "hardware/system/power_management.h"
 #include "hardware/audio/simple_audio.h"
@@ -39,17 +47,20 @@
 #include "ui/screens/life/life_counter_two_player.h"
 #include "ui/screens/tools/dice_coin.h"
 #include "ui/screens/settings/touch_calibration.h"
+#include "ui/screens/menu/menu.h"
 #include "ui/helpers/event_grouper.h"
+#include "ui/helpers/font_bench.h"
+#include "ui/helpers/screen_cache.h"
 
 // ============================================
 // Data Layer
 // ============================================
 #include "data/constants.h"
 #include "data/tcg_presets.h"
+#include "data/life_journal.h"
+#include "data/history.h"
 
 
-extern uint8_t Touch_interrupts;
-
 PlayerMode life_counter_mode = PLAYER_MODE_ONE_PLAYER;
 bool is_two_player_mode = false;
 int player1_life = 20;
@@ -102,15 +113,30 @@ void setup()
 {
     Serial.begin(115200);
     Serial.println("--- Starting Life-Puck with Custom Demo Drivers ---");
+    boot_mark("serial");
 
     // Hardware initialization sequence
     I2C_Init();
     TCA9554PWR_Init();
+    boot_mark("i2c+exio");
     
     // Note: Emergency reset via BOOT button removed - conflicts with download mode
     
+    // Independent init steps run on the other core while the display comes up.
+    // None of them touch LVGL; EXIO access is serialized in the TCA9554 driver.
+    static const BringupStep bringup_steps[] = {
+        { "touch",   []() { Touch_Init(); } },
+        { "battery", battery_init },
+        { "audio",   []() { simple_audio_init(); printf("[MAIN] Audio system initialized\n"); } },
+        // Initialize presets BEFORE ui_init()! (This also initializes NVS)
+        { "presets", []() { init_presets(); load_preset(); } },
+        { "journal", []() { life_journal_init(); } },
+    };
+    bringup_start(bringup_steps, sizeof(bringup_steps) / sizeof(bringup_steps[0]));
+    
     LCD_Init();
     Backlight_Init();
+    boot_mark("lcd");
     
     // Load and apply saved brightness from NVS
     int saved_brightness = player_store.getInt(KEY_BRIGHTNESS, 100);  // Default to 100% if not set
@@ -119,20 +145,79 @@ void setup()
 
     // GUI system initialization
     Lvgl_Init();
+    boot_mark("lvgl");
+
+    // Put the logo up now, the rest of the boot runs behind it
+    ui_show_logo();
+    boot_mark("logo");
+
+    // Serial debug console (stats, render mode, benchmarks)
+    serial_console_init();
+    serial_console_register("boot", "Print the boot report", [](const char *args) { boot_report(); });
+    serial_console_register("nvs", "Settings cache and NVS access counters ('nvs reset' clears them)", [](const char *args) {
+        if (strncmp(args, "reset", 5) == 0) {
+            player_store.resetStats();
+        }
+        player_store.printStats();
+    });
+    serial_console_register("persist", "Write-behind persistence stats", [](const char *args) { persistence_print_stats(); });
+    serial_console_register("journal", "Life history journal stats", [](const char *args) { life_journal_print_stats(); });
+    serial_console_register("histbench", "Time the history overlay ('histbench <events>', default 1000 and 10000)", [](const char *args) {
+        int events = atoi(args);
+        if (events > 0) {
+            benchmarkHistoryOverlay((size_t)events);
+        } else {
+            benchmarkHistoryOverlay(1000);
+            benchmarkHistoryOverlay(10000);
+        }
+    });
+    serial_console_register("fontbench", "Glyph render time of the numeric fonts [frames]", [](const char *args) {
+        int frames = atoi(args);
+        font_benchmark(frames > 0 ? (uint32_t)frames : 20);
+    });
+    serial_console_register("digitbench", "Life total updates, lv_label vs digit atlas [frames]", [](const char *args) {
+        int frames = atoi(args);
+        digit_label_benchmark(frames > 0 ? (uint32_t)frames : 120);
+    });
+    serial_console_register("screens", "Retained menu cache stats", [](const char *args) { screen_cache_print_stats(); });
+    serial_console_register("touch", "Touch interrupts, reads and latency ('touch reset' clears them)", [](const char *args) {
+        if (strncmp(args, "reset", 5) == 0) {
+            touch_input_reset_stats();
+        }
+        touch_input_print_stats();
+    });
+    serial_console_register("i2c", "I2C bus transactions and timing per device ('i2c reset' clears them)", [](const char *args) {
+        if (strncmp(args, "reset", 5) == 0) {
+            i2c_bus_reset_stats();
+        }
+        i2c_bus_print_stats();
+    });
+    serial_console_register("exio", "GPIO expander register traffic ('exio reset' clears it)", [](const char *args) {
+        if (strncmp(args, "reset", 5) == 0) {
+            TCA9554_ResetStats();
+        }
+        TCA9554_PrintStats();
+    });
+    serial_console_register("latency", "Touch to flush latency percentiles per stage ('latency reset' clears them)", [](const char *args) {
+#if LATENCY_TRACE
+        if (strncmp(args, "reset", 5) == 0) {
+            LatencyTrace_Reset();
+        }
+        LatencyTrace_Print();
+#else
+        printf("Built with LATENCY_TRACE=0\n");
+#endif
+    });
+    serial_console_register("transbench", "Menu slide-in, live tree vs snapshot [frames]", [](const char *args) {
+        int frames = atoi(args);
+        benchmarkMenuTransition(frames > 0 ? (uint32_t)frames : 30);
+    });
     
     // Load saved touch calibration from NVS (after LVGL init)
     loadTouchCalibrationFromNVS();
 
-    // System monitoring initialization  
-    battery_init();
-    
-    // Audio system initialization
-    simple_audio_init();
-    printf("[MAIN] Audio system initialized\n");
-
-    // Initialize presets BEFORE ui_init()! (This also initializes NVS)
-    init_presets();
-    load_preset();
+    bringup_wait();
+    boot_mark("bringup joined");
     
     // Set initial life values from current preset
     printf("[MAIN] Getting preset from get_preset()\n");
@@ -147,12 +232,12 @@ void setup()
     // Power management initialization (after NVS is initialized)
     power_management_init();
 
-    // Wait for display to fully initialize before showing UI
-    delay(10); // Give display time to settle completely
-    printf("[MAIN] Display settled, initializing UI 10ms Delay\n");
-    
-    // Initialize user interface
+    // From here on settings writes go to flash in the background
+    persistence_start();
+
+    // Initialize user interface (waits out the rest of the logo time)
     ui_init();
+    boot_mark("ui_init");
     
     // Check if touch calibration confirmation is needed after boot
     if (needsTouchCalibrationConfirmation()) {
@@ -160,6 +245,9 @@ void setup()
         renderTouchCalibrationConfirmation();
     }
     
+    // From here on only the UI task calls into LVGL
+    ui_task_start();
+    
     // PSRAM initialization with error handling
     if (psramFound()) {
         printf("PSRAM: %d bytes\n", ESP.getPsramSize());
@@ -173,32 +261,16 @@ void setup()
 /**
  * @brief Arduino main loop - called continuously
  * 
- * Handles the main application loop including GUI updates, touch processing,
- * power management, and game mode-specific logic. Runs the appropriate
- * life counter loop based on current player mode.
+ * LVGL, the life counter loops and the serial console run in the UI task
+ * (see core/ui_task.h). This loop only handles power key, dimming and
+ * battery checks on the other core and must not call LVGL directly.
  */
 void loop()
 {
-    // Core system loops
-    Lvgl_Loop();
-    Touch_Loop();
     power_loop();
     power_check_inactivity(); // Check and apply power modes
     
-    // Game mode specific processing
-    if (life_counter_mode == PLAYER_MODE_ONE_PLAYER) {
-        life_counter_loop();
-    } else if (life_counter_mode == PLAYER_MODE_TWO_PLAYER) {
-        life_counter2p_loop();
-    }
-    
-    // Clear touch interrupt flag if set
-    if (Touch_interrupts) {
-        Touch_interrupts = 0;
-    }
-    
-    // lv_timer_handler() already called in Lvgl_Loop() - avoid double call
-    vTaskDelay(5 / portTICK_PERIOD_MS);
+    vTaskDelay(10 / portTICK_PERIOD_MS);
 }
 
 /**
@@ -0,0 +1,280 @@
+// ============================================
+// Own Header (first!)
+// ============================================
+#include "digit_label.h"
+
+// ============================================
+// System & Framework Headers
+// ============================================
+#include <Arduino.h>
+#include <string.h>
+#include <esp_heap_caps.h>
+
+
+struct digit_label_state_t
+{
+  const digit_atlas_t *large;
+  const digit_atlas_t *small;
+  const digit_atlas_t *current;
+  bool as_text;        ///< current atlas lacks a glyph of the value, draw it as text
+  int value;
+  char text[12];
+};
+
+static digit_atlas_t atlases[DIGIT_ATLAS_MAX_FONTS];
+static size_t atlas_count = 0;
+
+static void *atlas_alloc(size_t bytes)
+{
+  void *mem = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!mem)
+    mem = heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  return mem;
+}
+
+// Render every glyph white on transparent into an ARGB8888 scratch canvas
+// and keep only the alpha channel
+static bool atlas_render(digit_atlas_t *atlas, const lv_font_t *font)
+{
+  atlas->font = font;
+  atlas->line_height = lv_font_get_line_height(font);
+
+  int32_t max_width = 0;
+  for (size_t i = 0; i < DIGIT_ATLAS_GLYPHS; i++)
+  {
+    lv_font_glyph_dsc_t dsc;
+    bool present = lv_font_get_glyph_dsc(font, &dsc, (uint32_t)DIGIT_ATLAS_CHARS[i], 0);
+    atlas->glyphs[i].width = present ? lv_font_get_glyph_width(font, (uint32_t)DIGIT_ATLAS_CHARS[i], 0) : 0;
+    if (atlas->glyphs[i].width > max_width)
+      max_width = atlas->glyphs[i].width;
+  }
+  if (max_width == 0)
+    return false;
+
+  uint32_t scratch_stride = lv_draw_buf_width_to_stride(max_width, LV_COLOR_FORMAT_ARGB8888);
+  uint32_t scratch_size = scratch_stride * atlas->line_height;
+  void *scratch_mem = atlas_alloc(scratch_size);
+  if (!scratch_mem)
+    return false;
+  lv_draw_buf_t scratch;
+  lv_draw_buf_init(&scratch, max_width, atlas->line_height, LV_COLOR_FORMAT_ARGB8888, scratch_stride,
+                   scratch_mem, scratch_size);
+
+  lv_obj_t *canvas = lv_canvas_create(lv_layer_sys());
+  lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+  lv_canvas_set_draw_buf(canvas, &scratch);
+
+  size_t total_bytes = 0;
+  bool ok = true;
+  for (size_t i = 0; i < DIGIT_ATLAS_GLYPHS && ok; i++)
+  {
+    digit_atlas_glyph_t &glyph = atlas->glyphs[i];
+    if (glyph.width == 0)
+    {
+      printf("[DigitLabel] Font %p has no '%c'\n", (const void *)font, DIGIT_ATLAS_CHARS[i]);
+      continue;
+    }
+
+    static char text[2];
+    text[0] = DIGIT_ATLAS_CHARS[i];
+    text[1] = '\0';
+    lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_TRANSP);
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    label_dsc.font = font;
+    label_dsc.color = lv_color_white();
+    label_dsc.text = text;
+    lv_area_t area = {0, 0, glyph.width - 1, atlas->line_height - 1};
+    lv_draw_label(&layer, &label_dsc, &area);
+    lv_canvas_finish_layer(canvas, &layer);
+
+    uint32_t stride = lv_draw_buf_width_to_stride(glyph.width, LV_COLOR_FORMAT_A8);
+    uint32_t size = stride * atlas->line_height;
+    uint8_t *data = (uint8_t *)atlas_alloc(size);
+    if (!data)
+    {
+      ok = false;
+      break;
+    }
+    for (int32_t y = 0; y < atlas->line_height; y++)
+    {
+      const uint8_t *src = scratch.data + y * scratch_stride;
+      uint8_t *dst = data + y * stride;
+      for (int32_t x = 0; x < glyph.width; x++)
+        dst[x] = src[x * 4 + 3];
+    }
+    lv_draw_buf_init(&glyph.buf, glyph.width, atlas->line_height, LV_COLOR_FORMAT_A8, stride, data, size);
+    total_bytes += size;
+  }
+
+  lv_obj_delete(canvas);
+  heap_caps_free(scratch_mem);
+  if (ok)
+    printf("[DigitLabel] Atlas for %d px font: %u bytes\n", (int)atlas->line_height, (unsigned)total_bytes);
+  return ok;
+}
+
+const digit_atlas_t *digit_atlas_get(const lv_font_t *font)
+{
+  for (size_t i = 0; i < atlas_count; i++)
+  {
+    if (atlases[i].font == font)
+      return &atlases[i];
+  }
+  if (atlas_count >= DIGIT_ATLAS_MAX_FONTS)
+  {
+    printf("[DigitLabel] Atlas table full\n");
+    return nullptr;
+  }
+  digit_atlas_t *atlas = &atlases[atlas_count];
+  memset(atlas, 0, sizeof(*atlas));
+  if (!atlas_render(atlas, font))
+  {
+    printf("[DigitLabel] Failed to build atlas\n");
+    for (size_t i = 0; i < DIGIT_ATLAS_GLYPHS; i++)
+      heap_caps_free(atlas->glyphs[i].buf.data);
+    return nullptr;
+  }
+  atlas_count++;
+  return atlas;
+}
+
+static int glyph_index(char c)
+{
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  return c == '+' ? 10 : (c == '-' ? 11 : -1);
+}
+
+static bool atlas_covers(const digit_atlas_t *atlas, const char *text)
+{
+  for (const char *c = text; *c; c++)
+  {
+    int index = glyph_index(*c);
+    if (index < 0 || atlas->glyphs[index].width == 0)
+      return false;
+  }
+  return true;
+}
+
+static void digit_label_draw(lv_event_t *e)
+{
+  lv_obj_t *obj = (lv_obj_t *)lv_event_get_current_target(e);
+  digit_label_state_t *state = (digit_label_state_t *)lv_obj_get_user_data(obj);
+  if (!state || !state->current)
+    return;
+
+  lv_opa_t opa = LV_OPA_MIX2(lv_obj_get_style_text_opa(obj, LV_PART_MAIN),
+                             lv_obj_get_style_opa_recursive(obj, LV_PART_MAIN));
+  if (opa <= LV_OPA_MIN)
+    return;
+
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+  lv_layer_t *layer = lv_event_get_layer(e);
+
+  if (state->as_text)
+  {
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    label_dsc.font = state->current->font;
+    label_dsc.color = lv_obj_get_style_text_color(obj, LV_PART_MAIN);
+    label_dsc.opa = opa;
+    label_dsc.text = state->text;
+    label_dsc.text_local = 1;
+    lv_draw_label(layer, &label_dsc, &coords);
+    return;
+  }
+
+  lv_draw_image_dsc_t img_dsc;
+  lv_draw_image_dsc_init(&img_dsc);
+  img_dsc.recolor = lv_obj_get_style_text_color(obj, LV_PART_MAIN);
+  img_dsc.recolor_opa = LV_OPA_COVER;
+  img_dsc.opa = opa;
+
+  int32_t x = coords.x1;
+  for (const char *c = state->text; *c; c++)
+  {
+    int index = glyph_index(*c);
+    if (index < 0)
+      continue;
+    const digit_atlas_glyph_t &glyph = state->current->glyphs[index];
+    if (glyph.width == 0)
+      continue;
+    img_dsc.src = &glyph.buf;
+    lv_area_t area = {x, coords.y1, x + glyph.width - 1, coords.y1 + state->current->line_height - 1};
+    lv_draw_image(layer, &img_dsc, &area);
+    x += glyph.width;
+  }
+}
+
+static void digit_label_delete(lv_event_t *e)
+{
+  lv_obj_t *obj = (lv_obj_t *)lv_event_get_current_target(e);
+  lv_free(lv_obj_get_user_data(obj));
+  lv_obj_set_user_data(obj, nullptr);
+}
+
+lv_obj_t *digit_label_create(lv_obj_t *parent, const lv_font_t *large, const lv_font_t *small)
+{
+  lv_obj_t *obj = lv_obj_create(parent);
+  lv_obj_remove_style_all(obj);
+  lv_obj_remove_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+
+  digit_label_state_t *state = (digit_label_state_t *)lv_malloc_zeroed(sizeof(digit_label_state_t));
+  state->large = digit_atlas_get(large);
+  state->small = (small && small != large) ? digit_atlas_get(small) : state->large;
+  if (!state->small)
+    state->small = state->large;
+  state->value = INT32_MIN;
+  lv_obj_set_user_data(obj, state);
+
+  lv_obj_add_event_cb(obj, digit_label_draw, LV_EVENT_DRAW_MAIN, NULL);
+  lv_obj_add_event_cb(obj, digit_label_delete, LV_EVENT_DELETE, NULL);
+  digit_label_set_value(obj, 0);
+  return obj;
+}
+
+void digit_label_set_value(lv_obj_t *obj, int value)
+{
+  digit_label_state_t *state = (digit_label_state_t *)lv_obj_get_user_data(obj);
+  if (!state || state->value == value)
+    return;
+  state->value = value;
+  int len = snprintf(state->text, sizeof(state->text), "%d", value);
+  int digits = value < 0 ? len - 1 : len;
+  state->current = digits > DIGIT_LABEL_MAX_LARGE_DIGITS ? state->small : state->large;
+  if (!state->current)
+    return;
+
+  // A digit-only subset has no '-': try the small font, and draw the value as
+  // text in it when its atlas lacks the glyph too, rather than drop the sign
+  if (!atlas_covers(state->current, state->text))
+    state->current = state->small;
+  state->as_text = !atlas_covers(state->current, state->text);
+
+  int32_t width = 0;
+  if (state->as_text)
+  {
+    lv_point_t size;
+    lv_text_get_size(&size, state->text, state->current->font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    width = size.x;
+  }
+  else
+  {
+    for (const char *c = state->text; *c; c++)
+      width += state->current->glyphs[glyph_index(*c)].width;
+  }
+  // No-op for an unchanged width, then only the pixels change and there is no layout pass
+  lv_obj_set_size(obj, width, state->current->line_height);
+  lv_obj_invalidate(obj);
+}
+
+int digit_label_get_value(lv_obj_t *obj)
+{
+  digit_label_state_t *state = (digit_label_state_t *)lv_obj_get_user_data(obj);
+  return state ? state->value : 0;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file digit_label.h
+ * @brief Numeric label drawn from a pre-rendered digit atlas
+ *
+ * A label for life totals: the glyphs 0-9, '+' and '-' of each font are
+ * rendered once into A8 buffers in PSRAM, and the widget draws a number as a
+ * row of those images, tinted with its text color. Setting a value is a
+ * snprintf and an invalidate, without the text layout and glyph decoding of
+ * lv_label.
+ *
+ * A value with a glyph the large font lacks (a digit-only subset has no '-')
+ * is shown in the small font, drawn as plain text if its atlas lacks the
+ * glyph as well.
+ *
+ * The text color and text opacity styles apply, as does the object opacity
+ * (so fade_in_obj / fade_out_obj work on it).
+ */
+
+#pragma once
+#include <lvgl.h>
+#include <stdint.h>
+
+#define DIGIT_ATLAS_CHARS       "0123456789+-"
+#define DIGIT_ATLAS_GLYPHS      (sizeof(DIGIT_ATLAS_CHARS) - 1)
+#define DIGIT_ATLAS_MAX_FONTS   4
+
+/// Values with more digits than this use the small font of the label
+#define DIGIT_LABEL_MAX_LARGE_DIGITS  3
+
+struct digit_atlas_glyph_t
+{
+  lv_draw_buf_t buf;   ///< A8 coverage, line height tall
+  int32_t width;       ///< advance width, 0 if the font has no such glyph
+};
+
+struct digit_atlas_t
+{
+  const lv_font_t *font;
+  int32_t line_height;
+  digit_atlas_glyph_t glyphs[DIGIT_ATLAS_GLYPHS];
+};
+
+/**
+ * @brief Atlas of a font, rendered on first use
+ * @return nullptr if the atlas table is full or out of memory
+ */
+const digit_atlas_t *digit_atlas_get(const lv_font_t *font);
+
+/**
+ * @brief Create a digit label
+ * @param large Font for values up to DIGIT_LABEL_MAX_LARGE_DIGITS digits
+ * @param small Font for longer values (may be the same as large)
+ */
+lv_obj_t *digit_label_create(lv_obj_t *parent, const lv_font_t *large, const lv_font_t *small);
+
+/**
+ * @brief Show a value, resizes the object to the width of the number
+ */
+void digit_label_set_value(lv_obj_t *obj, int value);
+
+int digit_label_get_value(lv_obj_t *obj);
@@ -1,18 +1,9 @@
 #pragma once
-#include <vector>
 #include <stdint.h>
 #include <functional>
 #include <Arduino.h>
 #include "../screens/tools/timer.h"
-
-struct LifeHistoryEvent
-{
-  int net_life_change;
-  int life_total;
-  int player_id;        // 0 for single, 1/2 for 2P
-  uint32_t timestamp;   // Time since boot
-  int change_timestamp; // seconds since game started
-};
+#include "history_ring.h"
 
 class EventGrouper
 {
@@ -79,7 +70,7 @@ public:
     {
       int new_life_total = life_total + net_change;
       LifeHistoryEvent evt{net_change, new_life_total, player_id, last_event_time, change_timestamp};
-      history.push_back(evt);
+      history.push(evt);
       life_total = new_life_total; // Update state to latest committed value
       if (commit_callback)
         commit_callback(evt);
@@ -91,14 +82,19 @@ public:
     }
   }
 
-  // Access history
-  std::vector<LifeHistoryEvent> getHistory()
+  // Access history (no copy, valid until the next commit or reset)
+  const LifeHistoryRing &getHistory() const
   {
-    printf("[EventGrouper] getHistory: size=%zu\n", history.size());
-
     return history;
   }
 
+  // Re-add a committed event (journal restore after a reboot)
+  void restoreEvent(const LifeHistoryEvent &evt)
+  {
+    history.push(evt);
+    life_total = evt.life_total;
+  }
+
   // Helper: Reset history
   void resetHistory(int base_life)
   {
@@ -120,6 +116,6 @@ private:
   uint32_t group_start_time;
   uint32_t last_event_time;
   int change_timestamp;
-  std::vector<LifeHistoryEvent> history;
+  LifeHistoryRing history;
   std::function<void(const LifeHistoryEvent &)> commit_callback;
 };
@@ -0,0 +1,198 @@
+// ============================================
+// Own Header (first!)
+// ============================================
+#include "font_bench.h"
+
+// ============================================
+// System & Framework Headers
+// ============================================
+#include <Arduino.h>
+#include <lvgl.h>
+#include <esp_timer.h>
+
+// ============================================
+// UI Components
+// ============================================
+#include "ui/components/digit_label.h"
+
+// ============================================
+// Hardware Layer
+// ============================================
+#include "hardware/display/display_st77916.h"
+
+// ============================================
+// Data Layer
+// ============================================
+#include "data/constants.h"
+
+
+#define FONT_BENCH_TEXT        "0123456789"
+#define FONT_BENCH_LOOKUPS     100
+
+struct BenchFont
+{
+  const char *name;
+  const lv_font_t *font;
+  bool subset;
+};
+
+static const BenchFont bench_fonts[] = {
+    {"digits 72", FONT_DIGITS_72, FONT_SUBSET_DIGITS_72},
+    {"digits 64", FONT_DIGITS_64, FONT_SUBSET_DIGITS_64},
+    {"digits 48", FONT_DIGITS_48, FONT_SUBSET_DIGITS_48},
+    {"digits 36", FONT_DIGITS_36, FONT_SUBSET_DIGITS_36},
+    {"montserrat 40", &lv_font_montserrat_40, false},
+};
+
+static uint32_t redraw_us(lv_obj_t *label)
+{
+  uint64_t start = esp_timer_get_time();
+  lv_obj_invalidate(label);
+  lv_refr_now(NULL);
+  LCD_WaitTransDone();
+  return (uint32_t)(esp_timer_get_time() - start);
+}
+
+// Glyph descriptor lookups (cmap search) for every character of the text
+static uint32_t lookup_ns(const lv_font_t *font)
+{
+  static const char text[] = FONT_BENCH_TEXT;
+  lv_font_glyph_dsc_t dsc;
+  uint64_t start = esp_timer_get_time();
+  for (int i = 0; i < FONT_BENCH_LOOKUPS; i++)
+  {
+    for (const char *c = text; *c; c++)
+      lv_font_get_glyph_dsc(font, &dsc, (uint32_t)*c, 0);
+  }
+  uint64_t elapsed = esp_timer_get_time() - start;
+  return (uint32_t)(elapsed * 1000 / (FONT_BENCH_LOOKUPS * (sizeof(text) - 1)));
+}
+
+void font_benchmark(uint32_t frames)
+{
+  if (frames < 2)
+    frames = 2;
+
+  lv_obj_t *layer = lv_obj_create(lv_layer_top());
+  lv_obj_remove_style_all(layer);
+  lv_obj_set_size(layer, SCREEN_WIDTH, SCREEN_HEIGHT);
+  lv_obj_set_style_bg_color(layer, BLACK_COLOR, 0);
+  lv_obj_set_style_bg_opa(layer, LV_OPA_COVER, 0);
+
+  lv_obj_t *label = lv_label_create(layer);
+  lv_label_set_text_static(label, FONT_BENCH_TEXT);
+  lv_obj_set_style_text_color(label, WHITE_COLOR, 0);
+  lv_obj_center(label);
+  lv_refr_now(NULL);
+  LCD_WaitTransDone();
+
+  printf("[FontBench] '%s', %lu redraws per font (render + transfer)\n", FONT_BENCH_TEXT,
+         (unsigned long)frames);
+  for (size_t i = 0; i < sizeof(bench_fonts) / sizeof(bench_fonts[0]); i++)
+  {
+    const BenchFont &bf = bench_fonts[i];
+    lv_obj_set_style_text_font(label, bf.font, 0);
+    lv_obj_update_layout(label);
+
+    // The first redraw after switching reads the glyph bitmaps through a cold flash cache
+    uint32_t cold = redraw_us(label);
+    uint64_t total = 0;
+    uint32_t max = 0;
+    for (uint32_t f = 1; f < frames; f++)
+    {
+      uint32_t t = redraw_us(label);
+      total += t;
+      if (t > max)
+        max = t;
+    }
+    printf("[FontBench] %-14s %-8s line %3d px | cold %5lu us, warm avg %5lu us max %5lu us | lookup %4lu ns/glyph\n",
+           bf.name, bf.subset ? "subset" : "built-in", (int)lv_font_get_line_height(bf.font),
+           (unsigned long)cold, (unsigned long)(total / (frames - 1)), (unsigned long)max,
+           (unsigned long)lookup_ns(bf.font));
+  }
+
+  lv_obj_delete(layer);
+  lv_refr_now(NULL);
+}
+
+struct UpdateTiming
+{
+  uint64_t set_us;
+  uint64_t draw_us;
+  uint32_t draw_max;
+};
+
+// Count down like a game: set the value, lay it out, redraw what changed
+static void time_updates(lv_obj_t *obj, bool atlas, uint32_t frames, UpdateTiming *timing)
+{
+  *timing = {};
+  for (uint32_t i = 0; i < frames; i++)
+  {
+    int value = 40 - (int)(i % 60);
+    uint64_t start = esp_timer_get_time();
+    if (atlas)
+    {
+      digit_label_set_value(obj, value);
+    }
+    else
+    {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "%d", value);
+      lv_label_set_text(obj, buf);
+    }
+    lv_obj_update_layout(obj);
+    uint64_t mid = esp_timer_get_time();
+    lv_refr_now(NULL);
+    LCD_WaitTransDone();
+    uint32_t draw = (uint32_t)(esp_timer_get_time() - mid);
+    timing->set_us += mid - start;
+    timing->draw_us += draw;
+    if (draw > timing->draw_max)
+      timing->draw_max = draw;
+  }
+}
+
+void digit_label_benchmark(uint32_t frames)
+{
+  if (frames == 0)
+    frames = 1;
+
+  lv_obj_t *layer = lv_obj_create(lv_layer_top());
+  lv_obj_remove_style_all(layer);
+  lv_obj_set_size(layer, SCREEN_WIDTH, SCREEN_HEIGHT);
+  lv_obj_set_style_bg_color(layer, BLACK_COLOR, 0);
+  lv_obj_set_style_bg_opa(layer, LV_OPA_COVER, 0);
+
+  lv_obj_t *label = lv_label_create(layer);
+  lv_obj_set_style_text_font(label, FONT_DIGITS_72, 0);
+  lv_obj_set_style_text_color(label, WHITE_COLOR, 0);
+  lv_obj_center(label);
+
+  uint64_t build_start = esp_timer_get_time();
+  lv_obj_t *digits = digit_label_create(layer, FONT_DIGITS_72, FONT_DIGITS_48);
+  uint32_t build_us = (uint32_t)(esp_timer_get_time() - build_start);
+  lv_obj_set_style_text_color(digits, WHITE_COLOR, 0);
+  lv_obj_center(digits);
+
+  UpdateTiming label_timing, atlas_timing;
+  lv_obj_add_flag(digits, LV_OBJ_FLAG_HIDDEN);
+  lv_refr_now(NULL);
+  time_updates(label, false, frames, &label_timing);
+
+  lv_obj_add_flag(label, LV_OBJ_FLAG_HIDDEN);
+  lv_obj_remove_flag(digits, LV_OBJ_FLAG_HIDDEN);
+  lv_refr_now(NULL);
+  time_updates(digits, true, frames, &atlas_timing);
+
+  printf("[FontBench] Life total updates, %lu values (digit_label created in %lu us, atlases included)\n",
+         (unsigned long)frames, (unsigned long)build_us);
+  printf("[FontBench] lv_label    set+layout avg %4lu us | redraw avg %5lu us max %5lu us\n",
+         (unsigned long)(label_timing.set_us / frames), (unsigned long)(label_timing.draw_us / frames),
+         (unsigned long)label_timing.draw_max);
+  printf("[FontBench] digit_label set+layout avg %4lu us | redraw avg %5lu us max %5lu us\n",
+         (unsigned long)(atlas_timing.set_us / frames), (unsigned long)(atlas_timing.draw_us / frames),
+         (unsigned long)atlas_timing.draw_max);
+
+  lv_obj_delete(layer);
+  lv_refr_now(NULL);
+}
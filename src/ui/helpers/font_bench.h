@@ -0,0 +1,28 @@
+/**
+ * @file font_bench.h
+ * @brief Glyph render timing for the numeric fonts
+ *
+ * Counterpart to the flash report of tools/fonts/build_fonts.py: draws the
+ * digits of every large UI font and prints lookup and redraw times, so bpp
+ * and compression choices in fonts.json can be compared on the device. Also
+ * compares the digit atlas label of the life totals with lv_label.
+ */
+
+#pragma once
+#include <stdint.h>
+
+/**
+ * @brief Time the numeric fonts on a temporary layer, then remove it
+ * @param frames Redraws per font, the first one is reported separately (cold)
+ *
+ * Runs on the UI task (serial console command "fontbench").
+ */
+void font_benchmark(uint32_t frames);
+
+/**
+ * @brief Time life total updates through lv_label and through digit_label
+ * @param frames Values shown per path, each one set, laid out and redrawn
+ *
+ * Runs on the UI task (serial console command "digitbench").
+ */
+void digit_label_benchmark(uint32_t frames);
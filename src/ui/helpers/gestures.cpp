@@ -15,6 +15,7 @@
 // Core System
 // ============================================
 #include "core/state_manager.h"
+#include "core/latency_trace.h"
 
 // ============================================
 // Data Layer
@@ -48,6 +49,7 @@ void lvgl_gesture_event_handler(lv_event_t *e)
 {
   static bool swipe_detected = false;
   static bool long_press_active = false;
+  LTRACE_MARK(LTRACE_GESTURE);
   lv_obj_t *obj = (lv_obj_t *)lv_event_get_target(e);
   lv_event_code_t code = lv_event_get_code(e);
   lv_point_t point = {0, 0};
@@ -0,0 +1,95 @@
+// ============================================
+// Own Header (first!)
+// ============================================
+#include "history_ring.h"
+
+// ============================================
+// System & Framework Headers
+// ============================================
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+#endif
+
+
+PackedLifeEvent PackedLifeEvent::pack(const LifeHistoryEvent &evt)
+{
+  PackedLifeEvent packed;
+  packed.timestamp = evt.timestamp;
+  packed.net_change = (int16_t)(evt.net_life_change < INT16_MIN ? INT16_MIN : (evt.net_life_change > INT16_MAX ? INT16_MAX : evt.net_life_change));
+  packed.life_total = (int16_t)(evt.life_total < INT16_MIN ? INT16_MIN : (evt.life_total > INT16_MAX ? INT16_MAX : evt.life_total));
+  packed.game_seconds = (uint16_t)(evt.change_timestamp < 0 ? 0 : (evt.change_timestamp > 0xFFFF ? 0xFFFF : evt.change_timestamp));
+  packed.player_id = (uint8_t)evt.player_id;
+  packed.reserved = 0;
+  return packed;
+}
+
+LifeHistoryEvent PackedLifeEvent::unpack() const
+{
+  LifeHistoryEvent evt;
+  evt.net_life_change = net_change;
+  evt.life_total = life_total;
+  evt.player_id = player_id;
+  evt.timestamp = timestamp;
+  evt.change_timestamp = game_seconds;
+  return evt;
+}
+
+LifeHistoryRing::~LifeHistoryRing()
+{
+  free(buffer);
+}
+
+bool LifeHistoryRing::allocate()
+{
+  size_t bytes = capacity_ * sizeof(PackedLifeEvent);
+#ifdef ESP_PLATFORM
+  if (LIFE_HISTORY_IN_PSRAM)
+    buffer = (PackedLifeEvent *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!buffer)
+    buffer = (PackedLifeEvent *)heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+#else
+  buffer = (PackedLifeEvent *)malloc(bytes);
+#endif
+  if (!buffer)
+  {
+    printf("[History] Failed to allocate %u events\n", (unsigned)capacity_);
+    return false;
+  }
+  return true;
+}
+
+void LifeHistoryRing::push(const LifeHistoryEvent &evt)
+{
+  if (capacity_ == 0 || (!buffer && !allocate()))
+  {
+    dropped_count++;
+    return;
+  }
+
+  if (count < capacity_)
+  {
+    size_t slot = head + count;
+    if (slot >= capacity_)
+      slot -= capacity_;
+    buffer[slot] = PackedLifeEvent::pack(evt);
+    count++;
+    return;
+  }
+
+  // Full: the oldest slot becomes the newest
+  buffer[head] = PackedLifeEvent::pack(evt);
+  head = (head + 1 == capacity_) ? 0 : head + 1;
+  dropped_count++;
+}
+
+void LifeHistoryRing::spans(Span *first, Span *second) const
+{
+  size_t first_len = (head + count > capacity_) ? capacity_ - head : count;
+  first->data = buffer ? buffer + head : nullptr;
+  first->size = first_len;
+  second->data = buffer;
+  second->size = count - first_len;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file history_ring.h
+ * @brief Fixed-capacity life history storage
+ *
+ * Committed life changes are kept in a ring buffer of compact 12-byte
+ * events, allocated once (in PSRAM when available). When it is full the
+ * oldest event is overwritten. Readers get references, iterators or the
+ * raw contiguous runs, never a copy.
+ */
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Events kept per player; a long Commander game is a few hundred
+#ifndef LIFE_HISTORY_CAPACITY
+#define LIFE_HISTORY_CAPACITY 1024
+#endif
+
+// Put the ring buffers into PSRAM (falls back to internal RAM)
+#ifndef LIFE_HISTORY_IN_PSRAM
+#define LIFE_HISTORY_IN_PSRAM 1
+#endif
+
+struct LifeHistoryEvent
+{
+  int net_life_change;
+  int life_total;
+  int player_id;        // 0 for single, 1/2 for 2P
+  uint32_t timestamp;   // Time since boot
+  int change_timestamp; // seconds since game started
+};
+
+/**
+ * @brief Stored form of a LifeHistoryEvent, 12 bytes
+ */
+struct PackedLifeEvent
+{
+  uint32_t timestamp;      ///< millis() at commit
+  int16_t net_change;
+  int16_t life_total;
+  uint16_t game_seconds;   ///< change_timestamp, saturated
+  uint8_t player_id;
+  uint8_t reserved;
+
+  static PackedLifeEvent pack(const LifeHistoryEvent &evt);
+  LifeHistoryEvent unpack() const;
+};
+
+static_assert(sizeof(PackedLifeEvent) == 12, "PackedLifeEvent must stay 12 bytes");
+
+class LifeHistoryRing
+{
+public:
+  /**
+   * @brief One contiguous run of events in the buffer
+   */
+  struct Span
+  {
+    const PackedLifeEvent *data;
+    size_t size;
+  };
+
+  class const_iterator
+  {
+  public:
+    const_iterator(const LifeHistoryRing *ring, size_t index) : ring(ring), index(index) {}
+    const PackedLifeEvent &operator*() const { return (*ring)[index]; }
+    const PackedLifeEvent *operator->() const { return &(*ring)[index]; }
+    const_iterator &operator++()
+    {
+      index++;
+      return *this;
+    }
+    bool operator==(const const_iterator &other) const { return index == other.index; }
+    bool operator!=(const const_iterator &other) const { return index != other.index; }
+
+  private:
+    const LifeHistoryRing *ring;
+    size_t index;
+  };
+
+  /**
+   * @param capacity Number of events kept, the buffer is allocated on the first push
+   */
+  explicit LifeHistoryRing(size_t capacity = LIFE_HISTORY_CAPACITY) : capacity_(capacity) {}
+  ~LifeHistoryRing();
+  LifeHistoryRing(const LifeHistoryRing &) = delete;
+  LifeHistoryRing &operator=(const LifeHistoryRing &) = delete;
+
+  /**
+   * @brief Append an event, overwrites the oldest one when full
+   */
+  void push(const LifeHistoryEvent &evt);
+
+  void clear()
+  {
+    head = 0;
+    count = 0;
+  }
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  size_t capacity() const { return capacity_; }
+  /// Events overwritten (or lost to a failed allocation) since construction
+  uint32_t dropped() const { return dropped_count; }
+
+  /**
+   * @brief Event by age, 0 is the oldest; index must be < size()
+   */
+  const PackedLifeEvent &operator[](size_t index) const
+  {
+    size_t slot = head + index;
+    if (slot >= capacity_)
+      slot -= capacity_;
+    return buffer[slot];
+  }
+
+  const PackedLifeEvent &back() const { return (*this)[count - 1]; }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, count); }
+
+  /**
+   * @brief The events as (at most) two contiguous runs, oldest first
+   */
+  void spans(Span *first, Span *second) const;
+
+private:
+  bool allocate();
+
+  PackedLifeEvent *buffer = nullptr;
+  size_t capacity_;
+  size_t head = 0;   ///< slot of the oldest event
+  size_t count = 0;
+  uint32_t dropped_count = 0;
+};
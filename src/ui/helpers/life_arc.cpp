@@ -0,0 +1,186 @@
+// ============================================
+// Own Header (first!)
+// ============================================
+#include "life_arc.h"
+
+// ============================================
+// System & Framework Headers
+// ============================================
+#include <Arduino.h>
+#include <lvgl.h>
+#include <math.h>
+#include <stdio.h>
+
+
+// 1P arc leaves a gap of this many pixels of circumference at the bottom
+#define ARC_GAP_PX 200.0f
+
+// *** COLOR RAMP ***
+// Indexed by life / max_life in LIFE_ARC_RAMP_STEPS steps: red below 25%,
+// red -> yellow up to 55%, yellow -> green up to 87.5%, green above.
+#define RAMP_RED_END      (LIFE_ARC_RAMP_STEPS * 25 / 100)
+#define RAMP_YELLOW_POINT (LIFE_ARC_RAMP_STEPS * 55 / 100)
+#define RAMP_GREEN_START  (LIFE_ARC_RAMP_STEPS * 875 / 1000)
+
+static constexpr uint32_t blend_rgb(uint32_t c1, uint32_t c2, int t)
+{
+  return ((((c1 >> 16) & 0xFF) + ((int)((c2 >> 16) & 0xFF) - (int)((c1 >> 16) & 0xFF)) * t / 255) << 16) |
+         ((((c1 >> 8) & 0xFF) + ((int)((c2 >> 8) & 0xFF) - (int)((c1 >> 8) & 0xFF)) * t / 255) << 8) |
+         (((c1 & 0xFF) + ((int)(c2 & 0xFF) - (int)(c1 & 0xFF)) * t / 255));
+}
+
+struct ColorRamp
+{
+  uint32_t rgb[LIFE_ARC_RAMP_STEPS + 1];
+
+  constexpr ColorRamp() : rgb{}
+  {
+    for (int q = 0; q <= LIFE_ARC_RAMP_STEPS; q++)
+    {
+      if (q >= RAMP_GREEN_START)
+        rgb[q] = GREEN_HEX;
+      else if (q >= RAMP_YELLOW_POINT)
+        rgb[q] = blend_rgb(YELLOW_HEX, GREEN_HEX, (q - RAMP_YELLOW_POINT) * 255 / (RAMP_GREEN_START - RAMP_YELLOW_POINT));
+      else if (q >= RAMP_RED_END)
+        rgb[q] = blend_rgb(RED_HEX, YELLOW_HEX, (q - RAMP_RED_END) * 255 / (RAMP_YELLOW_POINT - RAMP_RED_END));
+      else
+        rgb[q] = RED_HEX;
+    }
+  }
+};
+
+static constexpr ColorRamp color_ramp;
+
+// *** ARC TABLES ***
+typedef struct
+{
+  int16_t start_angle;
+  int16_t end_angle;
+  lv_color_t color;
+} life_arc_entry_t;
+
+// Entries 0..steps cover lives 0..max_life, entry steps + 1 is used above max_life
+static life_arc_entry_t arc_tables[LIFE_ARC_LAYOUT_COUNT][LIFE_ARC_TABLE_STEPS + 2];
+static int table_steps = 0;
+static int table_max_life = -1;
+static int table_mode = -1;
+
+static lv_color_t ramp_color(int life, int max_life)
+{
+  int q = (int)(((int64_t)life * LIFE_ARC_RAMP_STEPS) / max_life);
+  if (q < 0)
+    q = 0;
+  if (q > LIFE_ARC_RAMP_STEPS)
+    q = LIFE_ARC_RAMP_STEPS;
+  return lv_color_hex(color_ramp.rgb[q]);
+}
+
+static int scaled_sweep(int span, int life, int max_life)
+{
+  return (int)(((int64_t)span * life * 2 + max_life) / (2 * max_life));
+}
+
+static void build_single(int max_life)
+{
+  life_arc_entry_t *table = arc_tables[LIFE_ARC_SINGLE];
+  float circumference = M_PI * SCREEN_DIAMETER;
+  float gap_deg = (ARC_GAP_PX / circumference) * 360.0f;
+  float arc_span = 360.0f - gap_deg;
+  float arc_half = arc_span / 2.0f;
+  int base_start = (int)(270.0f - arc_half + 0.5f);
+  int base_end = (int)(270.0f + arc_half + 0.5f);
+
+  for (int i = 0; i <= table_steps; i++)
+  {
+    int life = (int)(((int64_t)i * max_life) / table_steps);
+    table[i].start_angle = base_start;
+    table[i].color = ramp_color(life, max_life);
+    if (i == table_steps)
+      table[i].end_angle = base_end % 360;
+    else if (life <= 0)
+      table[i].end_angle = base_start;
+    else
+      table[i].end_angle = (base_start + (int)(arc_span * ((float)life / (float)max_life) + 0.5f)) % 360;
+  }
+
+  // Above max life the arc closes up to the gap without wrapping
+  table[table_steps + 1].start_angle = base_start;
+  table[table_steps + 1].end_angle = base_start + (int)arc_span;
+  table[table_steps + 1].color = GREEN_COLOR;
+}
+
+static void build_two_player(int max_life)
+{
+  life_arc_entry_t *p1 = arc_tables[LIFE_ARC_P1];
+  life_arc_entry_t *p2 = arc_tables[LIFE_ARC_P2];
+
+  // Player 1: arc grows clockwise from 90° + gap/2 to 270°
+  int p1_start = 90 + ARC_GAP_DEGREES / 2;
+  int p1_span = 270 - p1_start;
+  // Player 2: arc grows counterclockwise from 270° to 90° - gap/2
+  int p2_end = 90 - ARC_GAP_DEGREES / 2;
+  int p2_span = (p2_end - 270 + 360) % 360;
+
+  for (int i = 0; i <= table_steps; i++)
+  {
+    int life = (int)(((int64_t)i * max_life) / table_steps);
+    lv_color_t color = ramp_color(life, max_life);
+
+    p1[i].start_angle = p1_start;
+    p1[i].end_angle = p1_start + scaled_sweep(p1_span, life, max_life);
+    p1[i].color = color;
+
+    p2[i].start_angle = (p2_end - scaled_sweep(p2_span, life, max_life) + 360) % 360;
+    p2[i].end_angle = p2_end;
+    p2[i].color = color;
+  }
+
+  // 2P arcs are clamped at max life
+  p1[table_steps + 1] = p1[table_steps];
+  p2[table_steps + 1] = p2[table_steps];
+}
+
+void life_arc_rebuild(int max_life, PlayerMode mode)
+{
+  if (max_life <= 0)
+    max_life = DEFAULT_LIFE_MAX;
+  if (max_life == table_max_life && (int)mode == table_mode)
+    return;
+
+  uint32_t start_us = micros();
+  table_max_life = max_life;
+  table_mode = (int)mode;
+  table_steps = (max_life < LIFE_ARC_TABLE_STEPS) ? max_life : LIFE_ARC_TABLE_STEPS;
+
+  if (mode == PLAYER_MODE_TWO_PLAYER)
+    build_two_player(max_life);
+  else
+    build_single(max_life);
+
+  printf("[LifeArc] Built %s tables for max life %d (%d steps) in %lu us\n",
+         mode == PLAYER_MODE_TWO_PLAYER ? "2P" : "1P", max_life, table_steps,
+         (unsigned long)(micros() - start_us));
+}
+
+arc_segment_t life_arc_lookup(life_arc_layout_t layout, int life_total)
+{
+  arc_segment_t seg = {0};
+  if (table_steps == 0 || layout >= LIFE_ARC_LAYOUT_COUNT)
+    return seg;
+
+  int index;
+  if (life_total <= 0)
+    index = 0;
+  else if (life_total > table_max_life)
+    index = table_steps + 1;
+  else if (table_steps == table_max_life)
+    index = life_total;
+  else
+    index = (int)(((int64_t)life_total * table_steps) / table_max_life);
+
+  const life_arc_entry_t *entry = &arc_tables[layout][index];
+  seg.start_angle = entry->start_angle;
+  seg.end_angle = entry->end_angle;
+  seg.color = entry->color;
+  return seg;
+}
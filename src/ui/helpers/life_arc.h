@@ -0,0 +1,47 @@
+/**
+ * @file life_arc.h
+ * @brief Precomputed life arc geometry and color tables
+ *
+ * The life arcs only depend on the layout, the max life and the life total.
+ * The tables are built once per (layout, max life) so a life change or a
+ * frame of the sweep animation is a plain lookup, without float math or
+ * NVS reads.
+ */
+
+#pragma once
+#include <lvgl.h>
+#include <stdint.h>
+#include "data/constants.h"
+
+/**
+ * @brief Arc layouts with their own geometry
+ */
+enum life_arc_layout_t
+{
+  LIFE_ARC_SINGLE = 0,   ///< 1P: full circle with a gap at the bottom
+  LIFE_ARC_P1,           ///< 2P left half, grows clockwise from 120° to 270°
+  LIFE_ARC_P2,           ///< 2P right half, grows counterclockwise from 270° to 60°
+  LIFE_ARC_LAYOUT_COUNT
+};
+
+// Entries per layout table. Max life values above this share one entry per
+// bucket of lives, which is still finer than one degree of arc.
+#define LIFE_ARC_TABLE_STEPS    512
+
+// Resolution of the red -> yellow -> green color ramp
+#define LIFE_ARC_RAMP_STEPS     256
+
+/**
+ * @brief Build the tables for a player mode, no-op if max life and mode are unchanged
+ * @param max_life Starting life the arcs are scaled to
+ * @param mode Player mode, selects which layouts are built
+ */
+void life_arc_rebuild(int max_life, PlayerMode mode);
+
+/**
+ * @brief Look up the arc segment for a life total
+ * @param layout Arc layout, must belong to the mode of the last rebuild
+ * @param life_total Life total, values outside [0, max life] are clamped
+ * @return Start/end angles and color of the arc indicator
+ */
+arc_segment_t life_arc_lookup(life_arc_layout_t layout, int life_total);
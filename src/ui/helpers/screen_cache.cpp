@@ -0,0 +1,248 @@
+// ============================================
+// Own Header (first!)
+// ============================================
+#include "screen_cache.h"
+
+// ============================================
+// System & Framework Headers
+// ============================================
+#include <Arduino.h>
+
+
+struct CachedScreen
+{
+  screen_key_t key;
+  screen_build_fn_t build;
+  screen_stamp_fn_t stamp;
+  bool prebuild;
+  lv_obj_t *obj;         ///< retained root, nullptr if not built
+  uint32_t built_stamp;
+  size_t bytes;          ///< LVGL heap taken by the last build
+  uint32_t last_used;
+  bool showing;
+};
+
+struct ScreenCacheStats
+{
+  uint32_t hits;
+  uint32_t builds;
+  uint32_t stale;
+  uint32_t evictions;
+  uint32_t prebuilt;
+  uint32_t last_build_us;
+  uint32_t max_build_us;
+};
+
+static CachedScreen screens[SCREEN_CACHE_SLOTS];
+static size_t screen_count = 0;
+static uint32_t use_counter = 0;
+static lv_timer_t *idle_timer = nullptr;
+static ScreenCacheStats cache_stats = {};
+
+static size_t lvgl_heap_used()
+{
+  lv_mem_monitor_t mon;
+  lv_mem_monitor(&mon);
+  return mon.total_size - mon.free_size;
+}
+
+static CachedScreen *find_screen(screen_key_t key)
+{
+  for (size_t i = 0; i < screen_count; i++)
+  {
+    if (screens[i].key == key)
+      return &screens[i];
+  }
+  return nullptr;
+}
+
+static uint32_t current_stamp(const CachedScreen &s)
+{
+  return s.stamp ? s.stamp(s.key) : 0;
+}
+
+static size_t retained_bytes()
+{
+  size_t total = 0;
+  for (size_t i = 0; i < screen_count; i++)
+  {
+    if (screens[i].obj)
+      total += screens[i].bytes;
+  }
+  return total;
+}
+
+static void drop_screen(CachedScreen &s)
+{
+  if (s.obj)
+  {
+    // Async: this can run inside an event callback of the menu being dropped
+    lv_anim_delete(s.obj, NULL);
+    lv_obj_add_flag(s.obj, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_delete_async(s.obj);
+  }
+  s.obj = nullptr;
+  s.showing = false;
+}
+
+// Delete least recently shown hidden menus until the retained ones fit the budget
+static void enforce_budget()
+{
+  while (retained_bytes() > SCREEN_CACHE_BUDGET_BYTES)
+  {
+    CachedScreen *lru = nullptr;
+    for (size_t i = 0; i < screen_count; i++)
+    {
+      CachedScreen &s = screens[i];
+      if (s.obj && !s.showing && (!lru || s.last_used < lru->last_used))
+        lru = &s;
+    }
+    if (!lru)
+      return;
+    drop_screen(*lru);
+    cache_stats.evictions++;
+  }
+}
+
+static bool build_screen(CachedScreen &s)
+{
+  size_t before = lvgl_heap_used();
+  uint32_t start_us = micros();
+  s.obj = s.build(s.key);
+  uint32_t build_us = micros() - start_us;
+  size_t after = lvgl_heap_used();
+
+  s.bytes = after > before ? after - before : 0;
+  s.built_stamp = current_stamp(s);
+  cache_stats.builds++;
+  cache_stats.last_build_us = build_us;
+  if (build_us > cache_stats.max_build_us)
+    cache_stats.max_build_us = build_us;
+  return s.obj != nullptr;
+}
+
+static bool is_current(const CachedScreen &s)
+{
+  return s.built_stamp == current_stamp(s) && lv_obj_get_screen(s.obj) == lv_screen_active();
+}
+
+// Build one missing (or stale) prebuild menu per tick while nobody touches the screen
+static void idle_timer_cb(lv_timer_t *timer)
+{
+  if (lv_display_get_inactive_time(NULL) < SCREEN_CACHE_IDLE_MS)
+    return;
+
+  for (size_t i = 0; i < screen_count; i++)
+  {
+    CachedScreen &s = screens[i];
+    if (!s.prebuild || s.showing)
+      continue;
+    if (s.obj)
+    {
+      if (is_current(s))
+        continue;
+      drop_screen(s);
+      cache_stats.stale++;
+    }
+    // Skip what would be evicted again right away
+    if (retained_bytes() + s.bytes > SCREEN_CACHE_BUDGET_BYTES)
+      continue;
+    if (build_screen(s))
+    {
+      lv_obj_add_flag(s.obj, LV_OBJ_FLAG_HIDDEN);
+      cache_stats.prebuilt++;
+    }
+    return;
+  }
+}
+
+bool screen_cache_register(screen_key_t key, screen_build_fn_t build, screen_stamp_fn_t stamp, bool prebuild)
+{
+  if (!build || find_screen(key))
+    return false;
+  if (screen_count >= SCREEN_CACHE_SLOTS)
+  {
+    printf("[ScreenCache] Table full, 0x%lx not registered\n", (unsigned long)key);
+    return false;
+  }
+  CachedScreen &s = screens[screen_count++];
+  s = {};
+  s.key = key;
+  s.build = build;
+  s.stamp = stamp;
+  s.prebuild = prebuild;
+
+  if (prebuild && !idle_timer)
+    idle_timer = lv_timer_create(idle_timer_cb, SCREEN_CACHE_POLL_MS, NULL);
+  return true;
+}
+
+lv_obj_t *screen_cache_show(screen_key_t key)
+{
+  CachedScreen *s = find_screen(key);
+  if (!s)
+    return nullptr;
+
+  if (s->obj && !is_current(*s))
+  {
+    drop_screen(*s);
+    cache_stats.stale++;
+  }
+  if (s->obj)
+    cache_stats.hits++;
+  else if (!build_screen(*s))
+    return nullptr;
+
+  s->showing = true;
+  s->last_used = ++use_counter;
+  lv_obj_remove_flag(s->obj, LV_OBJ_FLAG_HIDDEN);
+  lv_obj_move_foreground(s->obj);
+  enforce_budget();
+  return s->obj;
+}
+
+bool screen_cache_hide(lv_obj_t *obj)
+{
+  for (size_t i = 0; i < screen_count; i++)
+  {
+    CachedScreen &s = screens[i];
+    if (s.obj != obj)
+      continue;
+    lv_anim_delete(obj, NULL);
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    s.showing = false;
+    enforce_budget();
+    return true;
+  }
+  return false;
+}
+
+void screen_cache_invalidate(screen_key_t key)
+{
+  CachedScreen *s = find_screen(key);
+  if (s && !s->showing)
+    drop_screen(*s);
+}
+
+void screen_cache_clear(void)
+{
+  for (size_t i = 0; i < screen_count; i++)
+    drop_screen(screens[i]);
+}
+
+void screen_cache_print_stats(void)
+{
+  printf("[ScreenCache] %u bytes retained of %u, hits=%lu builds=%lu stale=%lu evictions=%lu prebuilt=%lu\n",
+         (unsigned)retained_bytes(), (unsigned)SCREEN_CACHE_BUDGET_BYTES,
+         (unsigned long)cache_stats.hits, (unsigned long)cache_stats.builds, (unsigned long)cache_stats.stale,
+         (unsigned long)cache_stats.evictions, (unsigned long)cache_stats.prebuilt);
+  printf("[ScreenCache] build last=%lu us max=%lu us\n",
+         (unsigned long)cache_stats.last_build_us, (unsigned long)cache_stats.max_build_us);
+  for (size_t i = 0; i < screen_count; i++)
+  {
+    const CachedScreen &s = screens[i];
+    printf("[ScreenCache]   0x%04lx %-9s %5u bytes%s\n", (unsigned long)s.key,
+           s.obj ? (s.showing ? "showing" : "hidden") : "-", (unsigned)s.bytes,
+           s.prebuild ? " (prebuild)" : "");
+  }
+}
@@ -0,0 +1,76 @@
+/**
+ * @file screen_cache.h
+ * @brief Retained menu screens with LRU eviction
+ *
+ * Menus registered here are built once and then kept, hidden, on the active
+ * screen instead of being deleted on every navigation. Showing a cached menu
+ * is a flag change; a build only happens on the first show, after eviction or
+ * when the state the menu was built from changed (its stamp). Retained menus
+ * share a budget of LVGL heap, the least recently shown one is deleted when a
+ * new build would exceed it. Menus marked for prebuild are created while the
+ * user is idle, so even the first open is cheap.
+ */
+
+#pragma once
+#include <lvgl.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// LVGL heap the hidden menus may keep (LV_MEM_SIZE is shared with everything else)
+#ifndef SCREEN_CACHE_BUDGET_BYTES
+#define SCREEN_CACHE_BUDGET_BYTES (16 * 1024)
+#endif
+
+#define SCREEN_CACHE_SLOTS        8
+
+/// Prebuild once there was no input for this long
+#ifndef SCREEN_CACHE_IDLE_MS
+#define SCREEN_CACHE_IDLE_MS      2000
+#endif
+#define SCREEN_CACHE_POLL_MS      500
+
+/// Menu plus a variant (e.g. the contextual menu page)
+#define SCREEN_KEY(menu, variant) ((((uint32_t)(menu)) << 8) | ((uint32_t)(variant) & 0xFF))
+
+typedef uint32_t screen_key_t;
+
+/**
+ * @brief Build the menu for a key on the active screen, return its root object
+ */
+typedef lv_obj_t *(*screen_build_fn_t)(screen_key_t key);
+
+/**
+ * @brief Value of everything the built menu depends on; a change forces a rebuild
+ */
+typedef uint32_t (*screen_stamp_fn_t)(screen_key_t key);
+
+/**
+ * @brief Register a cacheable menu
+ * @param stamp May be nullptr for menus that only depend on their key
+ * @param prebuild Build it in idle time before it is first shown
+ */
+bool screen_cache_register(screen_key_t key, screen_build_fn_t build, screen_stamp_fn_t stamp, bool prebuild);
+
+/**
+ * @brief Show a registered menu, building it if it is not retained (or stale)
+ * @return Root object, now visible and in front, or nullptr if not registered
+ */
+lv_obj_t *screen_cache_show(screen_key_t key);
+
+/**
+ * @brief Hide a menu that is retained by the cache
+ * @return false if the object is not retained, the caller deletes it then
+ */
+bool screen_cache_hide(lv_obj_t *obj);
+
+/**
+ * @brief Drop the retained menu of a key (deleted unless it is showing)
+ */
+void screen_cache_invalidate(screen_key_t key);
+
+/**
+ * @brief Drop all retained menus, e.g. before the active screen is replaced
+ */
+void screen_cache_clear(void);
+
+void screen_cache_print_stats(void);
@@ -0,0 +1,260 @@
+// ============================================
+// Own Header (first!)
+// ============================================
+#include "transition.h"
+
+// ============================================
+// System & Framework Headers
+// ============================================
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+// ============================================
+// Hardware Layer
+// ============================================
+#include "hardware/display/display_st77916.h"
+
+// ============================================
+// UI Helpers
+// ============================================
+#include "animation_helpers.h"
+
+// ============================================
+// Data Layer
+// ============================================
+#include "data/constants.h"
+
+
+struct Snapshot
+{
+  lv_draw_buf_t buf;
+  void *mem;
+  lv_obj_t *image;
+};
+
+struct Transition
+{
+  lv_obj_t *target;      ///< live object, transparent while this runs (nullptr: whole screen)
+  lv_obj_t *backdrop;
+  Snapshot snap;
+  lv_anim_ready_cb_t ready_cb;
+};
+
+static Transition transitions[TRANSITION_MAX_ACTIVE];
+
+// Render obj into a PSRAM image placed over it on the top layer
+static bool snapshot_create(lv_obj_t *obj, Snapshot *snap)
+{
+  lv_obj_update_layout(obj);
+  int32_t ext = lv_obj_get_ext_draw_size(obj);
+  int32_t w = lv_obj_get_width(obj) + ext * 2;
+  int32_t h = lv_obj_get_height(obj) + ext * 2;
+  uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+  uint32_t size = stride * h;
+
+  snap->mem = heap_caps_aligned_alloc(LV_DRAW_BUF_ALIGN, size, MALLOC_CAP_SPIRAM);
+  if (!snap->mem)
+    return false;
+  lv_draw_buf_init(&snap->buf, w, h, LV_COLOR_FORMAT_RGB565, stride, snap->mem, size);
+  if (lv_snapshot_take_to_draw_buf(obj, LV_COLOR_FORMAT_RGB565, &snap->buf) != LV_RESULT_OK)
+  {
+    heap_caps_free(snap->mem);
+    snap->mem = nullptr;
+    return false;
+  }
+
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+  snap->image = lv_image_create(lv_layer_top());
+  lv_image_set_src(snap->image, &snap->buf);
+  lv_obj_remove_flag(snap->image, LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_set_pos(snap->image, coords.x1 - ext, coords.y1 - ext);
+  return true;
+}
+
+static void snapshot_delete(Snapshot *snap)
+{
+  if (snap->image)
+  {
+    lv_anim_delete(snap->image, NULL);
+    lv_obj_delete(snap->image);
+  }
+  heap_caps_free(snap->mem);
+  *snap = {};
+}
+
+static void target_deleted_cb(lv_event_t *e);
+
+static void transition_end(Transition *t)
+{
+  if (t->target)
+  {
+    lv_obj_remove_event_cb(t->target, target_deleted_cb);
+    lv_obj_set_style_opa(t->target, LV_OPA_COVER, LV_PART_MAIN);
+  }
+  snapshot_delete(&t->snap);
+  if (t->backdrop)
+    lv_obj_delete(t->backdrop);
+  *t = {};
+}
+
+static void target_deleted_cb(lv_event_t *e)
+{
+  Transition *t = (Transition *)lv_event_get_user_data(e);
+  t->target = nullptr;
+  transition_end(t);
+}
+
+static Transition *transition_begin(lv_obj_t *target)
+{
+  Transition *free_slot = nullptr;
+  for (size_t i = 0; i < TRANSITION_MAX_ACTIVE; i++)
+  {
+    Transition *t = &transitions[i];
+    // A new transition of the same object replaces the running one
+    if (t->snap.image && t->target == target)
+      transition_end(t);
+    if (!t->snap.image && !free_slot)
+      free_slot = t;
+  }
+  return free_slot;
+}
+
+static void transition_anim_ready(lv_anim_t *a)
+{
+  Transition *t = (Transition *)lv_anim_get_user_data(a);
+  lv_anim_ready_cb_t ready_cb = t->ready_cb;
+  // A screen fade ends black: leave the backdrop over the live screen
+  if (!t->target)
+    t->backdrop = nullptr;
+  transition_end(t);
+  if (ready_cb)
+    ready_cb(a);
+}
+
+bool transition_slide_in_vertical(lv_obj_t *obj, int32_t start_y, int32_t end_y, uint32_t duration,
+                                  lv_anim_ready_cb_t ready_cb)
+{
+  Transition *t = transition_begin(obj);
+  lv_obj_set_y(obj, end_y);
+  if (!t || !snapshot_create(obj, &t->snap))
+  {
+    slide_in_obj_vertical(obj, start_y, end_y, duration, 0, ready_cb);
+    return false;
+  }
+
+  t->target = obj;
+  t->ready_cb = ready_cb;
+  lv_obj_set_style_opa(obj, LV_OPA_TRANSP, LV_PART_MAIN);
+  lv_obj_add_event_cb(obj, target_deleted_cb, LV_EVENT_DELETE, t);
+
+  int32_t final_y = lv_obj_get_y(t->snap.image);
+  lv_anim_t anim;
+  lv_anim_init(&anim);
+  lv_anim_set_var(&anim, t->snap.image);
+  lv_anim_set_user_data(&anim, t);
+  lv_anim_set_exec_cb(&anim, [](void *o, int32_t y)
+                      { lv_obj_set_y((lv_obj_t *)o, y); });
+  lv_anim_set_values(&anim, final_y + (start_y - end_y), final_y);
+  lv_anim_set_time(&anim, duration);
+  lv_anim_set_ready_cb(&anim, transition_anim_ready);
+  lv_obj_set_y(t->snap.image, final_y + (start_y - end_y));
+  lv_anim_start(&anim);
+  return true;
+}
+
+void transition_cancel(lv_obj_t *obj)
+{
+  for (size_t i = 0; i < TRANSITION_MAX_ACTIVE; i++)
+  {
+    if (transitions[i].snap.image && transitions[i].target == obj)
+      transition_end(&transitions[i]);
+  }
+}
+
+bool transition_fade_out_screen(uint32_t duration, lv_anim_ready_cb_t ready_cb)
+{
+  Transition *t = transition_begin(nullptr);
+  if (!t)
+    return false;
+
+  // Black under the image, fading the image then is a single blend per pixel
+  t->backdrop = lv_obj_create(lv_layer_top());
+  lv_obj_remove_style_all(t->backdrop);
+  lv_obj_set_size(t->backdrop, SCREEN_WIDTH, SCREEN_HEIGHT);
+  lv_obj_set_style_bg_color(t->backdrop, BLACK_COLOR, 0);
+  lv_obj_set_style_bg_opa(t->backdrop, LV_OPA_COVER, 0);
+
+  if (!snapshot_create(lv_screen_active(), &t->snap))
+  {
+    lv_obj_delete(t->backdrop);
+    *t = {};
+    return false;
+  }
+  t->ready_cb = ready_cb;
+
+  lv_anim_t anim;
+  lv_anim_init(&anim);
+  lv_anim_set_var(&anim, t->snap.image);
+  lv_anim_set_user_data(&anim, t);
+  lv_anim_set_exec_cb(&anim, [](void *o, int32_t opa)
+                      { lv_obj_set_style_image_opa((lv_obj_t *)o, (lv_opa_t)opa, 0); });
+  lv_anim_set_values(&anim, LV_OPA_COVER, LV_OPA_TRANSP);
+  lv_anim_set_time(&anim, duration);
+  lv_anim_set_ready_cb(&anim, transition_anim_ready);
+  lv_anim_start(&anim);
+  return true;
+}
+
+// Move obj down one screen height and back in `frames` synchronous redraws
+static uint32_t time_slide(lv_obj_t *obj, int32_t base_y, uint32_t frames, uint32_t *max_us)
+{
+  uint64_t total = 0;
+  *max_us = 0;
+  for (uint32_t i = 0; i < frames; i++)
+  {
+    int32_t offset = -SCREEN_HEIGHT + (int32_t)((SCREEN_HEIGHT * (i + 1)) / frames);
+    uint64_t start = esp_timer_get_time();
+    lv_obj_set_y(obj, base_y + offset);
+    lv_refr_now(NULL);
+    LCD_WaitTransDone();
+    uint32_t us = (uint32_t)(esp_timer_get_time() - start);
+    total += us;
+    if (us > *max_us)
+      *max_us = us;
+  }
+  return (uint32_t)(total / frames);
+}
+
+void transition_benchmark(lv_obj_t *obj, uint32_t frames)
+{
+  if (!obj || frames == 0)
+    return;
+
+  int32_t live_y = lv_obj_get_y(obj);
+  uint32_t live_max, snap_max;
+  uint32_t live_avg = time_slide(obj, live_y, frames, &live_max);
+  lv_obj_set_y(obj, live_y);
+
+  Snapshot snap = {};
+  uint64_t start = esp_timer_get_time();
+  bool ok = snapshot_create(obj, &snap);
+  uint32_t snapshot_us = (uint32_t)(esp_timer_get_time() - start);
+  if (!ok)
+  {
+    printf("[Transition] No memory for a snapshot\n");
+    return;
+  }
+  lv_obj_set_style_opa(obj, LV_OPA_TRANSP, LV_PART_MAIN);
+  uint32_t snap_avg = time_slide(snap.image, lv_obj_get_y(snap.image), frames, &snap_max);
+  snapshot_delete(&snap);
+  lv_obj_set_style_opa(obj, LV_OPA_COVER, LV_PART_MAIN);
+  lv_refr_now(NULL);
+
+  printf("[Transition] Slide, %lu frames (render + transfer)\n", (unsigned long)frames);
+  printf("[Transition] live tree  avg %5lu us max %5lu us\n", (unsigned long)live_avg, (unsigned long)live_max);
+  printf("[Transition] snapshot   avg %5lu us max %5lu us (+%lu us to take it, %lu bytes)\n",
+         (unsigned long)snap_avg, (unsigned long)snap_max, (unsigned long)snapshot_us,
+         (unsigned long)(lv_obj_get_width(obj) * lv_obj_get_height(obj) * 2));
+}
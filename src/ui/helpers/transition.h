@@ -0,0 +1,51 @@
+/**
+ * @file transition.h
+ * @brief Transitions that animate a snapshot instead of the live tree
+ *
+ * The object is rendered once into an RGB565 image in PSRAM and only that
+ * image moves or fades on the top layer, so a frame of the animation is one
+ * image blit instead of redrawing every label and button of the menu. The
+ * live object stays in place but transparent (it already takes input) and
+ * is shown again when the animation ends. Without the memory for a snapshot
+ * the live tree is animated as before.
+ */
+
+#pragma once
+#include <lvgl.h>
+#include <stdint.h>
+
+/// Transitions running at the same time
+#define TRANSITION_MAX_ACTIVE  2
+
+/**
+ * @brief Slide an object in vertically, like slide_in_obj_vertical()
+ * @param obj Object in its final position (layout done or pending)
+ * @param start_y Y offset the animation starts from
+ * @param end_y Final Y offset of the object
+ * @return false if the live object was animated instead
+ */
+bool transition_slide_in_vertical(lv_obj_t *obj, int32_t start_y, int32_t end_y, uint32_t duration,
+                                  lv_anim_ready_cb_t ready_cb = NULL);
+
+/**
+ * @brief Stop a running transition of obj, which is shown as it is right away
+ */
+void transition_cancel(lv_obj_t *obj);
+
+/**
+ * @brief Fade the whole active screen to black
+ *
+ * Meant for shutdown: when the fade ends the black backdrop stays on the top
+ * layer, so the live screen does not come back.
+ *
+ * @return false if there was no memory for the snapshot (nothing is shown then)
+ */
+bool transition_fade_out_screen(uint32_t duration, lv_anim_ready_cb_t ready_cb = NULL);
+
+/**
+ * @brief Compare frame times of moving obj live and moving its snapshot
+ * @param frames Frames per path, spread over the slide distance of one screen height
+ *
+ * Runs on the UI task, obj ends up where it was.
+ */
+void transition_benchmark(lv_obj_t *obj, uint32_t frames);
@@ -15,6 +15,8 @@
 // Core System
 // ============================================
 #include "core/state_manager.h"
+#include "core/boot_profiler.h"
+#include "core/latency_trace.h"
 
 // ============================================
 // UI Screens
@@ -22,17 +24,24 @@
 #include "ui/screens/menu/menu.h"
 #include "ui/screens/tools/timer.h"
 
+// ============================================
+// UI Components
+// ============================================
+#include "ui/components/digit_label.h"
+
 // ============================================
 // UI Helpers
 // ============================================
 #include "ui/helpers/animation_helpers.h"
 #include "ui/helpers/gestures.h"
 #include "ui/helpers/event_grouper.h"
+#include "ui/helpers/life_arc.h"
 
 // ============================================
 // Data Layer
 // ============================================
 #include "data/constants.h"
+#include "data/life_journal.h"
 
 // ============================================
 // Hardware/Storage
@@ -103,6 +112,7 @@ void init_life_counter()
   // Use default max life for initial UI setup - will be updated later
   int max_life = player_store.getInt(KEY_LIFE_MAX, DEFAULT_LIFE_MAX);
   event_grouper.resetHistory(max_life);
+  life_arc_rebuild(max_life, PLAYER_MODE_ONE_PLAYER);
   
   // Reset AMP to OFF on every init to avoid positioning issues
   player_store.putInt(KEY_AMP_MODE, PLAYER_SINGLE);
@@ -144,16 +154,10 @@ void init_life_counter()
   
   if (!life_label)
   {
-    life_label = lv_label_create(life_counter_container);
+    life_label = digit_label_create(life_counter_container, FONT_DIGITS_72, FONT_DIGITS_48);
     lv_obj_add_flag(life_label, LV_OBJ_FLAG_HIDDEN);
-    lv_label_set_text(life_label, "0");
-    if (event_grouper.getLifeTotal() > 999)
-      lv_obj_set_style_text_font(life_label, &lv_font_montserrat_48, 0);
-    else
-      lv_obj_set_style_text_font(life_label, &lv_font_montserrat_72, 0);
     lv_obj_set_style_text_color(life_label, lv_color_white(), 0);
     lv_obj_align(life_label, LV_ALIGN_CENTER, 0, 0);
-    lv_obj_set_style_text_opa(life_label, LV_OPA_TRANSP, 0);
     lv_obj_set_grid_cell(life_label, LV_GRID_ALIGN_CENTER, 0, 1, LV_GRID_ALIGN_START, 1, 1);
   }
   
@@ -188,7 +192,7 @@ void init_life_counter()
     snprintf(buf, sizeof(buf), "%d", amp_value);
     lv_label_set_text(lbl_amp_label, buf);
     lv_obj_set_style_text_color(lbl_amp_label, WHITE_COLOR, 0);
-    lv_obj_set_style_text_font(lbl_amp_label, &lv_font_montserrat_36, 0);
+    lv_obj_set_style_text_font(lbl_amp_label, FONT_DIGITS_36, 0);
     lv_obj_center(lbl_amp_label);
     lv_obj_align_to(amp_button, life_label, LV_ALIGN_RIGHT_MID, 140, 0);
     // AMP is always OFF on init, so hide the button
@@ -200,9 +204,22 @@ void init_life_counter()
     lv_obj_clear_flag(life_arc, LV_OBJ_FLAG_HIDDEN);
     lv_obj_set_style_arc_opa(life_arc, LV_OPA_COVER, LV_PART_INDICATOR);
     
-    // *** AUTO-LOAD: Load saved life BEFORE animation to prevent blink ***
-    int saved_life = loadLifeFromNVS(1);  // Single-player = Player 1
-    event_grouper.resetHistory(saved_life);
+    // *** AUTO-LOAD: Restore the game (with history) from the journal, or the
+    // saved life total, BEFORE animation to prevent blink ***
+    life_journal_game_t game;
+    if (life_journal_restore(PLAYER_MODE_ONE_PLAYER, &game, [](const LifeHistoryEvent &evt, void *ctx) {
+          event_grouper.restoreEvent(evt); }, NULL))
+    {
+      if (game.events == 0)
+        event_grouper.resetHistory(game.start_life);
+      printf("[LifePersist] Restored 1P game: %lu events, life %d\n", (unsigned long)game.events, event_grouper.getLifeTotal());
+    }
+    else
+    {
+      int saved_life = loadLifeFromNVS(1);  // Single-player = Player 1
+      event_grouper.resetHistory(saved_life);
+      life_journal_start_game(PLAYER_MODE_ONE_PLAYER, saved_life);
+    }
     
     lv_anim_t anim;
     lv_anim_init(&anim);
@@ -247,6 +264,7 @@ void reset_life()
 {
   int life_value = player_store.getInt(KEY_LIFE_MAX, DEFAULT_LIFE_MAX);
   event_grouper.resetHistory(life_value);
+  life_journal_start_game(PLAYER_MODE_ONE_PLAYER, life_value);
   update_life_label(life_value);
   
   // *** AUTO-SAVE: Clear saved data when user resets ***
@@ -307,6 +325,7 @@ static void arc_sweep_anim_cb(void *var, int32_t v)
 static void arc_sweep_anim_ready_cb(lv_anim_t *a)
 {
   is_initializing = false;
+  boot_mark_interactive();
   
   register_gesture_callback(GestureType::TapTop, []()
                             { increment_life(step_size_t::STEP_SIZE_SMALL); });
@@ -329,96 +348,20 @@ static void arc_sweep_anim_ready_cb(lv_anim_t *a)
   });
 }
 
-static arc_segment_t life_to_arc(int life_total)
-{
-  int max_life = player_store.getInt(KEY_LIFE_MAX, DEFAULT_LIFE_MAX);
-  arc_segment_t seg = {0};
-  int arc_life = life_total;
-  if (arc_life < 0)
-    arc_life = 0;
-  if (max_life <= 0)
-    max_life = 40;
-  float circumference = M_PI * SCREEN_DIAMETER;
-  float gap_px = 200.0f;
-  float gap_deg = (gap_px / circumference) * 360.0f;
-  float arc_span = 360.0f - gap_deg;
-  float arc_half = arc_span / 2.0f;
-  int base_start = (int)(270.0f - arc_half + 0.5f);
-  int base_end = (int)(270.0f + arc_half + 0.5f);
-
-  lv_color_t arc_color;
-  if (arc_life >= (int)(0.875 * max_life))
-  {
-    arc_color = GREEN_COLOR;
-  }
-  else if (arc_life >= (int)(0.55 * max_life))
-  {
-    uint8_t t = (uint8_t)(((arc_life - (int)(0.55 * max_life)) * 255) / ((int)(0.875 * max_life) - (int)(0.55 * max_life)));
-    arc_color = interpolate_color(YELLOW_COLOR, GREEN_COLOR, t);
-  }
-  else if (arc_life >= (int)(0.25 * max_life))
-  {
-    uint8_t t = (uint8_t)(((arc_life - (int)(0.25 * max_life)) * 255) / ((int)(0.55 * max_life) - (int)(0.25 * max_life)));
-    arc_color = interpolate_color(RED_COLOR, YELLOW_COLOR, t);
-  }
-  else
-  {
-    arc_color = RED_COLOR;
-  }
-
-  if (arc_life >= (int)(0.875 * max_life))
-  {
-    arc_color = GREEN_COLOR;
-  }
-
-  if (arc_life > max_life)
-  {
-    seg.start_angle = base_start;
-    seg.end_angle = base_start + (int)arc_span;
-    seg.color = arc_color;
-    return seg;
-  }
-  if (arc_life == max_life)
-  {
-    seg.start_angle = base_start;
-    seg.end_angle = base_end % 360;
-    seg.color = arc_color;
-    return seg;
-  }
-  if (arc_life <= 0)
-  {
-    seg.start_angle = base_start;
-    seg.end_angle = base_start;
-    seg.color = arc_color;
-    return seg;
-  }
-
-  int sweep = (int)(arc_span * ((float)arc_life / (float)max_life) + 0.5f);
-  int end_angle = (base_start + sweep) % 360;
-  seg.start_angle = base_start;
-  seg.end_angle = end_angle;
-  seg.color = arc_color;
-  return seg;
-}
-
 void update_life_label(int new_life_total)
 {
   if (life_label != nullptr)
   {
-    char buf[8];
-    snprintf(buf, sizeof(buf), "%d", new_life_total);
-    lv_label_set_text(life_label, buf);
+    digit_label_set_value(life_label, new_life_total);
+#if LATENCY_TRACE
+    lv_area_t area;
+    lv_obj_get_coords(life_label, &area);
+    LTRACE_LABEL(&area);
+#endif
   }
   if (life_arc != nullptr)
   {
-    arc_segment_t seg = life_to_arc(new_life_total);
-    uint16_t c16 = lv_color_to_u16(seg.color);
-    uint8_t r = (c16 >> 11) & 0x1F;
-    uint8_t g = (c16 >> 5) & 0x3F;
-    uint8_t b = c16 & 0x1F;
-    r = (r << 3) | (r >> 2);
-    g = (g << 2) | (g >> 4);
-    b = (b << 3) | (b >> 2);
+    arc_segment_t seg = life_arc_lookup(LIFE_ARC_SINGLE, new_life_total);
     lv_arc_set_angles(life_arc, seg.start_angle, seg.end_angle);
     lv_obj_set_style_arc_color(life_arc, seg.color, LV_PART_INDICATOR);
   }
@@ -456,6 +399,7 @@ void life_counter_loop()
 
 void queue_life_change(int player, int value)
 {
+  LTRACE_MARK(LTRACE_LIFE_QUEUED);
   if (grouped_change_label != nullptr && !is_initializing)
   {
     int pending_change = event_grouper.getPendingChange() + value;
@@ -483,6 +427,7 @@ void queue_life_change(int player, int value)
     event_grouper.handleChange(player, value, get_elapsed_seconds(), [](const LifeHistoryEvent &evt) {
       // *** AUTO-SAVE: Save life to NVS whenever a change is committed ***
       saveLifeToNVS(evt.life_total, evt.player_id);
+      life_journal_append(evt);
     });
   }
   else if (grouped_change_label == nullptr && !is_initializing)
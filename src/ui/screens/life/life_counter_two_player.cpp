@@ -15,6 +15,8 @@
 // Core System
 // ============================================
 #include "core/state_manager.h"
+#include "core/boot_profiler.h"
+#include "core/latency_trace.h"
 
 // ============================================
 // UI Screens
@@ -22,17 +24,24 @@
 #include "ui/screens/menu/menu.h"
 #include "ui/screens/tools/timer.h"
 
+// ============================================
+// UI Components
+// ============================================
+#include "ui/components/digit_label.h"
+
 // ============================================
 // UI Helpers
 // ============================================
 #include "ui/helpers/animation_helpers.h"
 #include "ui/helpers/gestures.h"
 #include "ui/helpers/event_grouper.h"
+#include "ui/helpers/life_arc.h"
 
 // ============================================
 // Data Layer
 // ============================================
 #include "data/constants.h"
+#include "data/life_journal.h"
 
 // ============================================
 // Hardware/Storage
@@ -41,7 +50,6 @@
 
 
 // --- Two Player Life Counter GUI State ---
-#define ARC_GAP_DEGREES 60
 lv_obj_t *life_counter_container_2p = nullptr; // Global for menu access
 static lv_obj_t *life_arc_p1 = nullptr;
 static lv_obj_t *life_arc_p2 = nullptr;
@@ -57,7 +65,6 @@ static void arc_sweep_anim_cb_p1(void *var, int32_t value);
 static void arc_sweep_anim_cb_p2(void *var, int32_t value);
 static void arc_sweep_anim_ready_cb(lv_anim_t *a);
 static void life_counter_gesture_event_handler(lv_event_t *e);
-static lv_color_t interpolate_color(lv_color_t c1, lv_color_t c2, uint8_t t);
 void increment_life(int player, int value);
 void decrement_life(int player, int value);
 void reset_life(int player);
@@ -106,12 +113,33 @@ void init_life_counter_2P()
   int max_life = player_store.getInt(KEY_LIFE_MAX, DEFAULT_LIFE_MAX);
   event_grouper_p1.resetHistory(max_life);
   event_grouper_p2.resetHistory(max_life);
+  life_arc_rebuild(max_life, PLAYER_MODE_TWO_PLAYER);
   
   // *** LOAD SAVED LIFE VALUES for animation targets ***
-  target_life_p1 = loadLifeFromNVS(1);  // Player 1
-  target_life_p2 = loadLifeFromNVS(2);  // Player 2
-  event_grouper_p1.resetHistory(target_life_p1);
-  event_grouper_p2.resetHistory(target_life_p2);
+  // The journal restores the whole game, the saved totals are the fallback
+  life_journal_game_t game;
+  if (life_journal_restore(PLAYER_MODE_TWO_PLAYER, &game, [](const LifeHistoryEvent &evt, void *ctx) {
+        if (evt.player_id == PLAYER_TWO)
+          event_grouper_p2.restoreEvent(evt);
+        else
+          event_grouper_p1.restoreEvent(evt); }, NULL))
+  {
+    if (event_grouper_p1.getHistory().empty())
+      event_grouper_p1.resetHistory(game.start_life);
+    if (event_grouper_p2.getHistory().empty())
+      event_grouper_p2.resetHistory(game.start_life_p2);
+    target_life_p1 = event_grouper_p1.getLifeTotal();
+    target_life_p2 = event_grouper_p2.getLifeTotal();
+    printf("[LifePersist] Restored 2P game: %lu events, life %d/%d\n", (unsigned long)game.events, target_life_p1, target_life_p2);
+  }
+  else
+  {
+    target_life_p1 = loadLifeFromNVS(1);  // Player 1
+    target_life_p2 = loadLifeFromNVS(2);  // Player 2
+    event_grouper_p1.resetHistory(target_life_p1);
+    event_grouper_p2.resetHistory(target_life_p2);
+    life_journal_start_game(PLAYER_MODE_TWO_PLAYER, target_life_p1, target_life_p2);
+  }
   if (!life_counter_container_2p)
   {
     life_counter_container_2p = lv_obj_create(lv_scr_act());
@@ -150,15 +178,9 @@ void init_life_counter_2P()
   }
   if (!life_label_p1)
   {
-    life_label_p1 = lv_label_create(life_counter_container_2p);
+    life_label_p1 = digit_label_create(life_counter_container_2p, FONT_DIGITS_72, FONT_DIGITS_48);
     lv_obj_add_flag(life_label_p1, LV_OBJ_FLAG_HIDDEN);
-    lv_label_set_text(life_label_p1, "0");
-    if (event_grouper_p1.getLifeTotal() > 999)
-      lv_obj_set_style_text_font(life_label_p1, &lv_font_montserrat_48, 0);
-    else
-      lv_obj_set_style_text_font(life_label_p1, &lv_font_montserrat_72, 0);
     lv_obj_set_style_text_color(life_label_p1, lv_color_white(), 0);
-    lv_obj_set_style_text_opa(life_label_p1, LV_OPA_TRANSP, 0);
     lv_obj_set_grid_cell(life_label_p1, LV_GRID_ALIGN_CENTER, 1, 1, LV_GRID_ALIGN_START, 1, 1);
   }
   if (!grouped_change_label_p1)
@@ -190,15 +212,9 @@ void init_life_counter_2P()
   }
   if (!life_label_p2)
   {
-    life_label_p2 = lv_label_create(life_counter_container_2p);
+    life_label_p2 = digit_label_create(life_counter_container_2p, FONT_DIGITS_72, FONT_DIGITS_48);
     lv_obj_add_flag(life_label_p2, LV_OBJ_FLAG_HIDDEN);
-    lv_label_set_text(life_label_p2, "0");
-    if (event_grouper_p2.getLifeTotal() > 999)
-      lv_obj_set_style_text_font(life_label_p2, &lv_font_montserrat_48, 0);
-    else
-      lv_obj_set_style_text_font(life_label_p2, &lv_font_montserrat_72, 0);
     lv_obj_set_style_text_color(life_label_p2, lv_color_white(), 0);
-    lv_obj_set_style_text_opa(life_label_p2, LV_OPA_TRANSP, 0);
     lv_obj_set_grid_cell(life_label_p2, LV_GRID_ALIGN_CENTER, 3, 1, LV_GRID_ALIGN_START, 1, 1);
   }
   if (!grouped_change_label_p2)
@@ -320,6 +336,7 @@ void reset_life_2p()
   update_life_label(1, life_value);
   event_grouper_p2.resetHistory(life_value);
   update_life_label(2, life_value);
+  life_journal_start_game(PLAYER_MODE_TWO_PLAYER, life_value);
   
   // *** AUTO-SAVE: Clear saved data when user resets (Two-Player) ***
   clearSavedLife();
@@ -334,15 +351,6 @@ static void arc_sweep_anim_cb_p1(void *var, int32_t v)
   if (interpolated_life > target_life_p1)
     interpolated_life = target_life_p1;
   
-  int max_life = player_store.getInt(KEY_LIFE_MAX, DEFAULT_LIFE_MAX);
-  int arc_start = 90 + ARC_GAP_DEGREES / 2;
-  int arc_end = 270;
-  int arc_span = arc_end - arc_start;
-  int sweep = (int)(arc_span * ((float)interpolated_life / (float)max_life) + 0.5f);
-  int end_angle = arc_start + sweep;
-  if (end_angle > arc_end)
-    end_angle = arc_end;
-  lv_arc_set_angles(life_arc_p1, arc_start, end_angle);
   update_life_label(1, interpolated_life);
 }
 
@@ -355,17 +363,6 @@ static void arc_sweep_anim_cb_p2(void *var, int32_t v)
   if (interpolated_life > target_life_p2)
     interpolated_life = target_life_p2;
   
-  int max_life = player_store.getInt(KEY_LIFE_MAX, DEFAULT_LIFE_MAX);
-  int arc_start = 270;
-  int arc_end = 90 - ARC_GAP_DEGREES / 2;
-  int arc_span = (arc_end - arc_start + 360) % 360;
-  int sweep = (int)(arc_span * ((float)interpolated_life / (float)max_life) + 0.5f);
-  if (arc_span == 0)
-    arc_span = 360;
-  if (sweep > arc_span)
-    sweep = arc_span;
-  int anim_end = (arc_end - sweep + 360) % 360;
-  lv_arc_set_angles(life_arc_p2, anim_end, arc_end);
   update_life_label(2, interpolated_life);
 }
 
@@ -374,6 +371,7 @@ static void arc_sweep_anim_ready_cb(lv_anim_t *a)
 {
   // Values already loaded in init, just finish initialization
   is_initializing_2p = false;
+  boot_mark_interactive();
   
   register_gesture_callback(GestureType::TapTopLeft, []()
                             { increment_life(PLAYER_ONE, step_size_t::STEP_SIZE_SMALL); });
@@ -403,78 +401,6 @@ static void arc_sweep_anim_ready_cb(lv_anim_t *a)
   });
 }
 
-// Player 1: arc grows clockwise from 90° to 270°
-static arc_segment_t life_to_arc_p1(int life_total)
-{
-  int max_life = player_store.getInt(KEY_LIFE_MAX, DEFAULT_LIFE_MAX);
-  arc_segment_t seg = {0};
-  int arc_life = life_total;
-  if (arc_life < 0)
-    arc_life = 0;
-  if (arc_life > max_life)
-    arc_life = max_life;
-  lv_color_t arc_color;
-  if (arc_life >= (int)(0.875 * max_life))
-    arc_color = GREEN_COLOR;
-  else if (arc_life >= (int)(0.55 * max_life))
-    arc_color = interpolate_color(YELLOW_COLOR, GREEN_COLOR, (uint8_t)(((arc_life - (int)(0.55 * max_life)) * 255) / ((int)(0.875 * max_life) - (int)(0.55 * max_life))));
-  else if (arc_life >= (int)(0.25 * max_life))
-    arc_color = interpolate_color(RED_COLOR, YELLOW_COLOR, (uint8_t)(((arc_life - (int)(0.25 * max_life)) * 255) / ((int)(0.55 * max_life) - (int)(0.25 * max_life))));
-  else
-    arc_color = RED_COLOR;
-  if (arc_life >= (int)(0.875 * max_life))
-    arc_color = GREEN_COLOR;
-  int arc_start = 90 + ARC_GAP_DEGREES / 2;
-  int arc_end = 270;
-  int arc_span = arc_end - arc_start;
-  int sweep = (int)(arc_span * ((float)arc_life / (float)max_life) + 0.5f);
-  int seg_end = arc_start + sweep;
-  if (seg_end > arc_end)
-    seg_end = arc_end;
-  seg.start_angle = arc_start;
-  seg.end_angle = seg_end;
-  seg.color = arc_color;
-  return seg;
-}
-
-// Player 2: arc grows counterclockwise from 270° to 90°
-static arc_segment_t life_to_arc_p2(int life_total)
-{
-  int max_life = player_store.getInt(KEY_LIFE_MAX, DEFAULT_LIFE_MAX);
-  arc_segment_t seg = {0};
-  int arc_life = life_total;
-  if (arc_life < 0)
-    arc_life = 0;
-  if (arc_life > max_life)
-    arc_life = max_life;
-  lv_color_t arc_color;
-  if (arc_life >= (int)(0.875 * max_life))
-    arc_color = GREEN_COLOR;
-  else if (arc_life >= (int)(0.55 * max_life))
-    arc_color = interpolate_color(YELLOW_COLOR, GREEN_COLOR, (uint8_t)(((arc_life - (int)(0.55 * max_life)) * 255) / ((int)(0.875 * max_life) - (int)(0.55 * max_life))));
-  else if (arc_life >= (int)(0.25 * max_life))
-    arc_color = interpolate_color(RED_COLOR, YELLOW_COLOR, (uint8_t)(((arc_life - (int)(0.25 * max_life)) * 255) / ((int)(0.55 * max_life) - (int)(0.25 * max_life))));
-  else
-    arc_color = RED_COLOR;
-  if (arc_life >= (int)(0.875 * max_life))
-    arc_color = GREEN_COLOR;
-
-  int arc_start = 270;
-  int arc_end = 90 - ARC_GAP_DEGREES / 2;
-  int arc_span = (arc_end - arc_start + 360) % 360;
-  float percent = (float)arc_life / (float)max_life;
-  int sweep = (int)(arc_span * percent + 0.5f);
-  if (arc_span == 0)
-    arc_span = 360;
-  if (sweep > arc_span)
-    sweep = arc_span;
-  int seg_start = (arc_end - sweep + 360) % 360;
-  seg.start_angle = seg_start;
-  seg.end_angle = arc_end;
-  seg.color = arc_color;
-  return seg;
-}
-
 // Update the life label and arc for Player 1 or 2
 void update_life_label(int player, int new_life_total)
 {
@@ -483,42 +409,22 @@ void update_life_label(int player, int new_life_total)
 
   if (life_label != nullptr)
   {
-    char buf[8];
-    snprintf(buf, sizeof(buf), "%d", new_life_total);
-    lv_label_set_text(life_label, buf);
+    digit_label_set_value(life_label, new_life_total);
+#if LATENCY_TRACE
+    lv_area_t area;
+    lv_obj_get_coords(life_label, &area);
+    LTRACE_LABEL(&area);
+#endif
   }
 
   if (life_arc != nullptr)
   {
-    arc_segment_t seg = (player == 1) ? life_to_arc_p1(new_life_total) : life_to_arc_p2(new_life_total);
+    arc_segment_t seg = life_arc_lookup((player == 1) ? LIFE_ARC_P1 : LIFE_ARC_P2, new_life_total);
     lv_arc_set_angles(life_arc, seg.start_angle, seg.end_angle);
     lv_obj_set_style_arc_color(life_arc, seg.color, LV_PART_INDICATOR);
   }
 }
 
-// Helper for color interpolation
-static lv_color_t interpolate_color(lv_color_t c1, lv_color_t c2, uint8_t t)
-{
-  uint16_t c1_16 = lv_color_to_u16(c1);
-  uint16_t c2_16 = lv_color_to_u16(c2);
-  uint8_t r1 = (c1_16 >> 11) & 0x1F;
-  uint8_t g1 = (c1_16 >> 5) & 0x3F;
-  uint8_t b1 = c1_16 & 0x1F;
-  uint8_t r2 = (c2_16 >> 11) & 0x1F;
-  uint8_t g2 = (c2_16 >> 5) & 0x3F;
-  uint8_t b2 = c2_16 & 0x1F;
-  r1 = (r1 << 3) | (r1 >> 2);
-  g1 = (g1 << 2) | (g1 >> 4);
-  b1 = (b1 << 3) | (b1 >> 2);
-  r2 = (r2 << 3) | (r2 >> 2);
-  g2 = (g2 << 2) | (g2 >> 4);
-  b2 = (b2 << 3) | (b2 >> 2);
-  uint8_t r = (uint8_t)(r1 + ((int)r2 - (int)r1) * t / 255);
-  uint8_t g = (uint8_t)(g1 + ((int)g2 - (int)g1) * t / 255);
-  uint8_t b = (uint8_t)(b1 + ((int)b2 - (int)b1) * t / 255);
-  return lv_color_make(r, g, b);
-}
-
 void life_counter2p_loop()
 {
   if (event_grouper_p1.isCommitPending())
@@ -533,6 +439,7 @@ void life_counter2p_loop()
 
 void queue_life_change_2p(int player, int value)
 {
+  LTRACE_MARK(LTRACE_LIFE_QUEUED);
   EventGrouper *grouper = (player == 1) ? &event_grouper_p1 : &event_grouper_p2;
   lv_obj_t *grouped_change_label = (player == 1) ? grouped_change_label_p1 : grouped_change_label_p2;
   if (grouped_change_label != nullptr && !is_initializing_2p)
@@ -565,5 +472,6 @@ void queue_life_change_2p(int player, int value)
   grouper->handleChange(player, value, get_elapsed_seconds(), [](const LifeHistoryEvent &evt) {
     // *** AUTO-SAVE: Save life to NVS whenever a change is committed (Two-Player) ***
     saveLifeToNVS(evt.life_total, evt.player_id);
+    life_journal_append(evt);
   });
 }
\ No newline at end of file
@@ -47,6 +47,8 @@
 #include "ui/helpers/animation_helpers.h"
 #include "ui/helpers/tap_layer.h"
 #include "ui/helpers/event_grouper.h"
+#include "ui/helpers/screen_cache.h"
+#include "ui/helpers/transition.h"
 
 // ============================================
 // Data Layer
@@ -74,6 +76,8 @@ static void showLifeScreen();
 void hideLifeScreen();
 void teardownContextualMenuOverlay();
 static bool is_in_center_cancel_area(lv_event_t *e);
+static uint32_t contextualMenuStamp(screen_key_t key);
+static lv_obj_t *buildContextualMenu(screen_key_t key);
 void renderMenu(MenuState menuType);
 void renderMenu(MenuState menuType, bool animate_menu);
 bool is_in_quadrant(lv_event_t *e, int angle_start, int angle_end);
@@ -192,19 +196,23 @@ void show_tcg_result_popup(const char* title, const char* result) {
   lv_timer_set_repeat_count(timer, 1);
 }
 
-void renderDiceListMenu() {
-  teardownDiceListMenu();
-  hideLifeScreen();
-  
-  dice_list_menu = lv_obj_create(lv_scr_act());
-  lv_obj_set_size(dice_list_menu, SCREEN_WIDTH - 20, SCREEN_HEIGHT - 30);
-  lv_obj_center(dice_list_menu);
-  lv_obj_set_style_bg_color(dice_list_menu, lv_color_hex(0x000000), 0);
-  lv_obj_set_style_radius(dice_list_menu, 15, 0);
-  lv_obj_set_style_border_width(dice_list_menu, 0, 0);
-  lv_obj_set_flex_flow(dice_list_menu, LV_FLEX_FLOW_COLUMN);
-  lv_obj_set_flex_align(dice_list_menu, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-  lv_obj_set_scrollbar_mode(dice_list_menu, LV_SCROLLBAR_MODE_AUTO);
+// The swipe handler is only installed when swipe-to-close is on
+static uint32_t diceListMenuStamp(screen_key_t key)
+{
+  return (uint32_t)player_store.getInt(KEY_SWIPE_TO_CLOSE, 0);
+}
+
+static lv_obj_t *buildDiceListMenu(screen_key_t key)
+{
+  lv_obj_t *menu = lv_obj_create(lv_scr_act());
+  lv_obj_set_size(menu, SCREEN_WIDTH - 20, SCREEN_HEIGHT - 30);
+  lv_obj_center(menu);
+  lv_obj_set_style_bg_color(menu, lv_color_hex(0x000000), 0);
+  lv_obj_set_style_radius(menu, 15, 0);
+  lv_obj_set_style_border_width(menu, 0, 0);
+  lv_obj_set_flex_flow(menu, LV_FLEX_FLOW_COLUMN);
+  lv_obj_set_flex_align(menu, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+  lv_obj_set_scrollbar_mode(menu, LV_SCROLLBAR_MODE_AUTO);
   
   // SWIPE DIREKT AUF DEM MENU
   bool swipe_enabled = (player_store.getInt(KEY_SWIPE_TO_CLOSE, 0) != 0);
@@ -212,7 +220,7 @@ void renderDiceListMenu() {
     static lv_point_t dice_start_point;
     static bool dice_is_swiping = false;
     
-    lv_obj_add_event_cb(dice_list_menu, [](lv_event_t *e) {
+    lv_obj_add_event_cb(menu, [](lv_event_t *e) {
       lv_event_code_t code = lv_event_get_code(e);
       
       if (code == LV_EVENT_PRESSED) {
@@ -249,14 +257,14 @@ void renderDiceListMenu() {
     }, LV_EVENT_ALL, NULL);
   }
   
-  lv_obj_t *title = lv_label_create(dice_list_menu);
+  lv_obj_t *title = lv_label_create(menu);
   lv_label_set_text(title, "DICE");
   lv_obj_set_style_text_color(title, LIGHTNING_BLUE_COLOR, 0);
   lv_obj_set_style_text_font(title, &lv_font_montserrat_20, 0);
   lv_obj_set_style_pad_bottom(title, 10, 0);
   
   for (int i = 0; i < DICE_TYPE_COUNT; i++) {
-    lv_obj_t *btn = lv_btn_create(dice_list_menu);
+    lv_obj_t *btn = lv_btn_create(menu);
     lv_obj_set_size(btn, 160, 40);
     lv_obj_set_style_bg_color(btn, LIGHTNING_BLUE_COLOR, 0);
     lv_obj_set_user_data(btn, (void*)(intptr_t)i);
@@ -274,7 +282,7 @@ void renderDiceListMenu() {
     lv_obj_center(lbl);
   }
   
-  lv_obj_t *btn_back = lv_btn_create(dice_list_menu);
+  lv_obj_t *btn_back = lv_btn_create(menu);
   lv_obj_set_size(btn_back, 160, 40);
   lv_obj_set_style_bg_color(btn_back, lv_color_white(), 0);
   lv_obj_set_style_margin_top(btn_back, 10, 0);
@@ -286,10 +294,33 @@ void renderDiceListMenu() {
   lv_label_set_text(lbl_back, LV_SYMBOL_LEFT " Back");
   lv_obj_set_style_text_color(lbl_back, lv_color_black(), 0);
   lv_obj_center(lbl_back);
-  
+  return menu;
+}
+
+void renderDiceListMenu() {
+  teardownDiceListMenu();
+  hideLifeScreen();
+  dice_list_menu = screen_cache_show(SCREEN_KEY(MENU_DICE_LIST, 0));
+  if (dice_list_menu)
+    lv_obj_scroll_to_y(dice_list_menu, 0, LV_ANIM_OFF);
   currentMenu = MENU_DICE_LIST;
 }
 
+void benchmarkMenuTransition(uint32_t frames)
+{
+  renderMenu(MENU_CONTEXTUAL, false);
+  lv_refr_now(NULL);
+  transition_benchmark(contextual_menu, frames);
+  renderMenu(MENU_NONE);
+}
+
+void initMenuScreens()
+{
+  for (int page = 0; page < TOTAL_MENU_PAGES; page++)
+    screen_cache_register(SCREEN_KEY(MENU_CONTEXTUAL, page), buildContextualMenu, contextualMenuStamp, true);
+  screen_cache_register(SCREEN_KEY(MENU_DICE_LIST, 0), buildDiceListMenu, diceListMenuStamp, false);
+}
+
 void renderPresetListMenu() {
   teardownPresetListMenu();
   hideLifeScreen();
@@ -395,58 +426,64 @@ void renderPresetListMenu() {
   currentMenu = MENU_PRESET_LIST;
 }
 
-void renderContextualMenuOverlay(bool animate_menu)
+// The 2P/1P label depends on the player mode
+static uint32_t contextualMenuStamp(screen_key_t key)
 {
-  teardownContextualMenuOverlay();
+  return (uint32_t)player_store.getInt(KEY_PLAYER_MODE, PLAYER_MODE_ONE_PLAYER);
+}
+
+static lv_obj_t *buildContextualMenu(screen_key_t key)
+{
+  int page = (int)(key & 0xFF);
   int circle_diameter = (SCREEN_WIDTH < SCREEN_HEIGHT ? SCREEN_WIDTH : SCREEN_HEIGHT);
   int circle_radius = circle_diameter / 2;
 
-  contextual_menu = lv_obj_create(lv_scr_act());
-  lv_obj_set_size(contextual_menu, circle_diameter, circle_diameter);
-  lv_obj_set_style_bg_color(contextual_menu, lv_color_black(), LV_PART_MAIN);
-  lv_obj_set_style_bg_opa(contextual_menu, LV_OPA_COVER, LV_PART_MAIN);
-  lv_obj_set_style_border_opa(contextual_menu, LV_OPA_TRANSP, LV_PART_MAIN);
-  lv_obj_set_style_outline_opa(contextual_menu, LV_OPA_TRANSP, LV_PART_MAIN);
-  lv_obj_set_style_radius(contextual_menu, LV_RADIUS_CIRCLE, LV_PART_MAIN);
-  lv_obj_align(contextual_menu, LV_ALIGN_CENTER, 0, 0);
-  lv_obj_clear_flag(contextual_menu, LV_OBJ_FLAG_SCROLLABLE);
-  lv_obj_clear_flag(contextual_menu, LV_OBJ_FLAG_GESTURE_BUBBLE);
+  lv_obj_t *menu = lv_obj_create(lv_scr_act());
+  lv_obj_set_size(menu, circle_diameter, circle_diameter);
+  lv_obj_set_style_bg_color(menu, lv_color_black(), LV_PART_MAIN);
+  lv_obj_set_style_bg_opa(menu, LV_OPA_COVER, LV_PART_MAIN);
+  lv_obj_set_style_border_opa(menu, LV_OPA_TRANSP, LV_PART_MAIN);
+  lv_obj_set_style_outline_opa(menu, LV_OPA_TRANSP, LV_PART_MAIN);
+  lv_obj_set_style_radius(menu, LV_RADIUS_CIRCLE, LV_PART_MAIN);
+  lv_obj_align(menu, LV_ALIGN_CENTER, 0, 0);
+  lv_obj_clear_flag(menu, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_clear_flag(menu, LV_OBJ_FLAG_GESTURE_BUBBLE);
 
   int ring_radius = circle_radius;
   
-  if (current_menu_page == 0) {
-    lv_obj_t *lbl_tl = lv_label_create(contextual_menu);
+  if (page == 0) {
+    lv_obj_t *lbl_tl = lv_label_create(menu);
     lv_label_set_text(lbl_tl, LV_SYMBOL_SETTINGS);
     lv_obj_set_style_text_font(lbl_tl, &lv_font_montserrat_40, 0);
     lv_obj_align(lbl_tl, LV_ALIGN_CENTER, -ring_radius / 2, -ring_radius / 2);
 
-    lv_obj_t *lbl_tr = lv_label_create(contextual_menu);
+    lv_obj_t *lbl_tr = lv_label_create(menu);
     const char *lbl_text = player_store.getInt(KEY_PLAYER_MODE, PLAYER_MODE_ONE_PLAYER) == PLAYER_MODE_ONE_PLAYER ? "2P" : "1P";
     lv_label_set_text(lbl_tr, lbl_text);
     lv_obj_set_style_text_font(lbl_tr, &lv_font_montserrat_40, 0);
     lv_obj_align(lbl_tr, LV_ALIGN_CENTER, ring_radius / 2, -ring_radius / 2);
 
-    lv_obj_t *lbl_bl = lv_label_create(contextual_menu);
+    lv_obj_t *lbl_bl = lv_label_create(menu);
     lv_label_set_text(lbl_bl, LV_SYMBOL_REFRESH);
     lv_obj_set_style_text_font(lbl_bl, &lv_font_montserrat_40, 0);
     lv_obj_align(lbl_bl, LV_ALIGN_CENTER, -ring_radius / 2, ring_radius / 2);
 
-    lv_obj_t *lbl_br = lv_label_create(contextual_menu);
+    lv_obj_t *lbl_br = lv_label_create(menu);
     lv_label_set_text(lbl_br, LV_SYMBOL_LIST);
     lv_obj_set_style_text_font(lbl_br, &lv_font_montserrat_40, 0);
     lv_obj_align(lbl_br, LV_ALIGN_CENTER, ring_radius / 2, ring_radius / 2);
   } else {
-    lv_obj_t *lbl_tl = lv_label_create(contextual_menu);
+    lv_obj_t *lbl_tl = lv_label_create(menu);
     lv_label_set_text(lbl_tl, "D");
     lv_obj_set_style_text_font(lbl_tl, &lv_font_montserrat_40, 0);
     lv_obj_align(lbl_tl, LV_ALIGN_CENTER, -ring_radius / 2, -ring_radius / 2);
 
-    lv_obj_t *lbl_tr = lv_label_create(contextual_menu);
+    lv_obj_t *lbl_tr = lv_label_create(menu);
     lv_label_set_text(lbl_tr, "C");
     lv_obj_set_style_text_font(lbl_tr, &lv_font_montserrat_40, 0);
     lv_obj_align(lbl_tr, LV_ALIGN_CENTER, ring_radius / 2, -ring_radius / 2);
 
-    lv_obj_t *lbl_bl = lv_label_create(contextual_menu);
+    lv_obj_t *lbl_bl = lv_label_create(menu);
     lv_label_set_text(lbl_bl, LV_SYMBOL_DOWNLOAD);
     lv_obj_set_style_text_font(lbl_bl, &lv_font_montserrat_40, 0);
     lv_obj_align(lbl_bl, LV_ALIGN_CENTER, -ring_radius / 2, ring_radius / 2);
@@ -454,7 +491,7 @@ void renderContextualMenuOverlay(bool animate_menu)
 
   static bool swipe_detected = false;
   
-  lv_obj_add_event_cb(contextual_menu, [](lv_event_t *e) {
+  lv_obj_add_event_cb(menu, [](lv_event_t *e) {
     lv_event_code_t code = lv_event_get_code(e);
     
     if (code == LV_EVENT_PRESSED) {
@@ -489,10 +526,10 @@ void renderContextualMenuOverlay(bool animate_menu)
     }
   }, LV_EVENT_ALL, NULL);
 
-  lv_obj_add_flag(contextual_menu, LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_add_flag(menu, LV_OBJ_FLAG_CLICKABLE);
 
   int hole_diameter = (ring_radius / 3) * 2;
-  lv_obj_t *center_cancel = lv_btn_create(contextual_menu);
+  lv_obj_t *center_cancel = lv_btn_create(menu);
   lv_obj_set_size(center_cancel, hole_diameter, hole_diameter);
   lv_obj_align(center_cancel, LV_ALIGN_CENTER, 0, 0);
   lv_obj_set_style_radius(center_cancel, LV_RADIUS_CIRCLE, 0);
@@ -504,7 +541,7 @@ void renderContextualMenuOverlay(bool animate_menu)
     renderMenu(MENU_NONE); }, LV_EVENT_CLICKED, NULL);
   lv_obj_t *lbl_cancel = lv_label_create(center_cancel);
   lv_label_set_text(lbl_cancel, LV_SYMBOL_CLOSE);
-  lv_obj_set_style_text_font(lbl_cancel, &lv_font_montserrat_48, 0);
+  lv_obj_set_style_text_font(lbl_cancel, FONT_DIGITS_48, 0);  // the numeric subset carries the close glyph
   lv_obj_center(lbl_cancel);
 
   int dot_size = 8;
@@ -513,14 +550,14 @@ void renderContextualMenuOverlay(bool animate_menu)
   int y_pos = circle_radius + 75;
   
   for (int i = 0; i < TOTAL_MENU_PAGES; i++) {
-    lv_obj_t *dot = lv_obj_create(contextual_menu);
+    lv_obj_t *dot = lv_obj_create(menu);
     lv_obj_set_size(dot, dot_size, dot_size);
     lv_obj_set_pos(dot, start_x + (i * dot_spacing) - (TOTAL_MENU_PAGES * dot_spacing / 2), y_pos);
     lv_obj_set_style_radius(dot, LV_RADIUS_CIRCLE, 0);
     lv_obj_set_style_border_width(dot, 0, 0);
     lv_obj_clear_flag(dot, LV_OBJ_FLAG_CLICKABLE);
     
-    if (i == current_menu_page) {
+    if (i == page) {
       lv_obj_set_style_bg_color(dot, LIGHTNING_BLUE_COLOR, 0);
       lv_obj_set_style_bg_opa(dot, LV_OPA_COVER, 0);
     } else {
@@ -528,11 +565,23 @@ void renderContextualMenuOverlay(bool animate_menu)
       lv_obj_set_style_bg_opa(dot, LV_OPA_50, 0);
     }
   }
+  return menu;
+}
+
+void renderContextualMenuOverlay(bool animate_menu)
+{
+  teardownContextualMenuOverlay();
+  contextual_menu = screen_cache_show(SCREEN_KEY(MENU_CONTEXTUAL, current_menu_page));
+  if (!contextual_menu)
+    return;
 
   if (animate_menu)
   {
-    lv_obj_set_y(contextual_menu, -SCREEN_HEIGHT);
-    slide_in_obj_vertical(contextual_menu, -SCREEN_HEIGHT, 0, 250, 0, nullptr);
+    transition_slide_in_vertical(contextual_menu, -SCREEN_HEIGHT, 0, 250);
+  }
+  else
+  {
+    lv_obj_align(contextual_menu, LV_ALIGN_CENTER, 0, 0);
   }
 }
 
@@ -678,7 +727,9 @@ void teardownContextualMenuOverlay()
 {
   if (contextual_menu)
   {
-    lv_obj_del(contextual_menu);
+    transition_cancel(contextual_menu);
+    if (!screen_cache_hide(contextual_menu))
+      lv_obj_del(contextual_menu);
     contextual_menu = nullptr;
   }
 }
@@ -687,7 +738,8 @@ void teardownDiceListMenu()
 {
   if (dice_list_menu)
   {
-    lv_obj_del(dice_list_menu);
+    if (!screen_cache_hide(dice_list_menu))
+      lv_obj_del(dice_list_menu);
     dice_list_menu = nullptr;
   }
 }
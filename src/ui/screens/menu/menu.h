@@ -4,6 +4,8 @@
 void renderMenu(MenuState menuType);
 void renderMenu(MenuState menuType, bool animate_menu);
 void teardownAllMenus();
+void initMenuScreens();
+void benchmarkMenuTransition(uint32_t frames);
 MenuState getCurrentMenu();
 void hideLifeScreen();
 void resetActiveCounter();
\ No newline at end of file
@@ -142,7 +142,7 @@ void renderBrightnessOverlay(MenuState return_menu)
     char buf[8];
     snprintf(buf, sizeof(buf), "%d", brightness);
     lv_label_set_text(value_label, buf);
-    lv_obj_set_style_text_font(value_label, &lv_font_montserrat_36, 0);
+    lv_obj_set_style_text_font(value_label, FONT_DIGITS_36, 0);
     lv_obj_set_grid_cell(value_label, LV_GRID_ALIGN_CENTER, 1, 1, LV_GRID_ALIGN_CENTER, 2, 1);
 
     // Left arrow button (down)
@@ -8,6 +8,7 @@
 // ============================================
 #include <lvgl.h>
 #include <ArduinoNvs.h>
+#include <string.h>
 #include "hardware/display/lvgl_driver.h"  // For global touch calibration variables
 
 // ============================================
@@ -16,6 +17,7 @@
 #include "hardware/touch/touch_cst816.h"
 #include "hardware/peripherals/power_key.h"
 #include "hardware/display/lvgl_driver.h" // For touch calibration globals
+#include "hardware/touch/touch_affine.h"
 
 // ============================================
 // UI Screens
@@ -33,6 +35,7 @@
 #define CALIBRATION_POINTS 5
 #define CALIBRATION_TIMEOUT_MS 30000  // 30 seconds
 #define CONFIRMATION_TIMEOUT_MS 10000 // 10 seconds
+#define CALIBRATION_MAX_RMS_PX 15.0f  // Worse fit = a point was missed, keep the old calibration
 // Emergency BOOT button reset removed - conflicts with ESP32 download mode
 
 // NVS Keys for calibration data
@@ -42,6 +45,7 @@
 #define KEY_TOUCH_SCALE_X "touch_scale_x"
 #define KEY_TOUCH_SCALE_Y "touch_scale_y"
 #define KEY_TOUCH_PENDING_CONFIRM "touch_pending"  // NEW: Pending confirmation flag
+#define KEY_TOUCH_AFFINE "touch_affine"  // TouchAffineBlob, replaces the scale/offset floats
 
 // ============================================
 // STATIC VARIABLES
@@ -70,7 +74,7 @@ static lv_point_t calibration_targets[CALIBRATION_POINTS] = {
     {280, 240}          // Point 5 - Bottom-Right (aligned with Point 2)
 };
 
-// Measured touch coordinates 
+// Measured touch coordinates (raw, before the current calibration)
 static lv_point_t measured_points[CALIBRATION_POINTS];
 
 // ============================================
@@ -89,9 +93,12 @@ void resetTouchCalibrationToDefaults() {
     NVS.setFloat(KEY_TOUCH_SCALE_X, 1.0f);
     NVS.setFloat(KEY_TOUCH_SCALE_Y, 1.0f);
     NVS.setInt(KEY_TOUCH_PENDING_CONFIRM, (int32_t)0);  // Clear pending flag
+    NVS.erase(KEY_TOUCH_AFFINE);
     
     // Apply defaults immediately using API function
-    updateTouchCalibration(1.0f, 1.0f, 0.0f, 0.0f);
+    TouchAffine identity;
+    touch_affine_identity(&identity);
+    updateTouchCalibration(identity);
     
     printf("[TouchCal] Factory defaults restored and applied immediately\n");
 }
@@ -122,71 +129,89 @@ void loadTouchCalibrationFromNVS() {
     // Check if we have valid calibration data
     int cal_valid = NVS.getInt(KEY_TOUCH_CAL_VALID, 0);
     
-    if (cal_valid == 1) {
-        // Load calibration values
-        float scale_x = NVS.getFloat(KEY_TOUCH_SCALE_X, 1.0f);
-        float scale_y = NVS.getFloat(KEY_TOUCH_SCALE_Y, 1.0f);
-        float offset_x = NVS.getFloat(KEY_TOUCH_OFFSET_X, 0.0f);
-        float offset_y = NVS.getFloat(KEY_TOUCH_OFFSET_Y, 0.0f);
-        
-        printf("[TouchCal] Loaded calibration: scale_x=%.3f, scale_y=%.3f, offset_x=%.3f, offset_y=%.3f\n", 
-               scale_x, scale_y, offset_x, offset_y);
-        
-        // Apply to LVGL touch driver - use API function to avoid linker issues
-        updateTouchCalibration(scale_x, scale_y, offset_x, offset_y);
-        
-        printf("[TouchCal] ALL calibration values applied (scale AND offset)\n");
-    } else {
+    if (cal_valid != 1) {
         printf("[TouchCal] No valid calibration found, using factory defaults\n");
+        return;
+    }
+    
+    TouchAffineBlob blob;
+    if (NVS.getBlobSize(KEY_TOUCH_AFFINE) == sizeof(blob) &&
+        NVS.getBlob(KEY_TOUCH_AFFINE, (uint8_t *)&blob, sizeof(blob)) &&
+        blob.version == TOUCH_AFFINE_VERSION) {
+        printf("[TouchCal] Loaded affine calibration: %u points, rms %.2f px\n",
+               blob.points, blob.rms_milli_px / 1000.0f);
+        updateTouchCalibration(blob.m);
+        return;
     }
+    
+    // Older firmware stored per-axis scale and offset, convert once to the blob
+    float scale_x = NVS.getFloat(KEY_TOUCH_SCALE_X, 1.0f);
+    float scale_y = NVS.getFloat(KEY_TOUCH_SCALE_Y, 1.0f);
+    float offset_x = NVS.getFloat(KEY_TOUCH_OFFSET_X, 0.0f);
+    float offset_y = NVS.getFloat(KEY_TOUCH_OFFSET_Y, 0.0f);
+    
+    printf("[TouchCal] Converting old calibration: scale_x=%.3f, scale_y=%.3f, offset_x=%.3f, offset_y=%.3f\n", 
+           scale_x, scale_y, offset_x, offset_y);
+    
+    memset(&blob, 0, sizeof(blob));
+    blob.version = TOUCH_AFFINE_VERSION;
+    touch_affine_from_scale_offset(scale_x, scale_y, offset_x, offset_y,
+                                   LCD_WIDTH / 2, LCD_HEIGHT / 2, &blob.m);
+    NVS.setBlob(KEY_TOUCH_AFFINE, (uint8_t *)&blob, sizeof(blob));
+    
+    // Apply to LVGL touch driver - use API function to avoid linker issues
+    updateTouchCalibration(blob.m);
 }
 
 // ============================================
 // CALIBRATION LOGIC
 // ============================================
 
-static void calculateCalibrationData() {
-    // Real calibration calculation using measured touch points
+/**
+ * @brief Fit raw -> screen over all measured points and store it
+ * @return false if the points gave no usable fit, nothing is changed then
+ */
+static bool calculateCalibrationData() {
     printf("[TouchCal] Calculating calibration from %d measured points\n", CALIBRATION_POINTS);
     
-    // Calculate average offset (difference between target and measured)
-    float total_offset_x = 0.0f;
-    float total_offset_y = 0.0f;
-    
+    TouchCalPoint raw[CALIBRATION_POINTS];
+    TouchCalPoint screen[CALIBRATION_POINTS];
     for (int i = 0; i < CALIBRATION_POINTS; i++) {
-        float diff_x = calibration_targets[i].x - measured_points[i].x;
-        float diff_y = calibration_targets[i].y - measured_points[i].y;
-        total_offset_x += diff_x;
-        total_offset_y += diff_y;
-        
-        printf("[TouchCal] Point %d: Target(%d,%d) Measured(%d,%d) Diff(%.1f,%.1f)\n", 
+        raw[i].x = measured_points[i].x;
+        raw[i].y = measured_points[i].y;
+        screen[i].x = calibration_targets[i].x;
+        screen[i].y = calibration_targets[i].y;
+        printf("[TouchCal] Point %d: Target(%d,%d) Raw(%d,%d)\n", 
                i+1, calibration_targets[i].x, calibration_targets[i].y,
-               measured_points[i].x, measured_points[i].y, diff_x, diff_y);
+               measured_points[i].x, measured_points[i].y);
     }
     
-    float offset_x = total_offset_x / CALIBRATION_POINTS;
-    float offset_y = total_offset_y / CALIBRATION_POINTS;
-    
-    // For now, keep existing scale values (could be calculated from corner points)
-    float scale_x = 0.85f;  // From working calibration
-    float scale_y = 1.0f;   // From working calibration
-    
-    printf("[TouchCal] Calculated: offset_x=%.2f, offset_y=%.2f\n", offset_x, offset_y);
+    TouchAffineBlob blob;
+    float rms = 0.0f;
+    memset(&blob, 0, sizeof(blob));
+    if (!touch_affine_solve(raw, screen, CALIBRATION_POINTS, &blob.m, &rms)) {
+        printf("[TouchCal] Points are degenerate, calibration not changed\n");
+        return false;
+    }
+    if (rms > CALIBRATION_MAX_RMS_PX) {
+        printf("[TouchCal] Fit error %.1f px too large, calibration not changed\n", rms);
+        return false;
+    }
+    blob.version = TOUCH_AFFINE_VERSION;
+    blob.points = CALIBRATION_POINTS;
+    blob.rms_milli_px = (uint32_t)(rms * 1000.0f);
     
     // Store in NVS and mark as pending confirmation
     NVS.setInt(KEY_TOUCH_CAL_VALID, (int32_t)1);
-    NVS.setFloat(KEY_TOUCH_SCALE_X, scale_x);
-    NVS.setFloat(KEY_TOUCH_SCALE_Y, scale_y);
-    NVS.setFloat(KEY_TOUCH_OFFSET_X, offset_x);
-    NVS.setFloat(KEY_TOUCH_OFFSET_Y, offset_y);
+    NVS.setBlob(KEY_TOUCH_AFFINE, (uint8_t *)&blob, sizeof(blob));
     NVS.setInt(KEY_TOUCH_PENDING_CONFIRM, (int32_t)1);  // NEW: Mark as pending confirmation
     
     // Apply calibration immediately using API function
-    updateTouchCalibration(scale_x, scale_y, offset_x, offset_y);
+    updateTouchCalibration(blob.m);
     
-    printf("[TouchCal] Calibration saved and applied immediately: scale_x=%.3f, scale_y=%.3f, offset_x=%.3f, offset_y=%.3f\n", 
-           scale_x, scale_y, offset_x, offset_y);
+    printf("[TouchCal] Calibration saved and applied immediately, rms %.2f px\n", rms);
     printf("[TouchCal] Confirmation will be required on next boot\n");
+    return true;
 }
 
 static void nextCalibrationPoint() {
@@ -194,9 +219,11 @@ static void nextCalibrationPoint() {
     
     if (current_point >= CALIBRATION_POINTS) {
         // Calibration complete - calculate and apply immediately!
-        calculateCalibrationData();
-        
-        lv_label_set_text(instruction_label, "Calibration Complete!\nApplied immediately!\nTouch to exit");
+        if (calculateCalibrationData()) {
+            lv_label_set_text(instruction_label, "Calibration Complete!\nApplied immediately!\nTouch to exit");
+        } else {
+            lv_label_set_text(instruction_label, "Calibration Failed!\nPrevious kept\nTouch to exit");
+        }
         lv_obj_add_flag(target_point, LV_OBJ_FLAG_HIDDEN);
         lv_obj_add_flag(progress_bar, LV_OBJ_FLAG_HIDDEN);
         
@@ -223,11 +250,10 @@ static void calibrationTouchHandler(lv_event_t *e) {
     
     if (code == LV_EVENT_CLICKED) {
         if (current_point < CALIBRATION_POINTS) {
-            // Record touch point
-            lv_indev_t *indev = lv_indev_get_act();
-            lv_indev_get_point(indev, &measured_points[current_point]);
+            // Record the raw controller point, the fit maps raw to screen
+            Lvgl_GetLastRawTouch(&measured_points[current_point]);
             
-            printf("[TouchCal] Point %d: target(%d,%d) measured(%d,%d)\n",
+            printf("[TouchCal] Point %d: target(%d,%d) raw(%d,%d)\n",
                    current_point,
                    calibration_targets[current_point].x,
                    calibration_targets[current_point].y,
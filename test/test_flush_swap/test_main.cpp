@@ -0,0 +1,112 @@
+// Host benchmark of the per-refresh CPU cost of the panel byte order.
+//
+// Before, LVGL rendered native RGB565 and LCD_addWindow swapped every pixel of
+// every chunk in a scalar loop. Now LVGL renders LV_COLOR_FORMAT_RGB565_SWAPPED
+// and the flush hands the buffer to DMA untouched. This replays a full-screen
+// refresh in LVGL_BUF_LEN chunks through both paths, checks that they put the
+// same bytes on the wire and prints the cost per refresh. A host compiler
+// vectorizes the legacy loop, so the absolute numbers are a lower bound for
+// the scalar loop on the S3.
+//
+//   pio test -e native -f test_flush_swap -v
+
+#include <unity.h>
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <board_config.h>
+
+#define CHUNK_LINES   80   // LVGL_BUF_LEN / LCD_WIDTH
+#define REFRESHES     200
+
+static uint16_t frame[LCD_WIDTH * LCD_HEIGHT];
+static uint16_t frame_swapped[LCD_WIDTH * LCD_HEIGHT];
+static volatile uintptr_t sink;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// The loop LCD_addWindow ran on every chunk before RGB565_SWAPPED
+static void legacy_swap(uint16_t *color, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; i++) {
+    color[i] = (((color[i] >> 8) & 0xFF) | ((color[i] << 8) & 0xFF00));
+  }
+}
+
+// Stand-in for esp_lcd_panel_draw_bitmap: queuing only hands over the pointer
+static void queue_transfer(const uint16_t *color, uint32_t size)
+{
+  sink = (uintptr_t)color + size;
+}
+
+static void flush_refresh(uint16_t *buf, bool swap_on_cpu)
+{
+  for (int y = 0; y < LCD_HEIGHT; y += CHUNK_LINES) {
+    int lines = LCD_HEIGHT - y < CHUNK_LINES ? LCD_HEIGHT - y : CHUNK_LINES;
+    uint16_t *chunk = buf + y * LCD_WIDTH;
+    uint32_t size = (uint32_t)lines * LCD_WIDTH;
+    if (swap_on_cpu)
+      legacy_swap(chunk, size);
+    queue_transfer(chunk, size);
+  }
+}
+
+static void fill_pattern(uint16_t *native, uint16_t *swapped)
+{
+  for (uint32_t i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++) {
+    uint16_t c = (uint16_t)(i * 2654435761u >> 16);
+    native[i] = c;
+    // What the RGB565_SWAPPED renderer stores: big-endian RGB565
+    uint8_t *bytes = (uint8_t *)&swapped[i];
+    bytes[0] = (uint8_t)(c >> 8);
+    bytes[1] = (uint8_t)c;
+  }
+}
+
+static double time_refreshes_us(uint16_t *buf, bool swap_on_cpu)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < REFRESHES; i++)
+    flush_refresh(buf, swap_on_cpu);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() / REFRESHES;
+}
+
+static void test_swapped_render_matches_legacy_wire_bytes(void)
+{
+  fill_pattern(frame, frame_swapped);
+  flush_refresh(frame, true);
+  TEST_ASSERT_EQUAL_MEMORY(frame_swapped, frame, sizeof(frame));
+
+  // And the new flush leaves the rendered buffer as it is
+  static uint16_t copy[LCD_WIDTH * LCD_HEIGHT];
+  memcpy(copy, frame_swapped, sizeof(copy));
+  flush_refresh(frame_swapped, false);
+  TEST_ASSERT_EQUAL_MEMORY(copy, frame_swapped, sizeof(copy));
+}
+
+static void test_benchmark_full_screen_refresh(void)
+{
+  fill_pattern(frame, frame_swapped);
+  double legacy_us = time_refreshes_us(frame, true);
+  double swapped_us = time_refreshes_us(frame_swapped, false);
+
+  printf("[flush_swap] %dx%d refresh in %d-line chunks, %d refreshes\n",
+         LCD_WIDTH, LCD_HEIGHT, CHUNK_LINES, REFRESHES);
+  printf("[flush_swap] legacy swap loop : %8.1f us/refresh, %u bytes rewritten\n",
+         legacy_us, (unsigned)sizeof(frame));
+  printf("[flush_swap] RGB565_SWAPPED   : %8.1f us/refresh, 0 bytes rewritten\n", swapped_us);
+
+  TEST_ASSERT_TRUE(swapped_us < legacy_us);
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_swapped_render_matches_legacy_wire_bytes);
+  RUN_TEST(test_benchmark_full_screen_refresh);
+  return UNITY_END();
+}
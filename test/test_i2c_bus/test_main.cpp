@@ -0,0 +1,250 @@
+// Host tests of the queued I2C bus on the register-file mock backend.
+//
+// Covers the queue order (touch ahead of the GPIO expander), the per-device
+// transaction, byte and error counters, the I2C_ERR_ARG and I2C_ERR_QUEUE
+// paths, and the bus and wait times against the wire time the mock computes
+// for each transfer.
+//
+//   pio test -e native -f test_i2c_bus -v
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hardware/peripherals/i2c_bus.h"
+#include "hardware/peripherals/i2c_bus_mock.h"
+
+#define TOUCH_ADDR    0x15   // CST816_ADDR
+#define EXPANDER_ADDR 0x20   // TCA9554_ADDRESS
+#define SENSOR_ADDR   0x48
+#define MISSING_ADDR  0x30
+
+static uint8_t done_order[32];
+static size_t done_count;
+
+static void record_done(I2cTransaction *t)
+{
+  done_order[done_count++] = t->addr;
+}
+
+static void start_bus(void)
+{
+  TEST_ASSERT_TRUE(i2c_bus_init(I2C_BUS_CLOCK_HZ, i2c_mock_backend()));
+  i2c_mock_add_device(TOUCH_ADDR);
+  i2c_mock_add_device(EXPANDER_ADDR);
+  i2c_mock_add_device(SENSOR_ADDR);
+  i2c_bus_set_device_priority(TOUCH_ADDR, I2C_PRIO_HIGH);
+  i2c_bus_set_device_priority(EXPANDER_ADDR, I2C_PRIO_NORMAL);
+  i2c_bus_set_device_priority(SENSOR_ADDR, I2C_PRIO_LOW);
+  i2c_bus_reset_stats();
+  i2c_mock_reset_counters();
+  done_count = 0;
+}
+
+// Wire time of one register read of len bytes: pointer write, then the read
+static uint64_t read_reg_wire_ns(size_t len)
+{
+  uint64_t bits = (2 + 9 + 9 * 1) + (2 + 9 + 9 * (uint64_t)len);
+  return bits * 1000000000ull / I2C_BUS_CLOCK_HZ;
+}
+
+void setUp(void) {}
+
+void tearDown(void)
+{
+  i2c_mock_set_realtime(false);
+}
+
+// Runs first, before anything started the bus
+static void test_submit_before_init_is_a_queue_error(void)
+{
+  uint8_t rx[2];
+  I2cTransaction t;
+  i2c_transaction_read_reg(&t, TOUCH_ADDR, 0x01, rx, sizeof(rx));
+  TEST_ASSERT_FALSE(i2c_bus_submit(&t));
+  TEST_ASSERT_EQUAL(I2C_ERR_QUEUE, t.result);
+  TEST_ASSERT_FALSE(i2c_bus_read_reg(TOUCH_ADDR, 0x01, rx, sizeof(rx)));
+}
+
+static void test_invalid_transactions_are_arg_errors(void)
+{
+  start_bus();
+  TEST_ASSERT_FALSE(i2c_bus_submit(nullptr));
+
+  I2cTransaction t;
+  memset(&t, 0, sizeof(t));
+  t.addr = EXPANDER_ADDR;
+  TEST_ASSERT_FALSE(i2c_bus_submit(&t));  // nothing to write or read
+  TEST_ASSERT_EQUAL(I2C_ERR_ARG, t.result);
+
+  t.tx_len = I2C_BUS_MAX_WRITE + 1;
+  TEST_ASSERT_FALSE(i2c_bus_submit(&t));
+  TEST_ASSERT_EQUAL(I2C_ERR_ARG, t.result);
+
+  uint8_t data[I2C_BUS_MAX_WRITE] = {};
+  TEST_ASSERT_FALSE(i2c_transaction_write_reg(&t, EXPANDER_ADDR, 0x01, data, I2C_BUS_MAX_WRITE));
+  TEST_ASSERT_EQUAL(I2C_ERR_ARG, t.result);
+  TEST_ASSERT_FALSE(i2c_bus_write_reg(EXPANDER_ADDR, 0x01, data, I2C_BUS_MAX_WRITE));
+  TEST_ASSERT_TRUE(i2c_bus_write_reg(EXPANDER_ADDR, 0x01, data, I2C_BUS_MAX_WRITE - 1));
+
+  // Rejected transactions never reach the wire or the counters
+  I2cDeviceStats stats;
+  TEST_ASSERT_TRUE(i2c_bus_get_stats(EXPANDER_ADDR, &stats));
+  TEST_ASSERT_EQUAL(1, stats.transactions);
+  TEST_ASSERT_EQUAL(I2C_BUS_MAX_WRITE, stats.bytes);
+  TEST_ASSERT_EQUAL(1, i2c_mock_get_device(EXPANDER_ADDR)->writes);
+}
+
+static void test_touch_runs_before_expander(void)
+{
+  start_bus();
+  uint8_t rx[5][6];
+  I2cTransaction t[5];
+  i2c_transaction_read_reg(&t[0], SENSOR_ADDR, 0x00, rx[0], 2);
+  i2c_transaction_read_reg(&t[1], EXPANDER_ADDR, 0x00, rx[1], 1);
+  uint8_t out = 0x5A;
+  i2c_transaction_write_reg(&t[2], EXPANDER_ADDR, 0x01, &out, 1);
+  i2c_transaction_read_reg(&t[3], TOUCH_ADDR, 0x01, rx[3], 6);
+  i2c_transaction_read_reg(&t[4], TOUCH_ADDR, 0x01, rx[4], 6);
+
+  i2c_bus_hold(true);
+  for (int i = 0; i < 5; i++)
+  {
+    t[i].done = record_done;
+    TEST_ASSERT_TRUE(i2c_bus_submit(&t[i]));
+    TEST_ASSERT_EQUAL(I2C_PENDING, t[i].result);
+  }
+  TEST_ASSERT_EQUAL(0, done_count);
+  i2c_bus_hold(false);
+
+  const uint8_t expected[] = {TOUCH_ADDR, TOUCH_ADDR, EXPANDER_ADDR, EXPANDER_ADDR, SENSOR_ADDR};
+  TEST_ASSERT_EQUAL(5, done_count);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, done_order, 5);
+  for (int i = 0; i < 5; i++)
+    TEST_ASSERT_EQUAL(I2C_OK, t[i].result);
+  TEST_ASSERT_EQUAL_HEX8(0x5A, i2c_mock_get_device(EXPANDER_ADDR)->regs[0x01]);
+}
+
+static void test_full_queue_is_a_queue_error(void)
+{
+  start_bus();
+  uint8_t rx[I2C_BUS_QUEUE_LENGTH + 2];
+  I2cTransaction t[I2C_BUS_QUEUE_LENGTH + 2];
+
+  i2c_bus_hold(true);
+  for (int i = 0; i < I2C_BUS_QUEUE_LENGTH; i++)
+  {
+    i2c_transaction_read_reg(&t[i], EXPANDER_ADDR, 0x00, &rx[i], 1);
+    TEST_ASSERT_TRUE(i2c_bus_submit(&t[i]));
+  }
+  I2cTransaction *overflow = &t[I2C_BUS_QUEUE_LENGTH];
+  i2c_transaction_read_reg(overflow, EXPANDER_ADDR, 0x00, &rx[I2C_BUS_QUEUE_LENGTH], 1);
+  TEST_ASSERT_FALSE(i2c_bus_submit(overflow));
+  TEST_ASSERT_EQUAL(I2C_ERR_QUEUE, overflow->result);
+
+  // Each priority has its own queue
+  I2cTransaction *touch = &t[I2C_BUS_QUEUE_LENGTH + 1];
+  i2c_transaction_read_reg(touch, TOUCH_ADDR, 0x00, &rx[I2C_BUS_QUEUE_LENGTH + 1], 1);
+  TEST_ASSERT_TRUE(i2c_bus_submit(touch));
+  i2c_bus_hold(false);
+
+  for (int i = 0; i < I2C_BUS_QUEUE_LENGTH; i++)
+    TEST_ASSERT_EQUAL(I2C_OK, t[i].result);
+  TEST_ASSERT_EQUAL(I2C_OK, touch->result);
+  I2cDeviceStats stats;
+  TEST_ASSERT_TRUE(i2c_bus_get_stats(EXPANDER_ADDR, &stats));
+  TEST_ASSERT_EQUAL(I2C_BUS_QUEUE_LENGTH, stats.transactions);
+}
+
+static void test_counters_per_device(void)
+{
+  start_bus();
+  I2cMockDevice *touch = i2c_mock_get_device(TOUCH_ADDR);
+  const uint8_t point[6] = {0x00, 0x01, 0x00, 0xB4, 0x00, 0x5A};
+  memcpy(&touch->regs[0x01], point, sizeof(point));
+
+  uint8_t rx[6];
+  for (int i = 0; i < 3; i++)
+  {
+    TEST_ASSERT_TRUE(i2c_bus_read_reg(TOUCH_ADDR, 0x01, rx, sizeof(rx)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(point, rx, sizeof(rx));
+  }
+  uint8_t out = 0x0F;
+  TEST_ASSERT_TRUE(i2c_bus_write_reg(EXPANDER_ADDR, 0x03, &out, 1));
+  TEST_ASSERT_FALSE(i2c_bus_read_reg(MISSING_ADDR, 0x00, rx, 1));
+
+  I2cDeviceStats stats;
+  TEST_ASSERT_TRUE(i2c_bus_get_stats(TOUCH_ADDR, &stats));
+  TEST_ASSERT_EQUAL(I2C_PRIO_HIGH, stats.prio);
+  TEST_ASSERT_EQUAL(3, stats.transactions);
+  TEST_ASSERT_EQUAL(3 * (1 + 6), stats.bytes);
+  TEST_ASSERT_EQUAL(0, stats.errors);
+  TEST_ASSERT_EQUAL(3, touch->writes);  // register pointer
+  TEST_ASSERT_EQUAL(3, touch->reads);
+
+  TEST_ASSERT_TRUE(i2c_bus_get_stats(EXPANDER_ADDR, &stats));
+  TEST_ASSERT_EQUAL(1, stats.transactions);
+  TEST_ASSERT_EQUAL(2, stats.bytes);
+  TEST_ASSERT_EQUAL(0, stats.errors);
+  TEST_ASSERT_EQUAL_HEX8(0x0F, i2c_mock_get_device(EXPANDER_ADDR)->regs[0x03]);
+
+  TEST_ASSERT_TRUE(i2c_bus_get_stats(MISSING_ADDR, &stats));
+  TEST_ASSERT_EQUAL(1, stats.transactions);
+  TEST_ASSERT_EQUAL(1, stats.errors);
+
+  TEST_ASSERT_FALSE(i2c_bus_get_stats(0x77, &stats));
+
+  i2c_bus_reset_stats();
+  TEST_ASSERT_TRUE(i2c_bus_get_stats(TOUCH_ADDR, &stats));
+  TEST_ASSERT_EQUAL(0, stats.transactions);
+  TEST_ASSERT_EQUAL(I2C_PRIO_HIGH, stats.prio);
+}
+
+static void test_bus_time_matches_wire_time(void)
+{
+  start_bus();
+  i2c_mock_set_realtime(true);
+
+  const int reads = 20;
+  uint8_t rx[6];
+  for (int i = 0; i < reads; i++)
+    TEST_ASSERT_TRUE(i2c_bus_read_reg(TOUCH_ADDR, 0x01, rx, sizeof(rx)));
+
+  I2cMockDevice *touch = i2c_mock_get_device(TOUCH_ADDR);
+  TEST_ASSERT_EQUAL_UINT64(reads * read_reg_wire_ns(6), touch->wire_ns);
+  TEST_ASSERT_EQUAL_UINT64(touch->wire_ns / 1000, i2c_mock_bus_time_us());
+
+  I2cDeviceStats stats;
+  TEST_ASSERT_TRUE(i2c_bus_get_stats(TOUCH_ADDR, &stats));
+  uint64_t wire_us = touch->wire_ns / 1000;
+  // Each transfer is timed in whole microseconds
+  TEST_ASSERT_TRUE(stats.bus.sum_us + reads >= wire_us);
+  TEST_ASSERT_TRUE(stats.bus.sum_us <= 2 * wire_us + 2000);
+  TEST_ASSERT_TRUE(stats.bus.max_us + 1 >= read_reg_wire_ns(6) / 1000);
+
+  // Queued behind three transfers, the last one waits for their wire time
+  I2cTransaction t[4];
+  uint8_t one[4];
+  i2c_bus_hold(true);
+  for (int i = 0; i < 4; i++)
+  {
+    i2c_transaction_read_reg(&t[i], EXPANDER_ADDR, 0x00, &one[i], 1);
+    TEST_ASSERT_TRUE(i2c_bus_submit(&t[i]));
+  }
+  i2c_bus_hold(false);
+  TEST_ASSERT_TRUE(i2c_bus_get_stats(EXPANDER_ADDR, &stats));
+  TEST_ASSERT_EQUAL(4, stats.transactions);
+  TEST_ASSERT_TRUE(stats.wait.max_us + 3 >= 3 * read_reg_wire_ns(1) / 1000);
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_submit_before_init_is_a_queue_error);
+  RUN_TEST(test_invalid_transactions_are_arg_errors);
+  RUN_TEST(test_touch_runs_before_expander);
+  RUN_TEST(test_full_queue_is_a_queue_error);
+  RUN_TEST(test_counters_per_device);
+  RUN_TEST(test_bus_time_matches_wire_time);
+  return UNITY_END();
+}
@@ -0,0 +1,270 @@
+// Host tests of the life journal on its file-backed partition stand-in.
+//
+// Covers the round trip through a simulated reboot (deinit + init), records
+// still queued at restore time, corrupt and torn records, and the ring
+// wrapping past the start of the game it has to restore. The last test times
+// the boot scan and a restore on a full journal.
+//
+//   pio test -e native -f test_life_journal -v
+
+#include <unity.h>
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "data/life_journal.h"
+
+#define SLOTS  (LIFE_JOURNAL_HOST_SIZE / sizeof(life_journal_record_t))
+
+struct Replay
+{
+  uint32_t count;
+  int net[2];        // summed net change, single / player 1 and player 2
+  int last_total[2];
+  int last_change_timestamp;
+};
+
+static Replay replay;
+
+static void collect(const LifeHistoryEvent &evt, void *ctx)
+{
+  Replay *r = (Replay *)ctx;
+  int idx = evt.player_id == 2 ? 1 : 0;
+  r->count++;
+  r->net[idx] += evt.net_life_change;
+  r->last_total[idx] = evt.life_total;
+  r->last_change_timestamp = evt.change_timestamp;
+}
+
+static bool restore(PlayerMode mode, life_journal_game_t *game)
+{
+  replay = {};
+  return life_journal_restore(mode, game, collect, &replay);
+}
+
+static void reboot(void)
+{
+  life_journal_deinit();
+  TEST_ASSERT_TRUE(life_journal_init());
+}
+
+static void append(int player_id, int net, int total, int seconds)
+{
+  LifeHistoryEvent evt = {};
+  evt.player_id = player_id;
+  evt.net_life_change = net;
+  evt.life_total = total;
+  evt.change_timestamp = seconds;
+  life_journal_append(evt);
+}
+
+// Overwrite bytes of the partition file, as a torn write or bit rot would
+static void poke(size_t offset, const void *data, size_t len)
+{
+  FILE *f = fopen(LIFE_JOURNAL_HOST_FILE, "r+b");
+  TEST_ASSERT_NOT_NULL(f);
+  fseek(f, (long)offset, SEEK_SET);
+  fwrite(data, 1, len, f);
+  fclose(f);
+}
+
+void setUp(void)
+{
+  unlink(LIFE_JOURNAL_HOST_FILE);
+  TEST_ASSERT_TRUE(life_journal_init());
+}
+
+void tearDown(void)
+{
+  life_journal_deinit();
+  unlink(LIFE_JOURNAL_HOST_FILE);
+}
+
+static void test_restore_after_reboot(void)
+{
+  life_journal_start_game(PLAYER_MODE_ONE_PLAYER, 20);
+  append(0, -3, 17, 10);
+  append(0, 5, 22, 40);
+  append(0, -1, 21, 70000);  // saturates to 0xFFFF
+  life_journal_flush();
+  reboot();
+
+  life_journal_game_t game;
+  TEST_ASSERT_TRUE(restore(PLAYER_MODE_ONE_PLAYER, &game));
+  TEST_ASSERT_EQUAL(20, game.start_life);
+  TEST_ASSERT_EQUAL(3, game.events);
+  TEST_ASSERT_FALSE(game.from_checkpoint);
+  TEST_ASSERT_EQUAL(3, replay.count);
+  TEST_ASSERT_EQUAL(1, replay.net[0]);
+  TEST_ASSERT_EQUAL(21, replay.last_total[0]);
+  TEST_ASSERT_EQUAL(0xFFFF, replay.last_change_timestamp);
+}
+
+static void test_restore_includes_queued_records(void)
+{
+  life_journal_start_game(PLAYER_MODE_TWO_PLAYER, 40, 30);
+  append(1, -5, 35, 1);
+  life_journal_flush();
+  append(2, -2, 28, 2);  // still queued
+
+  life_journal_game_t game;
+  TEST_ASSERT_TRUE(restore(PLAYER_MODE_TWO_PLAYER, &game));
+  TEST_ASSERT_EQUAL(40, game.start_life);
+  TEST_ASSERT_EQUAL(30, game.start_life_p2);
+  TEST_ASSERT_EQUAL(2, replay.count);
+  TEST_ASSERT_EQUAL(35, replay.last_total[0]);
+  TEST_ASSERT_EQUAL(28, replay.last_total[1]);
+}
+
+static void test_restore_refuses_other_mode(void)
+{
+  life_journal_start_game(PLAYER_MODE_ONE_PLAYER, 20);
+  append(0, -1, 19, 1);
+  life_journal_game_t game;
+  TEST_ASSERT_FALSE(restore(PLAYER_MODE_TWO_PLAYER, &game));
+  TEST_ASSERT_EQUAL(0, replay.count);
+
+  life_journal_flush();
+  reboot();
+  TEST_ASSERT_FALSE(restore(PLAYER_MODE_TWO_PLAYER, &game));
+  TEST_ASSERT_EQUAL(0, replay.count);
+  TEST_ASSERT_TRUE(restore(PLAYER_MODE_ONE_PLAYER, &game));
+}
+
+static void test_corrupt_record_is_skipped(void)
+{
+  life_journal_start_game(PLAYER_MODE_ONE_PLAYER, 20);  // slot 0
+  append(0, -1, 19, 1);                                 // slot 1
+  append(0, -1, 18, 2);                                 // slot 2
+  append(0, -1, 17, 3);                                 // slot 3
+  life_journal_flush();
+  life_journal_deinit();
+
+  uint8_t flipped = 0x00;
+  poke(2 * sizeof(life_journal_record_t) + 6, &flipped, 1);  // life_total of slot 2
+  TEST_ASSERT_TRUE(life_journal_init());
+
+  life_journal_game_t game;
+  TEST_ASSERT_TRUE(restore(PLAYER_MODE_ONE_PLAYER, &game));
+  TEST_ASSERT_EQUAL(2, replay.count);
+  TEST_ASSERT_EQUAL(17, replay.last_total[0]);
+}
+
+static void test_torn_write_continues_in_next_sector(void)
+{
+  life_journal_start_game(PLAYER_MODE_ONE_PLAYER, 20);
+  append(0, -1, 19, 1);
+  life_journal_flush();
+  life_journal_deinit();
+
+  // Power lost while programming slot 2: seq written, CRC not
+  uint32_t seq = 3;
+  poke(2 * sizeof(life_journal_record_t), &seq, sizeof(seq));
+  TEST_ASSERT_TRUE(life_journal_init());
+
+  append(0, -4, 15, 2);
+  life_journal_flush();
+  reboot();
+
+  life_journal_game_t game;
+  TEST_ASSERT_TRUE(restore(PLAYER_MODE_ONE_PLAYER, &game));
+  TEST_ASSERT_EQUAL(2, replay.count);
+  TEST_ASSERT_EQUAL(15, replay.last_total[0]);
+}
+
+// Two players taking turns for more records than the ring holds
+static void play_past_wrap(int *total_p1, int *total_p2)
+{
+  life_journal_start_game(PLAYER_MODE_TWO_PLAYER, 40);
+  *total_p1 = *total_p2 = 40;
+  for (uint32_t i = 0; i < SLOTS + SLOTS / 3; i++)
+  {
+    int player = 1 + (i & 1);
+    int net = (i % 7) - 3;
+    int *total = player == 1 ? total_p1 : total_p2;
+    *total += net;
+    append(player, net, *total, (int)(i / 4));
+    if (i % 16 == 15)
+      life_journal_flush();
+  }
+  life_journal_flush();
+}
+
+static void check_wrapped_restore(int total_p1, int total_p2)
+{
+  life_journal_game_t game;
+  TEST_ASSERT_TRUE(restore(PLAYER_MODE_TWO_PLAYER, &game));
+  TEST_ASSERT_TRUE(game.from_checkpoint);
+  TEST_ASSERT_TRUE(game.events < SLOTS);
+  TEST_ASSERT_TRUE(game.events > SLOTS / 3);
+  TEST_ASSERT_EQUAL(total_p1, replay.last_total[0]);
+  TEST_ASSERT_EQUAL(total_p2, replay.last_total[1]);
+  // The checkpoint carries the totals the replayed changes start from
+  TEST_ASSERT_EQUAL(total_p1, game.start_life + replay.net[0]);
+  TEST_ASSERT_EQUAL(total_p2, game.start_life_p2 + replay.net[1]);
+}
+
+static void test_wrap_past_game_start_writes_checkpoint(void)
+{
+  int total_p1, total_p2;
+  play_past_wrap(&total_p1, &total_p2);
+
+  life_journal_stats_t stats;
+  life_journal_get_stats(&stats);
+  TEST_ASSERT_TRUE(stats.checkpoints >= 1);
+  TEST_ASSERT_TRUE(stats.sectors_erased >= LIFE_JOURNAL_HOST_SIZE / LIFE_JOURNAL_SECTOR_SIZE / 3);
+  TEST_ASSERT_EQUAL(0, stats.dropped);
+  check_wrapped_restore(total_p1, total_p2);
+
+  // The totals for the next checkpoint are rebuilt from flash at boot
+  reboot();
+  check_wrapped_restore(total_p1, total_p2);
+  for (uint32_t i = 0; i < SLOTS; i++)
+  {
+    int player = 1 + (i & 1);
+    int *total = player == 1 ? &total_p1 : &total_p2;
+    *total -= 1;
+    append(player, -1, *total, 0);
+    if (i % 16 == 15)
+      life_journal_flush();
+  }
+  life_journal_flush();
+  reboot();
+  check_wrapped_restore(total_p1, total_p2);
+}
+
+static void test_benchmark_full_journal(void)
+{
+  int total_p1, total_p2;
+  play_past_wrap(&total_p1, &total_p2);
+  life_journal_deinit();
+
+  auto start = std::chrono::steady_clock::now();
+  TEST_ASSERT_TRUE(life_journal_init());
+  auto scanned = std::chrono::steady_clock::now();
+  life_journal_game_t game;
+  TEST_ASSERT_TRUE(restore(PLAYER_MODE_TWO_PLAYER, &game));
+  auto restored = std::chrono::steady_clock::now();
+
+  life_journal_stats_t stats;
+  life_journal_get_stats(&stats);
+  printf("[life_journal] %u slots, %lu valid records, %lu events restored\n",
+         (unsigned)SLOTS, (unsigned long)stats.records, (unsigned long)game.events);
+  printf("[life_journal] boot scan %8.1f us, restore %8.1f us\n",
+         std::chrono::duration<double, std::micro>(scanned - start).count(),
+         std::chrono::duration<double, std::micro>(restored - scanned).count());
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_restore_after_reboot);
+  RUN_TEST(test_restore_includes_queued_records);
+  RUN_TEST(test_restore_refuses_other_mode);
+  RUN_TEST(test_corrupt_record_is_skipped);
+  RUN_TEST(test_torn_write_continues_in_next_sector);
+  RUN_TEST(test_wrap_past_game_start_writes_checkpoint);
+  RUN_TEST(test_benchmark_full_journal);
+  return UNITY_END();
+}
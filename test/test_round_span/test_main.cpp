@@ -0,0 +1,205 @@
+// Span table and band split of the round panel mask, plus a benchmark of the
+// bytes a flush sends against the full rectangle.
+//
+//   pio test -e native -f test_round_span -v
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <board_config.h>
+#include "hardware/display/round_span.h"
+
+#define MARGIN        1
+#define CHUNK_LINES   80   // partial render mode, LVGL_BUF_LEN / LCD_WIDTH
+
+static int16_t x_min[LCD_HEIGHT];
+static int16_t x_max[LCD_HEIGHT];
+
+void setUp(void)
+{
+  RoundSpan_Build(LCD_WIDTH, LCD_HEIGHT, MARGIN, x_min, x_max);
+}
+
+void tearDown(void) {}
+
+// Reference in doubles: is the center of pixel (x, y) inside the grown circle
+static bool visible_ref(int32_t x, int32_t y, int32_t margin)
+{
+  double r = LCD_WIDTH / 2.0 + margin;
+  double dx = x + 0.5 - LCD_WIDTH / 2.0;
+  double dy = y + 0.5 - LCD_HEIGHT / 2.0;
+  return dx * dx + dy * dy <= r * r;
+}
+
+static void test_isqrt(void)
+{
+  for (uint32_t v = 0; v < 200000; v++) {
+    uint32_t r = RoundSpan_Isqrt(v);
+    TEST_ASSERT_TRUE(r * r <= v && (r + 1) * (r + 1) > v);
+  }
+  TEST_ASSERT_EQUAL_UINT32(65535, RoundSpan_Isqrt(0xFFFFFFFFu));
+  TEST_ASSERT_EQUAL_UINT32(724, RoundSpan_Isqrt(724 * 724));
+}
+
+static void test_span_table_is_symmetric(void)
+{
+  for (int32_t y = 0; y < LCD_HEIGHT; y++) {
+    // Left/right around the vertical axis, top/bottom around the horizontal one
+    TEST_ASSERT_EQUAL_INT(LCD_WIDTH - 1, x_min[y] + x_max[y]);
+    TEST_ASSERT_EQUAL_INT(x_min[y], x_min[LCD_HEIGHT - 1 - y]);
+    TEST_ASSERT_EQUAL_INT(x_max[y], x_max[LCD_HEIGHT - 1 - y]);
+  }
+  // Spans only grow towards the center row
+  for (int32_t y = 1; y < LCD_HEIGHT / 2; y++)
+    TEST_ASSERT_LESS_OR_EQUAL(x_min[y - 1], x_min[y]);
+}
+
+static void test_span_table_matches_circle_with_margin(void)
+{
+  for (int32_t y = 0; y < LCD_HEIGHT; y++) {
+    for (int32_t x = 0; x < LCD_WIDTH; x++) {
+      bool in_table = x >= x_min[y] && x <= x_max[y];
+      TEST_ASSERT_EQUAL_INT(visible_ref(x, y, MARGIN), in_table);
+    }
+  }
+
+  // The margin only ever adds pixels to the exact circle
+  int16_t exact_min[LCD_HEIGHT], exact_max[LCD_HEIGHT];
+  RoundSpan_Build(LCD_WIDTH, LCD_HEIGHT, 0, exact_min, exact_max);
+  for (int32_t y = 0; y < LCD_HEIGHT; y++) {
+    TEST_ASSERT_LESS_OR_EQUAL(exact_min[y], x_min[y]);
+    TEST_ASSERT_GREATER_OR_EQUAL(exact_max[y], x_max[y]);
+  }
+  TEST_ASSERT_TRUE(exact_max[0] - exact_min[0] < x_max[0] - x_min[0]);
+}
+
+static void test_span_table_edge_rows(void)
+{
+  // Rows 0 and 359 keep a short run around the center column, never empty
+  TEST_ASSERT_TRUE(x_min[0] <= x_max[0]);
+  TEST_ASSERT_TRUE(x_min[0] > 140 && x_max[0] < 220);
+  TEST_ASSERT_EQUAL_INT(x_min[0], x_min[LCD_HEIGHT - 1]);
+  TEST_ASSERT_EQUAL_INT(x_max[0], x_max[LCD_HEIGHT - 1]);
+
+  // The center rows reach both panel edges and are clamped to it
+  TEST_ASSERT_EQUAL_INT(0, x_min[LCD_HEIGHT / 2]);
+  TEST_ASSERT_EQUAL_INT(LCD_WIDTH - 1, x_max[LCD_HEIGHT / 2]);
+
+  uint32_t visible = 0;
+  for (int32_t y = 0; y < LCD_HEIGHT; y++)
+    visible += x_max[y] - x_min[y] + 1;
+  TEST_ASSERT_UINT32_WITHIN(LCD_WIDTH * LCD_HEIGHT / 100, LCD_WIDTH * LCD_HEIGHT * 0.7854, visible);
+}
+
+static void check_bands_cover(const round_band_t *area, const round_band_t *bands, int count, int max_bands)
+{
+  TEST_ASSERT_LESS_OR_EQUAL(max_bands, count);
+  int32_t prev_y2 = area->y1 - 1;
+  for (int i = 0; i < count; i++) {
+    TEST_ASSERT_TRUE(bands[i].y1 > prev_y2);
+    TEST_ASSERT_TRUE(bands[i].x1 >= area->x1 && bands[i].x2 <= area->x2);
+    TEST_ASSERT_TRUE(bands[i].y1 <= bands[i].y2 && bands[i].y2 <= area->y2);
+    prev_y2 = bands[i].y2;
+  }
+  // Every visible pixel of the area is in exactly the band of its row
+  for (int32_t y = area->y1; y <= area->y2; y++) {
+    int32_t a = x_min[y] > area->x1 ? x_min[y] : area->x1;
+    int32_t b = x_max[y] < area->x2 ? x_max[y] : area->x2;
+    const round_band_t *band = nullptr;
+    for (int i = 0; i < count; i++)
+      if (y >= bands[i].y1 && y <= bands[i].y2) band = &bands[i];
+    if (a > b)
+      continue;
+    TEST_ASSERT_NOT_NULL(band);
+    TEST_ASSERT_TRUE(band->x1 <= a && band->x2 >= b);
+  }
+}
+
+static void test_split_covers_visible_pixels(void)
+{
+  for (int32_t y = 0; y < LCD_HEIGHT; y += CHUNK_LINES) {
+    round_band_t area = { 0, y, LCD_WIDTH - 1, y + CHUNK_LINES - 1 };
+    if (area.y2 >= LCD_HEIGHT) area.y2 = LCD_HEIGHT - 1;
+    round_band_t bands[ROUND_MASK_MAX_BANDS];
+    int count = RoundSpan_Split(x_min, x_max, LCD_HEIGHT, &area, ROUND_MASK_BAND_SLACK, bands, ROUND_MASK_MAX_BANDS);
+    TEST_ASSERT_GREATER_THAN(0, count);
+    check_bands_cover(&area, bands, count, ROUND_MASK_MAX_BANDS);
+  }
+
+  // Off-center area and a single band limit
+  round_band_t corner = { 250, 10, 359, 120 };
+  round_band_t bands[ROUND_MASK_MAX_BANDS];
+  int count = RoundSpan_Split(x_min, x_max, LCD_HEIGHT, &corner, 4, bands, ROUND_MASK_MAX_BANDS);
+  check_bands_cover(&corner, bands, count, ROUND_MASK_MAX_BANDS);
+  count = RoundSpan_Split(x_min, x_max, LCD_HEIGHT, &corner, 4, bands, 1);
+  TEST_ASSERT_EQUAL_INT(1, count);
+  check_bands_cover(&corner, bands, count, 1);
+}
+
+static void test_split_invisible_area(void)
+{
+  round_band_t corner = { 0, 0, 20, 20 };
+  round_band_t bands[ROUND_MASK_MAX_BANDS];
+  TEST_ASSERT_EQUAL_INT(0, RoundSpan_Split(x_min, x_max, LCD_HEIGHT, &corner, ROUND_MASK_BAND_SLACK,
+                                           bands, ROUND_MASK_MAX_BANDS));
+}
+
+// Bytes one redraw of `area` sends in `lines`-line flushes, split into at most
+// `max_bands` windows each (1 = the bounding box of the chunk)
+static uint32_t bytes_sent(const round_band_t *area, int32_t lines, int max_bands, uint32_t *windows)
+{
+  uint32_t bytes = 0;
+  for (int32_t y = area->y1; y <= area->y2; y += lines) {
+    round_band_t chunk = { area->x1, y, area->x2, y + lines - 1 };
+    if (chunk.y2 > area->y2) chunk.y2 = area->y2;
+    round_band_t bands[ROUND_MASK_MAX_BANDS];
+    int count = RoundSpan_Split(x_min, x_max, LCD_HEIGHT, &chunk, ROUND_MASK_BAND_SLACK, bands, max_bands);
+    for (int i = 0; i < count; i++)
+      bytes += (bands[i].x2 - bands[i].x1 + 1) * (bands[i].y2 - bands[i].y1 + 1) * sizeof(uint16_t);
+    *windows += count;
+  }
+  return bytes;
+}
+
+static void test_benchmark_bytes_per_screen(void)
+{
+  struct Scene {
+    const char *name;
+    round_band_t area;
+    int32_t lines;
+  };
+  static const Scene scenes[] = {
+    { "full redraw (partial mode)", { 0, 0, 359, 359 }, CHUNK_LINES },
+    { "full redraw (bounce, 40)",   { 0, 0, 359, 359 }, 40 },
+    { "life arc, top half",         { 0, 0, 359, 179 }, CHUNK_LINES },
+    { "life total label",           { 80, 120, 279, 239 }, CHUNK_LINES },
+    { "2P left player",             { 0, 0, 179, 359 }, CHUNK_LINES },
+    { "menu page dots, bottom",     { 100, 300, 259, 359 }, CHUNK_LINES },
+  };
+
+  printf("\n%-28s %9s %9s %9s %9s %7s\n", "scene", "rect", "bbox", "bands", "saved", "windows");
+  for (const Scene &s : scenes) {
+    uint32_t rect = (s.area.x2 - s.area.x1 + 1) * (s.area.y2 - s.area.y1 + 1) * sizeof(uint16_t);
+    uint32_t bbox_windows = 0, band_windows = 0;
+    uint32_t bbox = bytes_sent(&s.area, s.lines, 1, &bbox_windows);
+    uint32_t bands = bytes_sent(&s.area, s.lines, ROUND_MASK_MAX_BANDS, &band_windows);
+    printf("%-28s %9u %9u %9u %8u%% %3u/%-3u\n", s.name, (unsigned)rect, (unsigned)bbox, (unsigned)bands,
+           (unsigned)((rect - bands) * 100 / rect), (unsigned)bbox_windows, (unsigned)band_windows);
+    TEST_ASSERT_LESS_OR_EQUAL(bbox, bands);
+    TEST_ASSERT_LESS_OR_EQUAL(rect, bbox);
+  }
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_isqrt);
+  RUN_TEST(test_span_table_is_symmetric);
+  RUN_TEST(test_span_table_matches_circle_with_margin);
+  RUN_TEST(test_span_table_edge_rows);
+  RUN_TEST(test_split_covers_visible_pixels);
+  RUN_TEST(test_split_invisible_area);
+  RUN_TEST(test_benchmark_bytes_per_screen);
+  return UNITY_END();
+}
@@ -0,0 +1,151 @@
+// Host tests of the TCA9554 driver's I2C traffic, on the mock bus backend.
+//
+// The shadow registers and the INT-gated input cache exist to save bus
+// transactions; these tests count them per driver call: init loads three
+// registers and writes the mode, a pin change is one write, an unchanged
+// pin none, and input reads only go out after INT fired.
+//
+//   pio test -e native -f test_tca9554 -v
+
+#include <unity.h>
+#include <stdint.h>
+
+#include "hardware/peripherals/i2c_bus.h"
+#include "hardware/peripherals/i2c_bus_mock.h"
+#include "hardware/peripherals/tca9554_power.h"
+
+static I2cMockDevice *expander;
+
+struct Traffic
+{
+  uint32_t transactions;
+  uint32_t reads;    // transactions that read registers
+};
+
+static Traffic traffic(void)
+{
+  I2cDeviceStats stats = {};
+  i2c_bus_get_stats(TCA9554_ADDRESS, &stats);
+  return {stats.transactions, expander->reads};
+}
+
+static void reset_traffic(void)
+{
+  i2c_bus_reset_stats();
+  i2c_mock_reset_counters();
+  TCA9554_ResetStats();
+}
+
+#define ASSERT_TRAFFIC(transactions_, reads_) do { \
+    Traffic t = traffic(); \
+    TEST_ASSERT_EQUAL_MESSAGE(transactions_, t.transactions, "transactions"); \
+    TEST_ASSERT_EQUAL_MESSAGE(reads_, t.reads, "reads"); \
+  } while (0)
+
+void setUp(void)
+{
+  TEST_ASSERT_TRUE(i2c_bus_init(I2C_BUS_CLOCK_HZ, i2c_mock_backend()));
+  expander = i2c_mock_add_device(TCA9554_ADDRESS);
+  // Power-on defaults: all pins inputs, outputs latched high
+  expander->regs[TCA9554_INPUT_REG] = 0x80;
+  expander->regs[TCA9554_OUTPUT_REG] = 0xFF;
+  expander->regs[TCA9554_Polarity_REG] = 0x00;
+  expander->regs[TCA9554_CONFIG_REG] = 0xFF;
+  expander->nack = false;
+  reset_traffic();
+}
+
+void tearDown(void) {}
+
+// Runs first: the driver's shadows start out invalid
+static void test_failed_init_keeps_reading_registers(void)
+{
+  expander->nack = true;
+  TCA9554PWR_Init(0x00);
+  expander->nack = false;
+  reset_traffic();
+
+  // Shadows not trusted: the current output level is read before the write
+  Set_EXIO(EXIO_PIN2, Low);
+  ASSERT_TRAFFIC(2, 1);
+  TEST_ASSERT_EQUAL_HEX8(0xFD, expander->regs[TCA9554_OUTPUT_REG]);
+
+  reset_traffic();
+  TEST_ASSERT_EQUAL_HEX8(0xFD, Read_EXIOS(TCA9554_OUTPUT_REG));
+  ASSERT_TRAFFIC(1, 1);
+}
+
+static void test_init_loads_shadows_and_writes_mode(void)
+{
+  TCA9554PWR_Init(0x00);
+  ASSERT_TRAFFIC(4, 3);
+  TEST_ASSERT_EQUAL_HEX8(0x00, expander->regs[TCA9554_CONFIG_REG]);
+
+  TCA9554Stats stats;
+  TCA9554_GetStats(&stats);
+  TEST_ASSERT_EQUAL(3, stats.reads);
+  TEST_ASSERT_EQUAL(1, stats.writes);
+}
+
+static void test_pin_writes_go_out_once(void)
+{
+  TCA9554PWR_Init(0x00);
+  reset_traffic();
+
+  Set_EXIO(EXIO_PIN1, Low);
+  ASSERT_TRAFFIC(1, 0);
+  TEST_ASSERT_EQUAL_HEX8(0xFE, expander->regs[TCA9554_OUTPUT_REG]);
+
+  Set_EXIO(EXIO_PIN1, Low);
+  Set_EXIO(EXIO_PIN1, Low);
+  ASSERT_TRAFFIC(1, 0);
+
+  Set_EXIO_Mask(0x06, 0x00);  // two pins, one write
+  ASSERT_TRAFFIC(2, 0);
+  TEST_ASSERT_EQUAL_HEX8(0xF8, expander->regs[TCA9554_OUTPUT_REG]);
+
+  // Output and mode come from the shadows
+  TEST_ASSERT_EQUAL_HEX8(0xF8, Read_EXIOS(TCA9554_OUTPUT_REG));
+  TEST_ASSERT_EQUAL_HEX8(0x00, Read_EXIOS(TCA9554_CONFIG_REG));
+  ASSERT_TRAFFIC(2, 0);
+
+  TCA9554Stats stats;
+  TCA9554_GetStats(&stats);
+  TEST_ASSERT_EQUAL(2, stats.writes);
+  TEST_ASSERT_EQUAL(2, stats.writes_skipped);
+  TEST_ASSERT_EQUAL(2, stats.reads_cached);
+}
+
+static void test_input_reads_wait_for_int(void)
+{
+  TCA9554PWR_Init(0x00);
+  Read_EXIOS(TCA9554_INPUT_REG);  // clears the dirty flag the mode write left
+  reset_traffic();
+
+  for (int i = 0; i < 5; i++)
+    TEST_ASSERT_EQUAL_HEX8(0x80, Read_EXIOS(TCA9554_INPUT_REG));
+  TEST_ASSERT_FALSE(TCA9554_InputChanged());
+  ASSERT_TRAFFIC(0, 0);
+
+  expander->regs[TCA9554_INPUT_REG] = 0x81;
+  TCA9554_SimulateInt();
+  TEST_ASSERT_TRUE(TCA9554_InputChanged());
+  TEST_ASSERT_EQUAL(1, Read_EXIO(EXIO_PIN1));
+  TEST_ASSERT_EQUAL(1, Read_EXIO(EXIO_PIN8));
+  ASSERT_TRAFFIC(1, 1);
+
+  // An output write changes what the input register reads back
+  Set_EXIO(EXIO_PIN3, Low);
+  Read_EXIOS(TCA9554_INPUT_REG);
+  ASSERT_TRAFFIC(3, 2);
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_failed_init_keeps_reading_registers);
+  RUN_TEST(test_init_loads_shadows_and_writes_mode);
+  RUN_TEST(test_pin_writes_go_out_once);
+  RUN_TEST(test_input_reads_wait_for_int);
+  return UNITY_END();
+}
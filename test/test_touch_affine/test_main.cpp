@@ -0,0 +1,228 @@
+// Host tests of the touch calibration transform.
+//
+// The solver is fed points produced by known transforms (identity, scale,
+// rotation, shear, offset and a mix) and has to recover the Q16 coefficients
+// with the expected residual; collinear and too few points are rejected.
+// touch_affine_apply is checked for round-half-up on both signs.
+//
+//   pio test -e native -f test_touch_affine -v
+
+#include <unity.h>
+#include <math.h>
+#include <stdint.h>
+
+#include "hardware/touch/touch_affine.h"
+
+#define Q16(v)  ((int32_t)lround((v) * TOUCH_AFFINE_ONE))
+
+// Nine points spread over a 360 px panel, like the calibration screen
+static const TouchCalPoint grid[] = {
+  {40, 40}, {180, 40}, {320, 40},
+  {40, 180}, {180, 180}, {320, 180},
+  {40, 320}, {180, 320}, {320, 320},
+};
+#define GRID_POINTS (sizeof(grid) / sizeof(grid[0]))
+
+struct Affine {
+  double a, b, c, d, e, f;
+};
+
+// Screen points for raw = grid, rounded to pixels like real targets
+static void map_grid(const Affine &t, TouchCalPoint *screen)
+{
+  for (size_t i = 0; i < GRID_POINTS; i++) {
+    screen[i].x = (int32_t)lround(t.a * grid[i].x + t.b * grid[i].y + t.c);
+    screen[i].y = (int32_t)lround(t.d * grid[i].x + t.e * grid[i].y + t.f);
+  }
+}
+
+// Linear terms within a few Q16 LSB, offsets within 1/1000 px
+static void assert_fit(const Affine &t, const TouchAffine &m, int32_t linear_tol, int32_t offset_tol)
+{
+  TEST_ASSERT_INT_WITHIN(linear_tol, Q16(t.a), m.a);
+  TEST_ASSERT_INT_WITHIN(linear_tol, Q16(t.b), m.b);
+  TEST_ASSERT_INT_WITHIN(offset_tol, Q16(t.c), m.c);
+  TEST_ASSERT_INT_WITHIN(linear_tol, Q16(t.d), m.d);
+  TEST_ASSERT_INT_WITHIN(linear_tol, Q16(t.e), m.e);
+  TEST_ASSERT_INT_WITHIN(offset_tol, Q16(t.f), m.f);
+}
+
+static void solve_exact(const Affine &t)
+{
+  TouchCalPoint screen[GRID_POINTS];
+  map_grid(t, screen);
+  TouchAffine m;
+  float rms = -1;
+  TEST_ASSERT_TRUE(touch_affine_solve(grid, screen, GRID_POINTS, &m, &rms));
+  assert_fit(t, m, 2, TOUCH_AFFINE_ONE / 1000);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, rms);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void test_identity(void)
+{
+  solve_exact({1, 0, 0, 0, 1, 0});
+
+  TouchAffine m;
+  touch_affine_identity(&m);
+  int32_t x, y;
+  touch_affine_apply(&m, 123, -45, &x, &y);
+  TEST_ASSERT_EQUAL(123, x);
+  TEST_ASSERT_EQUAL(-45, y);
+}
+
+static void test_scale(void)
+{
+  // Grid coordinates are multiples of 20, so these land on whole pixels
+  solve_exact({1.5, 0, 0, 0, 0.75, 0});
+  solve_exact({-1, 0, 360, 0, 1, 0});  // mirrored x axis
+}
+
+static void test_rotation(void)
+{
+  solve_exact({0, -1, 360, 1, 0, 0});  // 90 degrees about the panel center
+
+  // 10 degrees: targets round to whole pixels, so the fit is close, not exact
+  const double angle = 10 * M_PI / 180;
+  const double cs = cos(angle), sn = sin(angle);
+  Affine t = {cs, -sn, 180 - 180 * cs + 180 * sn, sn, cs, 180 - 180 * sn - 180 * cs};
+  TouchCalPoint screen[GRID_POINTS];
+  map_grid(t, screen);
+  TouchAffine m;
+  float rms;
+  TEST_ASSERT_TRUE(touch_affine_solve(grid, screen, GRID_POINTS, &m, &rms));
+  assert_fit(t, m, Q16(0.005), Q16(1.0));
+  TEST_ASSERT_TRUE(rms < 0.75f);
+}
+
+static void test_shear(void)
+{
+  solve_exact({1, 0.25, 0, 0, 1, 0});
+  solve_exact({1, 0, 0, -0.5, 1, 0});
+}
+
+static void test_offset(void)
+{
+  solve_exact({1, 0, 12, 0, 1, -7});
+  solve_exact({1.25, 0.05, -20, -0.1, 0.9, 33});  // all at once
+}
+
+static void test_residual_of_an_outlier(void)
+{
+  TouchCalPoint screen[GRID_POINTS];
+  map_grid({1, 0, 0, 0, 1, 0}, screen);
+  screen[4].x += 9;  // center point off by 9 px
+
+  TouchAffine m;
+  float rms;
+  TEST_ASSERT_TRUE(touch_affine_solve(grid, screen, GRID_POINTS, &m, &rms));
+  // The centroid absorbs 1 px of the error: the center is 8 px off, the other
+  // eight points 1 px, rms = sqrt((64 + 8) / 9)
+  TEST_ASSERT_INT_WITHIN(2, Q16(1.0), m.a);
+  TEST_ASSERT_INT_WITHIN(2, Q16(1.0), m.c);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, (float)sqrt(72.0 / 9), rms);
+}
+
+static void test_degenerate_points_are_rejected(void)
+{
+  TouchAffine m;
+  touch_affine_identity(&m);
+  const TouchAffine before = m;
+  float rms;
+
+  TEST_ASSERT_FALSE(touch_affine_solve(grid, grid, 2, &m, &rms));
+  TEST_ASSERT_FALSE(touch_affine_solve(nullptr, grid, GRID_POINTS, &m, &rms));
+  TEST_ASSERT_FALSE(touch_affine_solve(grid, nullptr, GRID_POINTS, &m, &rms));
+
+  const TouchCalPoint diagonal[] = {{40, 40}, {180, 180}, {320, 320}, {100, 100}};
+  TEST_ASSERT_FALSE(touch_affine_solve(diagonal, diagonal, 4, &m, &rms));
+
+  const TouchCalPoint row[] = {{40, 200}, {120, 200}, {260, 200}, {320, 200}};
+  TEST_ASSERT_FALSE(touch_affine_solve(row, row, 4, &m, &rms));
+
+  const TouchCalPoint same[] = {{180, 180}, {180, 180}, {180, 180}};
+  TEST_ASSERT_FALSE(touch_affine_solve(same, same, 3, &m, &rms));
+
+  // One pixel off a 280 px line is still a line
+  const TouchCalPoint nearly[] = {{40, 40}, {180, 181}, {320, 320}};
+  TEST_ASSERT_FALSE(touch_affine_solve(nearly, nearly, 3, &m, &rms));
+
+  TEST_ASSERT_EQUAL_MEMORY(&before, &m, sizeof(m));
+
+  // Three points that span the panel are enough
+  const TouchCalPoint corner[] = {{40, 40}, {320, 40}, {40, 320}};
+  TEST_ASSERT_TRUE(touch_affine_solve(corner, corner, 3, &m, &rms));
+
+  // The five targets of the calibration screen
+  const TouchCalPoint targets[] = {{60, 60}, {280, 60}, {160, 180}, {55, 240}, {280, 240}};
+  TEST_ASSERT_TRUE(touch_affine_solve(targets, targets, 5, &m, &rms));
+}
+
+static void test_apply_rounds_half_up(void)
+{
+  TouchAffine m;
+  touch_affine_identity(&m);
+  const int32_t half = TOUCH_AFFINE_ONE / 2;
+  int32_t x, y;
+
+  m.c = half;          // 10.5 -> 11
+  m.f = half - 1;      // just under 10.5 -> 10
+  touch_affine_apply(&m, 10, 10, &x, &y);
+  TEST_ASSERT_EQUAL(11, x);
+  TEST_ASSERT_EQUAL(10, y);
+
+  m.c = -half;         // 9.5 -> 10
+  m.f = -half - 1;     // just under 9.5 -> 9
+  touch_affine_apply(&m, 10, 10, &x, &y);
+  TEST_ASSERT_EQUAL(10, x);
+  TEST_ASSERT_EQUAL(9, y);
+
+  // Negative results round towards +infinity at .5 as well
+  m.c = half;          // -2.5 -> -2
+  m.f = 0;
+  touch_affine_apply(&m, -3, -3, &x, &y);
+  TEST_ASSERT_EQUAL(-2, x);
+  TEST_ASSERT_EQUAL(-3, y);
+
+  // Scale 1.5: 4.5 -> 5 and -4.5 -> -4
+  touch_affine_identity(&m);
+  m.a = m.e = Q16(1.5);
+  touch_affine_apply(&m, 3, -3, &x, &y);
+  TEST_ASSERT_EQUAL(5, x);
+  TEST_ASSERT_EQUAL(-4, y);
+
+  // Raw values far outside the panel do not overflow the 64-bit products
+  touch_affine_apply(&m, 100000, -100000, &x, &y);
+  TEST_ASSERT_EQUAL(150000, x);
+  TEST_ASSERT_EQUAL(-150000, y);
+}
+
+static void test_from_scale_offset(void)
+{
+  TouchAffine m;
+  touch_affine_from_scale_offset(2.0f, 0.5f, 3.0f, -4.0f, 180, 180, &m);
+  int32_t x, y;
+  touch_affine_apply(&m, 180, 180, &x, &y);  // center only moves by the offset
+  TEST_ASSERT_EQUAL(183, x);
+  TEST_ASSERT_EQUAL(176, y);
+  touch_affine_apply(&m, 190, 200, &x, &y);
+  TEST_ASSERT_EQUAL(203, x);
+  TEST_ASSERT_EQUAL(186, y);
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_identity);
+  RUN_TEST(test_scale);
+  RUN_TEST(test_rotation);
+  RUN_TEST(test_shear);
+  RUN_TEST(test_offset);
+  RUN_TEST(test_residual_of_an_outlier);
+  RUN_TEST(test_degenerate_points_are_rejected);
+  RUN_TEST(test_apply_rounds_half_up);
+  RUN_TEST(test_from_scale_offset);
+  return UNITY_END();
+}
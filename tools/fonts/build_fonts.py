@@ -0,0 +1,208 @@
+#!/usr/bin/env python3
+"""
+Build the font subsets listed in fonts.json and report what they cost.
+
+The large sizes are only ever used for numbers (life totals, pending change,
+amp counter), so instead of LVGL's full-ASCII built-in Montserrat they get
+digit-only fonts generated with lv_font_conv. bpp and compression are chosen
+per size in fonts.json.
+
+    python tools/fonts/build_fonts.py             # generate everything, then report
+    python tools/fonts/build_fonts.py --only lv_font_numeric_48
+    python tools/fonts/build_fonts.py --report    # only report on the files in the tree
+
+Needs lv_font_conv (npm, override the command with $LV_FONT_CONV) and the
+TTF/WOFF files named in fonts.json in tools/fonts/ttf/ (Montserrat from Google
+Fonts, the FontAwesome file from lvgl/scripts/built_in_font).
+
+The report compares every subset with the built-in font it replaces, found in
+the LVGL checkout of the PlatformIO build (.pio/libdeps/<env>/lvgl). Glyph
+render time can only be measured on the device: run 'fontbench' on the serial
+console after flashing.
+
+Also writes font_subsets.h, which tells lv_conf.h and the UI which subsets
+exist; a subset that was not generated falls back to the built-in size.
+"""
+
+import argparse
+import glob
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+TOOLS = os.path.dirname(os.path.abspath(__file__))
+
+
+def load_manifest():
+    with open(os.path.join(TOOLS, "fonts.json")) as f:
+        return json.load(f)
+
+
+def font_path(manifest, font):
+    return os.path.join(ROOT, manifest["output_dir"], font["name"] + ".c")
+
+
+def generate(manifest, font):
+    ttf_dir = os.path.join(TOOLS, "ttf")
+    cmd = shlex.split(os.environ.get("LV_FONT_CONV", "npx lv_font_conv"))
+    cmd += ["--bpp", str(font["bpp"]), "--size", str(font["size"])]
+    if not font.get("compress"):
+        cmd.append("--no-compress")
+    cmd += shlex.split(font.get("extra", ""))
+    cmd += ["--font", os.path.join(ttf_dir, font["ttf"]), "--symbols", font["symbols"]]
+    if font.get("symbol_font"):
+        cmd += ["--font", os.path.join(ttf_dir, font["symbol_font"]), "-r", font["symbol_ranges"]]
+    cmd += ["--format", "lvgl", "--lv-include", "lvgl.h", "-o", font_path(manifest, font)]
+    print("[fonts] " + " ".join(shlex.quote(c) for c in cmd))
+    subprocess.run(cmd, check=True)
+
+
+def measure(path):
+    """Bytes of glyph bitmaps and descriptors in a generated (or built-in) font."""
+    with open(path) as f:
+        src = f.read()
+    bitmap = re.search(r"glyph_bitmap\[\]\s*=\s*\{(.*?)\};", src, re.S)
+    bitmap_bytes = len(re.findall(r"0x[0-9a-fA-F]+", bitmap.group(1))) if bitmap else 0
+    dsc = re.search(r"glyph_dsc\[\]\s*=\s*\{(.*?)\};", src, re.S)
+    glyphs = len(re.findall(r"\.bitmap_index", dsc.group(1))) if dsc else 0
+    # lv_font_fmt_txt_glyph_dsc_t is 8 bytes, kerning and cmaps are small
+    return {"bitmap": bitmap_bytes, "glyphs": glyphs, "total": bitmap_bytes + 8 * glyphs}
+
+
+def missing_symbols(path, font):
+    """Manifest symbols the font file was not generated with, from its Opts line."""
+    with open(path) as f:
+        opts = re.search(r"Opts:(.*)", f.read())
+    if not opts:
+        return ""
+    args = shlex.split(opts.group(1))
+    have = set()
+    for i, arg in enumerate(args[:-1]):
+        if arg == "--symbols":
+            have |= set(args[i + 1])
+    return "".join(c for c in font["symbols"] if c not in have)
+
+
+def find_builtin(lvgl_dir, size):
+    pattern = "lv_font_montserrat_%d.c" % size
+    if lvgl_dir:
+        candidates = [os.path.join(lvgl_dir, "src", "font", pattern)]
+    else:
+        candidates = glob.glob(os.path.join(ROOT, ".pio", "libdeps", "*", "lvgl", "src", "font", pattern))
+    for c in candidates:
+        if os.path.exists(c):
+            return c
+    return None
+
+
+def report(manifest, lvgl_dir):
+    print("\n%-24s %5s %4s %5s %7s %9s %9s %9s" %
+          ("font", "size", "bpp", "comp", "glyphs", "bytes", "built-in", "saved"))
+    saved_total = 0
+    stale = []
+    for font in manifest["fonts"]:
+        path = font_path(manifest, font)
+        if not os.path.exists(path):
+            print("%-24s %5d  not generated, built-in %s used" %
+                  (font["name"], font["size"], font.get("replaces", "-")))
+            continue
+        m = measure(path)
+        builtin = "-"
+        saved = "-"
+        if font.get("replaces"):
+            ref = find_builtin(lvgl_dir, font["replaces"])
+            if ref:
+                b = measure(ref)
+                builtin = str(b["total"])
+                saved = str(b["total"] - m["total"])
+                saved_total += b["total"] - m["total"]
+            else:
+                builtin = "?"
+        print("%-24s %5d %4d %5s %7d %9d %9s %9s" %
+              (font["name"], font["size"], font["bpp"], "yes" if font.get("compress") else "no",
+               m["glyphs"], m["total"], builtin, saved))
+        missing = missing_symbols(path, font)
+        if missing:
+            stale.append("%s lacks %r, regenerate it" % (font["name"], missing))
+    print("\n[fonts] Flash saved by replacing built-in sizes: %d bytes" % saved_total)
+    for line in stale:
+        print("[fonts] Stale: " + line)
+    print("[fonts] Glyph render time: flash and run 'fontbench' on the serial console")
+
+
+def write_header(manifest):
+    lines = [
+        "#pragma once",
+        "",
+        "// Generated by tools/fonts/build_fonts.py from tools/fonts/fonts.json, do not edit.",
+        "// Included by lv_conf.h, so macros only.",
+        "",
+    ]
+    # Say in the header what the tree actually has, so a 1 below is not read
+    # as "this size was subset and saves flash"
+    status = []
+    for font in manifest["fonts"]:
+        path = font_path(manifest, font)
+        if not os.path.exists(path):
+            state = "not generated, built-in montserrat_%s used" % font.get("replaces", "?")
+        else:
+            missing = missing_symbols(path, font)
+            state = "stale, lacks %r" % missing if missing else "up to date"
+        status.append("//   %-24s %s" % (font["name"], state))
+    if not any(f.get("replaces") and os.path.exists(font_path(manifest, f)) for f in manifest["fonts"]):
+        lines.append("// No subset replaces a built-in size yet, so the pipeline saves no flash:")
+    else:
+        lines.append("// Font files:")
+    lines += status
+    lines.append("")
+    declares = []
+    compressed = False
+    for font in manifest["fonts"]:
+        present = os.path.exists(font_path(manifest, font))
+        flag = "FONT_SUBSET_" + font["macro"][len("FONT_"):]
+        lines.append("#define %-28s %d   // %s" % (flag, 1 if present else 0, font["used_by"]))
+        if present:
+            declares.append("LV_FONT_DECLARE(%s)" % font["name"])
+            compressed |= bool(font.get("compress"))
+    lines.append("")
+    lines.append("#define FONT_SUBSETS_COMPRESSED      %d" % (1 if compressed else 0))
+    lines.append("#define FONT_SUBSETS_DECLARE         " + " ".join(declares))
+    lines.append("")
+    lines.append("// Fonts for the UI: the subset when generated, the built-in size otherwise")
+    for font in manifest["fonts"]:
+        present = os.path.exists(font_path(manifest, font))
+        if present:
+            target = font["name"]
+        elif font.get("replaces"):
+            target = "lv_font_montserrat_%d" % font["replaces"]
+        else:
+            sys.exit("[fonts] %s has no built-in fallback and was not generated" % font["name"])
+        lines.append("#define %-28s (&%s)" % (font["macro"], target))
+    with open(os.path.join(ROOT, manifest["header"]), "w") as f:
+        f.write("\n".join(lines) + "\n")
+    print("[fonts] Wrote " + manifest["header"])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--only", action="append", help="generate only this font (repeatable)")
+    parser.add_argument("--report", action="store_true", help="do not generate, only report")
+    parser.add_argument("--lvgl", help="LVGL source tree for the built-in comparison")
+    args = parser.parse_args()
+
+    manifest = load_manifest()
+    if not args.report:
+        for font in manifest["fonts"]:
+            if args.only and font["name"] not in args.only:
+                continue
+            generate(manifest, font)
+        write_header(manifest)
+    report(manifest, args.lvgl)
+
+
+if __name__ == "__main__":
+    main()